@@ -0,0 +1,400 @@
+/**
+ * @file chrono2d_bench.cpp
+ * @brief Headless benchmark suite of the game's physics, built on Box2D's shared benchmarks.
+ *
+ * Every scenario is run once per worker count of the sweep, on a fresh world driven by
+ * the game's TaskSystem. No window is opened and textures are not loaded: only the
+ * simulation is measured. Scenarios:
+ *  - map0 ... map4: each level as loaded by the game (map4 streamed along its length);
+ *  - map1_rain_xN: map1 with N pairs of boxes dropped every second;
+ *  - rope_bridge_N: N hanging platforms (createHangingPlatformWithRopes) under falling boxes;
+ *  - freeze_cycles: map1 rain entering and leaving the time freeze every second;
+ *  - rewind_5k: 5000 boxes falling on a floor, the load TimeRewind's budget is sized for;
+ *  - time_zones_5k: the same boxes falling through overlapping freeze, slow and fast zones;
+ *  - box2d_*: Box2D's own benchmark scenes, as a reference point for the machine.
+ *
+ * For each run the report gives the steps per second, the p50 / p99 frame time and the
+ * Box2D memory (peak and at the end of the run), as JSON. Every step is also recorded
+ * by a TimeRewind, timed apart from the frame: the report adds its mean cost, as a
+ * percentage of the mean frame, and the encoded bytes per step.
+ *
+ * Usage: chrono2d_bench [--frames N] [--workers 1,2,4,8] [--filter substring] [--out file.json]
+ */
+#include <box2d/box2d.h>
+#include "benchmarks.h"
+#include "constants.hpp"
+#include "level_arena.hpp"
+#include "level_streamer.hpp"
+#include "memory_tracker.hpp"
+#include "task_system.hpp"
+#include "texture_cache.hpp"
+#include "time_rewind.hpp"
+#include "time_dilation.hpp"
+#include "world_freezer.hpp"
+#include "../maps/map0.hpp"
+#include "../maps/map1.hpp"
+#include "../maps/map2.hpp"
+#include "../maps/map3.hpp"
+#include "../maps/map4.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int GAME_SUB_STEPS = 8;  // Same as the game loop
+const int BOX2D_SUB_STEPS = 4; // Same as Box2D's benchmark app
+const int FRAMES_PER_SECOND = 60;
+const float STREAMING_FOCUS_SPEED_M_S = 10.0f; // Roughly the player's running speed
+
+/**
+ * @brief Everything a scenario may touch. Rebuilt from scratch for every run.
+ */
+struct BenchWorld {
+    b2WorldId worldId {b2_nullWorldId};
+    LevelArena arena;
+    GameObjectList gameObjects {ArenaAllocator<GameObject>(&arena)};
+    b2BodyId playerBodyId {b2_nullBodyId};
+    LevelStreamer streamer;
+    WorldFreezer freezer;
+    TimeRewind rewind;
+    TimeDilationZones timeZones;
+    int subSteps {GAME_SUB_STEPS};
+    float startX_m {0.0f}; // Where a streamed level starts its run
+};
+
+struct Scenario {
+    std::string name;
+    std::function<void(BenchWorld&)> setup;
+    std::function<void(BenchWorld&, int frame)> beforeStep; // Optional per-frame gameplay work
+};
+
+struct RunResult {
+    std::string scenario;
+    int workers;
+    int frames;
+    int bodyCount;
+    double stepsPerSecond;
+    double p50Ms;
+    double p99Ms;
+    double meanMs;
+    int64_t box2dPeakBytes;
+    int64_t box2dEndBytes;
+    double rewindRecordMs;
+    double rewindRecordPercent;
+    double rewindBytesPerStep;
+};
+
+struct Options {
+    int frames {600};
+    std::vector<int> workers {1, 2, 4, 8};
+    std::string filter;
+    std::string outPath;
+};
+
+// --- Scenarios ---
+
+void dropBox(BenchWorld& bench, float x_m, float y_m) {
+    GameObject boxObj;
+    boxObj.setPosition(x_m, y_m);
+    boxObj.setSize(pixelsToMeters(60), pixelsToMeters(60));
+    boxObj.setDynamic(true);
+    boxObj.setDensity(0.5f);
+    boxObj.setFriction(0.7f);
+    boxObj.setCanJumpOnProperty(true);
+    boxObj.setCollidesWithPlayerProperty(true);
+    if (boxObj.finalize(bench.worldId)) {
+        bench.gameObjects.push_back(boxObj);
+    }
+}
+
+/**
+ * @brief A long static floor and `platformCount` hanging platforms in a row above it.
+ */
+void createRopeBridge(BenchWorld& bench, int platformCount) {
+    float whereAmI = 0.0f;
+    for (int i = 0; i < platformCount; ++i) {
+        whereAmI = createHangingPlatformWithRopes(bench.worldId, bench.gameObjects, whereAmI, 150.0f, 300.0f, 20.0f, 300.0f);
+    }
+
+    GameObject floorObj;
+    floorObj.setPosition(pixelsToMeters(whereAmI / 2.0f), pixelsToMeters(-400.0f));
+    floorObj.setSize(pixelsToMeters(whereAmI + 400.0f), pixelsToMeters(100.0f));
+    floorObj.setDynamic(false);
+    if (floorObj.finalize(bench.worldId)) {
+        bench.gameObjects.push_back(floorObj);
+    }
+}
+
+/**
+ * @brief Drops one box above each platform of the bridge every two seconds.
+ */
+void rainOnRopeBridge(BenchWorld& bench, int frame, int platformCount) {
+    if (frame % (2 * FRAMES_PER_SECOND) != 0) return;
+    for (int i = 0; i < platformCount; ++i) {
+        float platformCenterPx = 150.0f + i * 450.0f + 150.0f; // gap + i * (gap + width) + width / 2
+        dropBox(bench, pixelsToMeters(platformCenterPx), pixelsToMeters(500.0f));
+    }
+}
+
+void spawnRain(BenchWorld& bench, int frame, int pairsPerSecond) {
+    if (frame % FRAMES_PER_SECOND != 0) return;
+    for (int i = 0; i < pairsPerSecond; ++i) {
+        spawnMap1Boxes(bench.worldId, bench.gameObjects);
+    }
+}
+
+/**
+ * @brief A floor and `boxCount` boxes in a grid above it, at various angles.
+ */
+void createBoxField(BenchWorld& bench, int boxCount) {
+    const int columns = 100;
+    GameObject floorObj;
+    floorObj.setPosition(columns, -1.0f);
+    floorObj.setSize(2.0f * columns + 20.0f, 2.0f);
+    floorObj.setDynamic(false);
+    if (floorObj.finalize(bench.worldId)) {
+        bench.gameObjects.push_back(floorObj);
+    }
+    for (int i = 0; i < boxCount; ++i) {
+        GameObject boxObj;
+        boxObj.setPosition((i % columns) * 2.0f + 1.0f, 2.0f + (i / columns) * 1.2f);
+        boxObj.setSize(0.8f, 0.8f);
+        boxObj.setRotation(static_cast<float>((i * 37) % 90));
+        boxObj.setDynamic(true);
+        if (boxObj.finalize(bench.worldId)) {
+            bench.gameObjects.push_back(boxObj);
+        }
+    }
+}
+
+/**
+ * @brief Box2D's reference scenes are stepped like Box2D's own benchmark app.
+ */
+void useBox2DSubSteps(BenchWorld& bench) {
+    bench.subSteps = BOX2D_SUB_STEPS;
+}
+
+std::vector<Scenario> buildScenarios() {
+    std::vector<Scenario> scenarios;
+
+    scenarios.push_back({"map0", [](BenchWorld& b) { loadMap0(b.worldId, b.gameObjects, b.playerBodyId); }, nullptr});
+    scenarios.push_back({"map1", [](BenchWorld& b) { loadMap1(b.worldId, b.gameObjects, b.playerBodyId, b.timeZones); }, nullptr});
+    scenarios.push_back({"map2", [](BenchWorld& b) { loadMap2(b.worldId, b.gameObjects, b.playerBodyId); }, nullptr});
+    scenarios.push_back({"map3", [](BenchWorld& b) { loadMap3(b.worldId, b.gameObjects, b.playerBodyId); }, nullptr});
+    scenarios.push_back({"map4",
+        [](BenchWorld& b) {
+            loadMap4(b.worldId, b.gameObjects, b.playerBodyId, b.streamer);
+            b.startX_m = b2Body_GetPosition(b.playerBodyId).x;
+            b.streamer.prime(b.worldId, b.gameObjects, b.startX_m);
+        },
+        [](BenchWorld& b, int frame) {
+            // The focus runs along the level, so chunks are streamed in and out as in a playthrough
+            float focusX = b.startX_m + STREAMING_FOCUS_SPEED_M_S * frame / FRAMES_PER_SECOND;
+            b.streamer.update(b.worldId, b.gameObjects, focusX);
+        }});
+
+    for (int pairs : {1, 4, 16}) {
+        scenarios.push_back({"map1_rain_x" + std::to_string(pairs),
+            [](BenchWorld& b) { loadMap1(b.worldId, b.gameObjects, b.playerBodyId, b.timeZones); },
+            [pairs](BenchWorld& b, int frame) { spawnRain(b, frame, pairs); }});
+    }
+
+    for (int platforms : {16, 64}) {
+        scenarios.push_back({"rope_bridge_" + std::to_string(platforms),
+            [platforms](BenchWorld& b) { createRopeBridge(b, platforms); },
+            [platforms](BenchWorld& b, int frame) { rainOnRopeBridge(b, frame, platforms); }});
+    }
+
+    scenarios.push_back({"freeze_cycles",
+        [](BenchWorld& b) { loadMap1(b.worldId, b.gameObjects, b.playerBodyId, b.timeZones); },
+        [](BenchWorld& b, int frame) {
+            // One second of normal time, then one second frozen, as the game does it
+            int phase = frame % (2 * FRAMES_PER_SECOND);
+            if (phase == 0) {
+                b.freezer.restore();
+                spawnRain(b, frame, 4);
+            } else if (phase == FRAMES_PER_SECOND) {
+                b.freezer.freeze(b.gameObjects, b.playerBodyId);
+            }
+        }});
+
+    scenarios.push_back({"rewind_5k", [](BenchWorld& b) { createBoxField(b, 5000); }, nullptr});
+    scenarios.push_back({"time_zones_5k",
+        [](BenchWorld& b) {
+            createBoxField(b, 5000);
+            b.timeZones.add({{0.0f, 10.0f}, {60.0f, 30.0f}}, 0.0f);
+            b.timeZones.add({{50.0f, 10.0f}, {130.0f, 30.0f}}, 0.5f);
+            b.timeZones.add({{120.0f, 10.0f}, {200.0f, 30.0f}}, 2.0f);
+        },
+        nullptr});
+
+    scenarios.push_back({"box2d_large_pyramid", [](BenchWorld& b) { useBox2DSubSteps(b); CreateLargePyramid(b.worldId); }, nullptr});
+    scenarios.push_back({"box2d_many_pyramids", [](BenchWorld& b) { useBox2DSubSteps(b); CreateManyPyramids(b.worldId); }, nullptr});
+    scenarios.push_back({"box2d_joint_grid", [](BenchWorld& b) { useBox2DSubSteps(b); CreateJointGrid(b.worldId); }, nullptr});
+    scenarios.push_back({"box2d_rain",
+        [](BenchWorld& b) { useBox2DSubSteps(b); CreateRain(b.worldId); },
+        [](BenchWorld& b, int frame) { StepRain(b.worldId, frame); }});
+    scenarios.push_back({"box2d_spinner",
+        [](BenchWorld& b) { useBox2DSubSteps(b); CreateSpinner(b.worldId); },
+        [](BenchWorld& b, int frame) { StepSpinner(b.worldId, frame); }});
+    scenarios.push_back({"box2d_smash", [](BenchWorld& b) { useBox2DSubSteps(b); CreateSmash(b.worldId); }, nullptr});
+    scenarios.push_back({"box2d_tumbler", [](BenchWorld& b) { useBox2DSubSteps(b); CreateTumbler(b.worldId); }, nullptr});
+
+    return scenarios;
+}
+
+// --- Runner ---
+
+double percentile(const std::vector<double>& sortedMs, double fraction) {
+    if (sortedMs.empty()) return 0.0;
+    size_t index = static_cast<size_t>(fraction * static_cast<double>(sortedMs.size() - 1) + 0.5);
+    return sortedMs[std::min(index, sortedMs.size() - 1)];
+}
+
+RunResult runScenario(const Scenario& scenario, int workers, int frames) {
+    srand(42); // map1's box rain uses rand(): keep every run identical
+
+    TaskSystem tasks(workers);
+    b2WorldDef worldDef = b2DefaultWorldDef();
+    worldDef.gravity = {0.0f, -10.0f};
+    tasks.configure(worldDef);
+
+    BenchWorld bench;
+    bench.worldId = b2CreateWorld(&worldDef);
+    scenario.setup(bench);
+    MemoryTracker::instance().resetPeak(MemorySubsystem::Box2D);
+
+    std::vector<double> frameMs;
+    frameMs.reserve(frames);
+    double recordMs = 0.0;
+    for (int frame = 0; frame < frames; ++frame) {
+        auto start = std::chrono::steady_clock::now();
+        if (scenario.beforeStep) {
+            scenario.beforeStep(bench, frame);
+        }
+        if (bench.freezer.frozenCount() == 0) {
+            bench.timeZones.update(bench.worldId, bench.playerBodyId, nullptr); // No LOD in this suite
+        }
+        b2World_Step(bench.worldId, UPDATE_DELTA, bench.subSteps);
+        auto end = std::chrono::steady_clock::now();
+        frameMs.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+
+        bench.rewind.record(bench.worldId);
+        recordMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - end).count();
+    }
+    double totalSeconds = 0.0;
+    for (double ms : frameMs) {
+        totalSeconds += ms / 1000.0;
+    }
+
+    RunResult result;
+    result.scenario = scenario.name;
+    result.workers = tasks.workerCount();
+    result.frames = frames;
+    result.bodyCount = b2World_GetAwakeBodyCount(bench.worldId);
+    result.stepsPerSecond = totalSeconds > 0.0 ? frames / totalSeconds : 0.0;
+    result.meanMs = frames > 0 ? totalSeconds * 1000.0 / frames : 0.0;
+    std::sort(frameMs.begin(), frameMs.end());
+    result.p50Ms = percentile(frameMs, 0.50);
+    result.p99Ms = percentile(frameMs, 0.99);
+    MemoryTracker::Stats memory = MemoryTracker::instance().stats(MemorySubsystem::Box2D);
+    result.box2dPeakBytes = memory.peakBytes;
+    result.box2dEndBytes = memory.bytes;
+    result.rewindRecordMs = frames > 0 ? recordMs / frames : 0.0;
+    result.rewindRecordPercent = result.meanMs > 0.0 ? 100.0 * result.rewindRecordMs / result.meanMs : 0.0;
+    result.rewindBytesPerStep = bench.rewind.canRewind() ? static_cast<double>(bench.rewind.historyBytes()) / bench.rewind.stepCount() : 0.0;
+
+    bench.freezer.clear();
+    bench.streamer.clear();
+    bench.timeZones.clear();
+    b2DestroyWorld(bench.worldId); // Before the TaskSystem goes away
+    return result;
+}
+
+void writeJson(std::ostream& out, const std::vector<RunResult>& results) {
+    out << std::fixed << std::setprecision(3);
+    out << "{\n  \"benchmark\": \"chrono2d_bench\",\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const RunResult& r = results[i];
+        out << "    {\"scenario\": \"" << r.scenario << "\", \"workers\": " << r.workers
+            << ", \"frames\": " << r.frames << ", \"awake_bodies\": " << r.bodyCount
+            << ", \"steps_per_second\": " << r.stepsPerSecond
+            << ", \"mean_ms\": " << r.meanMs << ", \"p50_ms\": " << r.p50Ms << ", \"p99_ms\": " << r.p99Ms
+            << ", \"box2d_peak_bytes\": " << r.box2dPeakBytes << ", \"box2d_end_bytes\": " << r.box2dEndBytes
+            << ", \"rewind_record_ms\": " << r.rewindRecordMs << ", \"rewind_record_percent\": " << r.rewindRecordPercent
+            << ", \"rewind_bytes_per_step\": " << r.rewindBytesPerStep << "}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--frames" && hasValue) {
+            options.frames = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--workers" && hasValue) {
+            options.workers.clear();
+            std::stringstream list(argv[++i]);
+            std::string item;
+            while (std::getline(list, item, ',')) {
+                if (std::atoi(item.c_str()) > 0) options.workers.push_back(std::atoi(item.c_str()));
+            }
+        } else if (arg == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (arg == "--out" && hasValue) {
+            options.outPath = argv[++i];
+        } else {
+            std::cerr << "Usage: chrono2d_bench [--frames N] [--workers 1,2,4,8] [--filter substring] [--out file.json]" << std::endl;
+            return false;
+        }
+    }
+    return !options.workers.empty();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    MemoryTracker::installBox2DAllocator();
+    TextureCache::instance().setLoadingEnabled(false); // Headless: no GPU textures
+
+    std::vector<RunResult> results;
+    for (const Scenario& scenario : buildScenarios()) {
+        if (!options.filter.empty() && scenario.name.find(options.filter) == std::string::npos) continue;
+        for (int workers : options.workers) {
+            RunResult result = runScenario(scenario, workers, options.frames);
+            std::cerr << std::left << std::setw(22) << result.scenario << " workers " << result.workers
+                      << std::fixed << std::setprecision(3)
+                      << "  p50 " << result.p50Ms << " ms  p99 " << result.p99Ms << " ms"
+                      << "  rewind " << result.rewindRecordPercent << " %" << std::endl;
+            results.push_back(result);
+        }
+    }
+
+    if (options.outPath.empty()) {
+        writeJson(std::cout, results);
+    } else {
+        std::ofstream out(options.outPath);
+        if (!out) {
+            std::cerr << "Failed to open output file: " << options.outPath << std::endl;
+            return 1;
+        }
+        writeJson(out, results);
+        std::cerr << "Results written to " << options.outPath << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file debug_draw_bench.cpp
+ * @brief Measures the batched physics debug draw on large worlds.
+ *
+ * A world is filled with a grid of boxes, circles and capsules, every tenth body
+ * hinged to its neighbour, and stepped so contacts exist. Every frame,
+ * PhysicsDebugDraw::capture() then fills a PhysicsDebugBatch with all categories on:
+ *  - full: a view covering the whole world, so every shape is emitted;
+ *  - culled: a window-sized view in the middle of the world.
+ * The report gives the capture time per frame and the vertices of each batch
+ * (the batch is three draw calls whatever its size).
+ *
+ * Usage: debug_draw_bench [objectCount...] (default: 10000 50000)
+ */
+#include <SFML/Graphics.hpp>
+#include <box2d/box2d.h>
+#include "physics_debug_draw.hpp"
+#include "utils.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+const int FRAMES = 100;
+const int SETTLE_STEPS = 10;
+const float SPACING_M = 1.5f;
+
+struct Scene {
+    b2WorldId worldId;
+    int columns;
+    int rows;
+};
+
+Scene createScene(int objectCount) {
+    Scene scene;
+    b2WorldDef worldDef = b2DefaultWorldDef();
+    worldDef.gravity = {0.0f, -10.0f};
+    scene.worldId = b2CreateWorld(&worldDef);
+    scene.columns = static_cast<int>(std::sqrt(static_cast<float>(objectCount))) + 1;
+    scene.rows = objectCount / scene.columns + 1;
+
+    b2BodyDef groundDef = b2DefaultBodyDef();
+    b2BodyId ground = b2CreateBody(scene.worldId, &groundDef);
+    b2ShapeDef groundShapeDef = b2DefaultShapeDef();
+    b2Segment floor = {{-10.0f, 0.0f}, {scene.columns * SPACING_M + 10.0f, 0.0f}};
+    b2CreateSegmentShape(ground, &groundShapeDef, &floor);
+
+    b2BodyId previous = b2_nullBodyId;
+    for (int i = 0; i < objectCount; ++i) {
+        b2BodyDef bodyDef = b2DefaultBodyDef();
+        bodyDef.type = b2_dynamicBody;
+        bodyDef.position = {(i % scene.columns) * SPACING_M, 1.0f + (i / scene.columns) * SPACING_M};
+        b2BodyId bodyId = b2CreateBody(scene.worldId, &bodyDef);
+        b2ShapeDef shapeDef = b2DefaultShapeDef();
+        switch (i % 3) {
+            case 0: {
+                b2Polygon box = b2MakeBox(0.4f, 0.4f);
+                b2CreatePolygonShape(bodyId, &shapeDef, &box);
+                break;
+            }
+            case 1: {
+                b2Circle circle = {{0.0f, 0.0f}, 0.4f};
+                b2CreateCircleShape(bodyId, &shapeDef, &circle);
+                break;
+            }
+            default: {
+                b2Capsule capsule = {{-0.3f, 0.0f}, {0.3f, 0.0f}, 0.25f};
+                b2CreateCapsuleShape(bodyId, &shapeDef, &capsule);
+                break;
+            }
+        }
+        if (i % 10 == 0 && B2_IS_NON_NULL(previous)) {
+            b2RevoluteJointDef jointDef = b2DefaultRevoluteJointDef();
+            jointDef.bodyIdA = previous;
+            jointDef.bodyIdB = bodyId;
+            jointDef.localAnchorA = {0.75f, 0.0f};
+            jointDef.localAnchorB = {-0.75f, 0.0f};
+            b2CreateRevoluteJoint(scene.worldId, &jointDef);
+        }
+        previous = bodyId;
+    }
+    for (int i = 0; i < SETTLE_STEPS; ++i) {
+        b2World_Step(scene.worldId, 1.0f / 60.0f, 4);
+    }
+    return scene;
+}
+
+void run(const char* label, Scene& scene, PhysicsDebugDraw& debugDraw, const sf::View& view) {
+    PhysicsDebugBatch batch;
+    debugDraw.capture(scene.worldId, view, batch); // Grows the batches once
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        debugDraw.capture(scene.worldId, view, batch);
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / FRAMES;
+    std::printf("  %-7s %8.3f ms/frame  fills %8zu  lines %8zu  points %6zu vertices\n", label, ms,
+                batch.fills.getVertexCount(), batch.lines.getVertexCount(), batch.points.getVertexCount());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<int> counts;
+    for (int i = 1; i < argc; ++i) {
+        counts.push_back(std::atoi(argv[i]));
+    }
+    if (counts.empty()) {
+        counts = {10000, 50000};
+    }
+
+    PhysicsDebugDraw debugDraw;
+    for (int category = 0; category < static_cast<int>(DebugDrawCategory::Count); ++category) {
+        debugDraw.setEnabled(static_cast<DebugDrawCategory>(category), true);
+    }
+
+    for (int objectCount : counts) {
+        Scene scene = createScene(objectCount);
+        std::printf("%d objects\n", objectCount);
+
+        // World pixels, as the game's camera
+        sf::Vector2f worldMin = b2VecToSfVec({-2.0f, scene.rows * SPACING_M + 2.0f});
+        sf::Vector2f worldMax = b2VecToSfVec({scene.columns * SPACING_M + 2.0f, -2.0f});
+        sf::View fullView(sf::FloatRect(worldMin, worldMax - worldMin));
+        sf::View windowView(fullView.getCenter(), {static_cast<float>(WINDOW_WIDTH), static_cast<float>(WINDOW_HEIGHT)});
+        run("full", scene, debugDraw, fullView);
+        run("culled", scene, debugDraw, windowView);
+
+        b2DestroyWorld(scene.worldId);
+    }
+    return 0;
+}
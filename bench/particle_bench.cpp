@@ -0,0 +1,73 @@
+/**
+ * @file particle_bench.cpp
+ * @brief Measures the particle system with a large live population.
+ *
+ * Impact bursts are emitted every frame to hold a target number of live particles
+ * (the pools are sized for it, the game itself caps them much lower). Every frame
+ * then runs update() and writeBatches(), as the game loop does. The report gives
+ * the time per frame of each, their sum against the PARTICLE_CPU_BUDGET_MS budget,
+ * and the live and emitted counts.
+ *
+ * Usage: particle_bench [liveCount...] (default: 10000 50000)
+ */
+#include <SFML/Graphics.hpp>
+#include "particle_system.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+const int FRAMES = 600;
+const int WARMUP_FRAMES = 120;
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::size_t> counts;
+    for (int i = 1; i < argc; ++i) {
+        counts.push_back(static_cast<std::size_t>(std::atoi(argv[i])));
+    }
+    if (counts.empty()) {
+        counts = {10000, 50000};
+    }
+
+    for (std::size_t target : counts) {
+        ParticleSystem particles(target);
+        std::vector<ParticleBatch> batches;
+        double updateMs = 0.0;
+        double writeMs = 0.0;
+        std::size_t liveSum = 0;
+        for (int frame = 0; frame < WARMUP_FRAMES + FRAMES; ++frame) {
+            // Bursts spread over a 40 m wide area, until the target is reached
+            int burst = 0;
+            while (particles.liveCount() < target && burst < 100000) {
+                b2Vec2 position = {static_cast<float>(burst % 40), 5.0f + static_cast<float>(burst % 7)};
+                particles.emit(ParticleEffect::Impact, position, {0.0f, 1.0f}, 2.0f);
+                ++burst;
+            }
+            auto start = std::chrono::steady_clock::now();
+            particles.update(UPDATE_DELTA, false);
+            double update = elapsedMs(start);
+            start = std::chrono::steady_clock::now();
+            particles.writeBatches(batches);
+            double write = elapsedMs(start);
+            if (frame >= WARMUP_FRAMES) {
+                updateMs += update;
+                writeMs += write;
+                liveSum += particles.liveCount();
+            }
+        }
+        updateMs /= FRAMES;
+        writeMs /= FRAMES;
+        std::printf("%zu particles (average live %zu)\n", target, liveSum / FRAMES);
+        std::printf("  update %7.3f ms  write %7.3f ms  total %7.3f ms (budget %.1f ms)\n", updateMs, writeMs,
+                    updateMs + writeMs, PARTICLE_CPU_BUDGET_MS);
+    }
+    return 0;
+}
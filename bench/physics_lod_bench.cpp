@@ -0,0 +1,231 @@
+/**
+ * @file physics_lod_bench.cpp
+ * @brief Measures the step time saved by PhysicsLod on a large generated level.
+ *
+ * The level is a long static ground holding alternating swinging chains and box piles.
+ * A camera travels along it and the same simulation is run twice, with and without the
+ * LOD. The report gives the average step time of both runs and the position error of the
+ * LOD run against the full-rate run, measured only on bodies inside the camera view
+ * (the only error a player could see).
+ *
+ * A second check puts two falling bodies out of the full-rate radius, so the LOD has
+ * them asleep, then covers one with a frozen time zone and the other with a slowed one.
+ * The frozen body must not move and the slowed one must fall as it does without the LOD.
+ *
+ * Usage: physics_lod_bench [regionCount]
+ */
+#include <box2d/box2d.h>
+#include "physics_lod.hpp"
+#include "time_dilation.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+const float REGION_SPACING_M = 25.0f;
+const float CAMERA_SPEED_M_S = 15.0f;
+const float VIEW_HALF_WIDTH_M = 20.0f; // WINDOW_WIDTH / PIXELS_PER_METER / 2
+const int SUB_STEPS = 8;
+const int ZONE_WARMUP_FRAMES = 10;
+const int ZONE_FRAMES = 60;
+const float SLOW_ZONE_SCALE = 0.3f;
+
+struct Level {
+    b2WorldId worldId;
+    std::vector<b2BodyId> bodies; // Dynamic bodies, in creation order
+    float length_m;
+};
+
+b2BodyId createBox(b2WorldId worldId, b2Vec2 position, float halfWidth, float halfHeight, bool dynamic) {
+    b2BodyDef bodyDef = b2DefaultBodyDef();
+    bodyDef.type = dynamic ? b2_dynamicBody : b2_staticBody;
+    bodyDef.position = position;
+    b2BodyId bodyId = b2CreateBody(worldId, &bodyDef);
+    b2ShapeDef shapeDef = b2DefaultShapeDef();
+    shapeDef.density = 1.0f;
+    shapeDef.material.friction = 0.7f;
+    b2Polygon box = b2MakeBox(halfWidth, halfHeight);
+    b2CreatePolygonShape(bodyId, &shapeDef, &box);
+    return bodyId;
+}
+
+void addChain(Level& level, float x) {
+    const int linkCount = 6;
+    const float linkHalfLength = 0.5f;
+    b2BodyId previous = createBox(level.worldId, {x, 12.0f}, 0.1f, 0.1f, false);
+    for (int i = 0; i < linkCount; ++i) {
+        // Links start horizontal so the chain swings for the whole run
+        b2Vec2 center = {x + linkHalfLength * (2.0f * i + 1.0f), 12.0f};
+        b2BodyId link = createBox(level.worldId, center, linkHalfLength, 0.1f, true);
+        b2RevoluteJointDef jointDef = b2DefaultRevoluteJointDef();
+        jointDef.bodyIdA = previous;
+        jointDef.bodyIdB = link;
+        jointDef.localAnchorA = i == 0 ? b2Vec2{0.0f, 0.0f} : b2Vec2{linkHalfLength, 0.0f};
+        jointDef.localAnchorB = {-linkHalfLength, 0.0f};
+        b2CreateRevoluteJoint(level.worldId, &jointDef);
+        level.bodies.push_back(link);
+        previous = link;
+    }
+}
+
+void addPile(Level& level, float x) {
+    const int rows = 4;
+    const float halfSize = 0.5f;
+    for (int row = 0; row < rows; ++row) {
+        for (int column = 0; column < rows - row; ++column) {
+            b2Vec2 position = {x + (column + 0.5f * row) * 2.1f * halfSize, halfSize + row * 2.0f * halfSize};
+            level.bodies.push_back(createBox(level.worldId, position, halfSize, halfSize, true));
+        }
+    }
+}
+
+Level createLevel(int regionCount) {
+    Level level;
+    b2WorldDef worldDef = b2DefaultWorldDef();
+    worldDef.gravity = {0.0f, -10.0f};
+    level.worldId = b2CreateWorld(&worldDef);
+    level.length_m = regionCount * REGION_SPACING_M;
+    createBox(level.worldId, {level.length_m / 2.0f, -1.0f}, level.length_m / 2.0f + 50.0f, 1.0f, false);
+    for (int i = 0; i < regionCount; ++i) {
+        float x = (i + 0.5f) * REGION_SPACING_M;
+        if (i % 2 == 0) {
+            addChain(level, x);
+        } else {
+            addPile(level, x);
+        }
+    }
+    return level;
+}
+
+struct RunResult {
+    double totalStepMs {0.0};
+    double awakeBodySum {0.0};
+    int frames {0};
+    std::vector<b2Vec2> positions; // frames x bodies
+};
+
+RunResult run(int regionCount, bool useLod) {
+    Level level = createLevel(regionCount);
+    PhysicsLod lod;
+    RunResult result;
+    const float dt = 1.0f / 60.0f;
+    result.frames = static_cast<int>(level.length_m / CAMERA_SPEED_M_S / dt);
+    result.positions.reserve(static_cast<std::size_t>(result.frames) * level.bodies.size());
+
+    for (int frame = 0; frame < result.frames; ++frame) {
+        b2Vec2 camera = {frame * dt * CAMERA_SPEED_M_S, 5.0f};
+        auto start = std::chrono::steady_clock::now();
+        if (useLod) lod.beforeStep(level.bodies, camera);
+        b2World_Step(level.worldId, dt, SUB_STEPS);
+        if (useLod) lod.afterStep();
+        std::chrono::duration<double, std::milli> spent = std::chrono::steady_clock::now() - start;
+        result.totalStepMs += spent.count();
+        result.awakeBodySum += b2World_GetAwakeBodyCount(level.worldId);
+
+        for (b2BodyId bodyId : level.bodies) {
+            result.positions.push_back(b2Body_GetPosition(bodyId));
+        }
+    }
+    b2DestroyWorld(level.worldId);
+    return result;
+}
+
+struct ZoneResult {
+    float frozenDrift_m;
+    b2Vec2 slowVelocity;
+};
+
+ZoneResult runTimeZones(bool useLod) {
+    b2WorldDef worldDef = b2DefaultWorldDef();
+    worldDef.gravity = {0.0f, -10.0f};
+    b2WorldId worldId = b2CreateWorld(&worldDef);
+    // Reduced tier: beyond PHYSICS_LOD_FULL_RADIUS_M of the focus, in free fall
+    std::vector<b2BodyId> bodies = {createBox(worldId, {60.0f, 100.0f}, 0.5f, 0.5f, true),
+                                    createBox(worldId, {70.0f, 100.0f}, 0.5f, 0.5f, true)};
+    for (b2BodyId bodyId : bodies) {
+        b2Body_SetLinearVelocity(bodyId, {1.0f, -2.0f});
+    }
+    const b2Vec2 focus = {0.0f, 100.0f};
+    const float dt = 1.0f / 60.0f;
+    PhysicsLod lod;
+    TimeDilationZones zones;
+
+    auto frame = [&]() {
+        zones.update(worldId, b2_nullBodyId, useLod ? &lod : nullptr);
+        if (useLod) lod.beforeStep(bodies, focus);
+        b2World_Step(worldId, dt, SUB_STEPS);
+        if (useLod) lod.afterStep();
+    };
+    for (int i = 0; i < ZONE_WARMUP_FRAMES; ++i) {
+        frame();
+    }
+
+    zones.add({{55.0f, 50.0f}, {65.0f, 150.0f}}, 0.0f);
+    zones.add({{65.0f, 50.0f}, {75.0f, 150.0f}}, SLOW_ZONE_SCALE);
+    b2Vec2 frozenStart = b2Body_GetPosition(bodies[0]);
+    for (int i = 0; i < ZONE_FRAMES; ++i) {
+        frame();
+    }
+
+    ZoneResult result;
+    result.frozenDrift_m = b2Distance(frozenStart, b2Body_GetPosition(bodies[0]));
+    result.slowVelocity = b2Body_GetLinearVelocity(bodies[1]);
+    b2DestroyWorld(worldId);
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int regionCount = argc > 1 ? std::atoi(argv[1]) : 80;
+    if (regionCount <= 0) {
+        std::fprintf(stderr, "Usage: %s [regionCount]\n", argv[0]);
+        return 1;
+    }
+
+    RunResult reference = run(regionCount, false);
+    RunResult lod = run(regionCount, true);
+
+    // Error of the LOD run, restricted to bodies the camera can see
+    std::size_t bodyCount = reference.positions.size() / static_cast<std::size_t>(reference.frames);
+    const float dt = 1.0f / 60.0f;
+    double errorSum = 0.0;
+    double errorMax = 0.0;
+    long samples = 0;
+    for (int frame = 0; frame < reference.frames; ++frame) {
+        float cameraX = frame * dt * CAMERA_SPEED_M_S;
+        for (std::size_t b = 0; b < bodyCount; ++b) {
+            std::size_t index = static_cast<std::size_t>(frame) * bodyCount + b;
+            b2Vec2 expected = reference.positions[index];
+            if (std::fabs(expected.x - cameraX) > VIEW_HALF_WIDTH_M) continue;
+            double error = b2Distance(expected, lod.positions[index]);
+            errorSum += error;
+            errorMax = error > errorMax ? error : errorMax;
+            ++samples;
+        }
+    }
+
+    std::printf("regions            %d\n", regionCount);
+    std::printf("dynamic bodies     %zu\n", bodyCount);
+    std::printf("frames             %d\n", reference.frames);
+    std::printf("full rate          %.4f ms/step, %.1f awake bodies\n",
+                reference.totalStepMs / reference.frames, reference.awakeBodySum / reference.frames);
+    std::printf("physics LOD        %.4f ms/step, %.1f awake bodies\n",
+                lod.totalStepMs / lod.frames, lod.awakeBodySum / lod.frames);
+    std::printf("speedup            %.2fx\n", reference.totalStepMs / lod.totalStepMs);
+    std::printf("visible error      mean %.3f m, max %.3f m\n",
+                samples > 0 ? errorSum / samples : 0.0, errorMax);
+
+    ZoneResult zonesReference = runTimeZones(false);
+    ZoneResult zonesLod = runTimeZones(true);
+    float slowError = b2Distance(zonesReference.slowVelocity, zonesLod.slowVelocity);
+    // The LOD may lag a catch-up step behind when the body enters: that much gravity, slowed down
+    float slowTolerance = SLOW_ZONE_SCALE * 10.0f * PHYSICS_LOD_REDUCED_RATE * dt;
+    bool zonesOk = zonesLod.frozenDrift_m < 1e-3f && slowError < slowTolerance;
+    std::printf("time zones + LOD   frozen drift %.4f m, slowed velocity error %.4f m/s: %s\n",
+                zonesLod.frozenDrift_m, slowError, zonesOk ? "ok" : "FAILED");
+    return zonesOk ? 0 : 1;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file prefab_bench.cpp
+ * @brief Compares building objects with the setters and finalize() against Prefab::spawn.
+ *
+ * Each case fills a fresh world with map1's falling box in three ways:
+ *  - setters: a GameObject configured property by property, finalize(), push_back,
+ *    as the loaders and spawners used to do for every instance;
+ *  - prefab: the same box prepared once in a Prefab and stamped with spawn();
+ *  - box2d only: b2CreateBody and b2CreatePolygonShape alone, the floor both paths share.
+ * The report gives the cost per instance of each path. Texture loading is disabled
+ * (headless run), so the setters path does not include the texture cache lookup.
+ *
+ * Usage: prefab_bench [instanceCount...] (default: 1000 10000)
+ */
+#include <SFML/Graphics.hpp>
+#include <box2d/box2d.h>
+#include "game_object.hpp"
+#include "prefab.hpp"
+#include "texture_cache.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+const int RUNS = 9;
+const float BOX_SIZE_M = 0.8f;
+
+/**
+ * @brief map1's falling box, configured with the setters.
+ */
+GameObject makeBox(float x_m, float y_m) {
+    GameObject boxObj;
+    boxObj.setPosition(x_m, y_m);
+    boxObj.setSize(BOX_SIZE_M, BOX_SIZE_M);
+    boxObj.setDynamic(true);
+    boxObj.setColor(sf::Color::Red);
+    boxObj.setSpriteTexturePath("../assets/objects/box.png");
+    boxObj.setLinearDamping(0.1f);
+    boxObj.setDensity(0.5f);
+    boxObj.setFriction(0.7f);
+    boxObj.setRestitution(0.0f);
+    boxObj.setIsPlayerProperty(false);
+    boxObj.setCanJumpOnProperty(true);
+    boxObj.setCollidesWithPlayerProperty(true);
+    return boxObj;
+}
+
+b2Vec2 slot(int i) {
+    return {(i % 100) * 1.0f, (i / 100) * 1.0f};
+}
+
+/**
+ * @brief Time of filling a new world with `instanceCount` boxes, in microseconds per box.
+ */
+template <typename Fill>
+double usPerInstance(int instanceCount, Fill fill) {
+    b2WorldDef worldDef = b2DefaultWorldDef();
+    b2WorldId worldId = b2CreateWorld(&worldDef);
+    GameObjectList gameObjects;
+    gameObjects.reserve(instanceCount);
+
+    auto start = std::chrono::steady_clock::now();
+    fill(worldId, gameObjects);
+    std::chrono::duration<double, std::micro> spent = std::chrono::steady_clock::now() - start;
+
+    gameObjects.clear();
+    b2DestroyWorld(worldId);
+    return spent.count() / instanceCount;
+}
+
+void runCase(int instanceCount) {
+    auto withSetters = [&](b2WorldId worldId, GameObjectList& gameObjects) {
+        for (int i = 0; i < instanceCount; ++i) {
+            b2Vec2 position = slot(i);
+            GameObject boxObj = makeBox(position.x, position.y);
+            if (boxObj.finalize(worldId)) {
+                gameObjects.push_back(boxObj);
+            }
+        }
+    };
+
+    const Prefab boxPrefab(makeBox(0.0f, 0.0f));
+    auto withPrefab = [&](b2WorldId worldId, GameObjectList& gameObjects) {
+        for (int i = 0; i < instanceCount; ++i) {
+            b2Vec2 position = slot(i);
+            boxPrefab.spawn(worldId, gameObjects, position.x, position.y);
+        }
+    };
+
+    auto box2dOnly = [&](b2WorldId worldId, GameObjectList&) {
+        b2ShapeDef shapeDef = b2DefaultShapeDef();
+        b2Polygon box = b2MakeBox(BOX_SIZE_M / 2.0f, BOX_SIZE_M / 2.0f);
+        for (int i = 0; i < instanceCount; ++i) {
+            b2BodyDef bodyDef = b2DefaultBodyDef();
+            bodyDef.type = b2_dynamicBody;
+            bodyDef.position = slot(i);
+            b2BodyId bodyId = b2CreateBody(worldId, &bodyDef);
+            b2CreatePolygonShape(bodyId, &shapeDef, &box);
+        }
+    };
+
+    // The paths take turns so allocator and cache warm-up do not favor one of them; best of RUNS
+    double settersUs = 0.0, prefabUs = 0.0, box2dUs = 0.0;
+    for (int run = 0; run < RUNS; ++run) {
+        double setters = usPerInstance(instanceCount, withSetters);
+        double prefab = usPerInstance(instanceCount, withPrefab);
+        double box2d = usPerInstance(instanceCount, box2dOnly);
+        if (run == 0 || setters < settersUs) settersUs = setters;
+        if (run == 0 || prefab < prefabUs) prefabUs = prefab;
+        if (run == 0 || box2d < box2dUs) box2dUs = box2d;
+    }
+
+    std::printf("instances          %d\n", instanceCount);
+    std::printf("setters            %.3f us/instance\n", settersUs);
+    std::printf("prefab             %.3f us/instance (%.2fx)\n", prefabUs, settersUs / prefabUs);
+    std::printf("box2d only         %.3f us/instance\n", box2dUs);
+    std::printf("game-side setup    %.3f -> %.3f us/instance\n\n", settersUs - box2dUs, prefabUs - box2dUs);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<int> instanceCounts;
+    for (int i = 1; i < argc; ++i) {
+        int count = std::atoi(argv[i]);
+        if (count <= 0) {
+            std::fprintf(stderr, "Usage: %s [instanceCount...]\n", argv[0]);
+            return 1;
+        }
+        instanceCounts.push_back(count);
+    }
+    if (instanceCounts.empty()) {
+        instanceCounts = {1000, 10000};
+    }
+
+    TextureCache::instance().setLoadingEnabled(false);
+    for (int count : instanceCounts) {
+        runCase(count);
+    }
+    return 0;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file timer_wheel_bench.cpp
+ * @brief Compares the timer wheel with polling every timer each step.
+ *
+ * `timerCount` timers with random periods (1 to 10 seconds at 60 Hz) run for
+ * STEPS simulation steps. Every expiry re-arms its timer with a new random delay, and
+ * every tenth expiry also cancels and replaces another timer, like spawners and cues
+ * being stopped. The polled version checks each timer's due step every step, which is
+ * what updateMap1 did with its clock. The report gives the time per step and the
+ * number of expiries (close but not equal: the two versions draw their delays in a
+ * different order).
+ *
+ * Usage: timer_wheel_bench [timerCount...] (default: 1000 10000 100000)
+ */
+#include "timer_wheel.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+const int STEPS = 36000; // 10 minutes at 60 Hz
+const uint32_t MIN_DELAY = 60;
+const uint32_t MAX_DELAY = 600;
+
+struct Result {
+    double msPerStep;
+    uint64_t expiries;
+};
+
+/**
+ * @brief The wheel version. Callbacks only capture the bench and an index, like game
+ * callbacks capturing a few references, so they fit in std::function without allocating.
+ */
+struct WheelBench {
+    explicit WheelBench(int timerCount) : ids(timerCount), pick(0, timerCount - 1) {}
+
+    void arm(int i) {
+        ids[i] = wheel.schedule(delay(rng), [this, i]() { fire(i); });
+    }
+
+    void fire(int i) {
+        ++expiries;
+        arm(i);
+        if (expiries % 10 == 0) {
+            int other = pick(rng);
+            wheel.cancel(ids[other]);
+            arm(other);
+        }
+    }
+
+    TimerWheel wheel;
+    std::vector<TimerId> ids;
+    std::mt19937 rng {42};
+    std::uniform_int_distribution<uint32_t> delay {MIN_DELAY, MAX_DELAY};
+    std::uniform_int_distribution<int> pick;
+    uint64_t expiries {0};
+};
+
+Result runWheel(int timerCount) {
+    WheelBench bench(timerCount);
+    for (int i = 0; i < timerCount; ++i) {
+        bench.arm(i);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    bench.wheel.advance(STEPS);
+    std::chrono::duration<double, std::milli> spent = std::chrono::steady_clock::now() - start;
+    return {spent.count() / STEPS, bench.expiries};
+}
+
+Result runPolled(int timerCount) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<uint32_t> delay(MIN_DELAY, MAX_DELAY);
+    std::uniform_int_distribution<int> pick(0, timerCount - 1);
+    std::vector<uint64_t> due(timerCount);
+    uint64_t now = 0;
+    uint64_t expiries = 0;
+    for (int i = 0; i < timerCount; ++i) {
+        due[i] = delay(rng);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int step = 0; step < STEPS; ++step) {
+        ++now;
+        for (int i = 0; i < timerCount; ++i) {
+            if (due[i] != now) continue;
+            ++expiries;
+            due[i] = now + delay(rng);
+            if (expiries % 10 == 0) {
+                int other = pick(rng);
+                due[other] = now + delay(rng);
+            }
+        }
+    }
+    std::chrono::duration<double, std::milli> spent = std::chrono::steady_clock::now() - start;
+    return {spent.count() / STEPS, expiries};
+}
+
+void runCase(int timerCount) {
+    Result polled = runPolled(timerCount);
+    Result wheel = runWheel(timerCount);
+    std::printf("timers             %d\n", timerCount);
+    std::printf("polled             %.4f ms/step (%llu expiries)\n", polled.msPerStep,
+                static_cast<unsigned long long>(polled.expiries));
+    std::printf("wheel              %.4f ms/step (%llu expiries, %.2fx)\n\n", wheel.msPerStep,
+                static_cast<unsigned long long>(wheel.expiries), polled.msPerStep / wheel.msPerStep);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<int> timerCounts;
+    for (int i = 1; i < argc; ++i) {
+        int count = std::atoi(argv[i]);
+        if (count <= 0) {
+            std::fprintf(stderr, "Usage: %s [timerCount...]\n", argv[0]);
+            return 1;
+        }
+        timerCounts.push_back(count);
+    }
+    if (timerCounts.empty()) {
+        timerCounts = {1000, 10000, 100000};
+    }
+
+    for (int count : timerCounts) {
+        runCase(count);
+    }
+    return 0;
+}
@@ -0,0 +1,186 @@
+/**
+ * @file transform_kernel_bench.cpp
+ * @brief Compares the per-object transform sync with the batched quad kernel.
+ *
+ * A world is filled with rotated dynamic boxes and settled for a few steps. Every
+ * frame, the screen-space corners of all boxes are then produced in three ways:
+ *  - setters: what GameObject::updateShape does (b2VecToSfVec, b2Rot_GetAngle,
+ *    setPosition/setRotation), plus the getTransform() rebuild SFML does at draw
+ *    time and the four transformed corners written to a vertex buffer;
+ *  - batch: TransformBatch gathering the body transforms, then writeQuads();
+ *  - kernel: transformQuads() alone, on already gathered arrays.
+ * The report gives the time per frame of each path and the largest corner
+ * difference between the setter and batch outputs.
+ *
+ * Usage: transform_kernel_bench [objectCount...] (default: 10000 50000)
+ */
+#include <SFML/Graphics.hpp>
+#include <box2d/box2d.h>
+#include "transform_batch.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+const int FRAMES = 200;
+const int SETTLE_STEPS = 30;
+
+struct Scene {
+    b2WorldId worldId;
+    std::vector<b2BodyId> bodies;
+    std::vector<float> halfWidths;
+    std::vector<float> halfHeights;
+    std::vector<sf::Color> colors;
+    std::vector<sf::RectangleShape> shapes; // Set up like GameObject::finalize
+};
+
+Scene createScene(int objectCount) {
+    Scene scene;
+    b2WorldDef worldDef = b2DefaultWorldDef();
+    worldDef.gravity = {0.0f, -10.0f};
+    scene.worldId = b2CreateWorld(&worldDef);
+
+    std::srand(42);
+    int columns = static_cast<int>(std::sqrt(static_cast<float>(objectCount))) + 1;
+    for (int i = 0; i < objectCount; ++i) {
+        float halfWidth = 0.2f + 0.3f * (std::rand() % 100) / 100.0f;
+        float halfHeight = 0.2f + 0.3f * (std::rand() % 100) / 100.0f;
+        b2BodyDef bodyDef = b2DefaultBodyDef();
+        bodyDef.type = b2_dynamicBody;
+        bodyDef.position = {(i % columns) * 1.5f, 2.0f + (i / columns) * 1.5f};
+        bodyDef.rotation = b2MakeRot(2.0f * B2_PI * (std::rand() % 360) / 360.0f);
+        bodyDef.angularVelocity = 1.0f;
+        b2BodyId bodyId = b2CreateBody(scene.worldId, &bodyDef);
+        b2ShapeDef shapeDef = b2DefaultShapeDef();
+        b2Polygon box = b2MakeBox(halfWidth, halfHeight);
+        b2CreatePolygonShape(bodyId, &shapeDef, &box);
+
+        sf::Color color(static_cast<std::uint8_t>(std::rand() % 256), static_cast<std::uint8_t>(std::rand() % 256), 200);
+        sf::RectangleShape shape(sf::Vector2f(metersToPixels(2.0f * halfWidth), metersToPixels(2.0f * halfHeight)));
+        shape.setOrigin(sf::Vector2f(metersToPixels(halfWidth), metersToPixels(halfHeight)));
+        shape.setFillColor(color);
+
+        scene.bodies.push_back(bodyId);
+        scene.halfWidths.push_back(halfWidth);
+        scene.halfHeights.push_back(halfHeight);
+        scene.colors.push_back(color);
+        scene.shapes.push_back(shape);
+    }
+    for (int step = 0; step < SETTLE_STEPS; ++step) {
+        b2World_Step(scene.worldId, 1.0f / 60.0f, 4);
+    }
+    return scene;
+}
+
+/**
+ * @brief The per-object path, writing the same triangles as the kernel for comparison.
+ */
+void syncWithSetters(Scene& scene, std::vector<sf::Vertex>& vertices) {
+    static const int order[TRANSFORM_BATCH_VERTICES_PER_QUAD] = {0, 1, 2, 0, 2, 3};
+    vertices.resize(scene.bodies.size() * TRANSFORM_BATCH_VERTICES_PER_QUAD);
+    for (std::size_t i = 0; i < scene.bodies.size(); ++i) {
+        sf::RectangleShape& shape = scene.shapes[i];
+        b2Transform transform = b2Body_GetTransform(scene.bodies[i]);
+        shape.setPosition(b2VecToSfVec(transform.p));
+        float angleDegreesFloat = -b2Rot_GetAngle(transform.q) * 180.0f / B2_PI;
+        shape.setRotation(sf::degrees(angleDegreesFloat));
+
+        const sf::Transform& matrix = shape.getTransform();
+        sf::Vertex* quad = &vertices[i * TRANSFORM_BATCH_VERTICES_PER_QUAD];
+        for (std::size_t v = 0; v < TRANSFORM_BATCH_VERTICES_PER_QUAD; ++v) {
+            quad[v].position = matrix.transformPoint(shape.getPoint(order[v]));
+            quad[v].color = shape.getFillColor();
+        }
+    }
+}
+
+void syncWithBatch(const Scene& scene, TransformBatch& batch, std::vector<sf::Vertex>& vertices) {
+    batch.clear();
+    for (std::size_t i = 0; i < scene.bodies.size(); ++i) {
+        batch.add(scene.bodies[i], scene.halfWidths[i], scene.halfHeights[i], scene.colors[i]);
+    }
+    vertices.clear();
+    batch.writeQuads(vertices);
+}
+
+template <typename Sync>
+double msPerFrame(Sync sync) {
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        sync();
+    }
+    std::chrono::duration<double, std::milli> spent = std::chrono::steady_clock::now() - start;
+    return spent.count() / FRAMES;
+}
+
+void runCase(int objectCount) {
+    Scene scene = createScene(objectCount);
+    std::vector<sf::Vertex> setterVertices;
+    std::vector<sf::Vertex> batchVertices;
+    TransformBatch batch;
+    batch.reserve(scene.bodies.size());
+
+    double setterMs = msPerFrame([&] { syncWithSetters(scene, setterVertices); });
+    double batchMs = msPerFrame([&] { syncWithBatch(scene, batch, batchVertices); });
+
+    // Kernel alone: the transforms are already gathered
+    std::vector<float> positionX, positionY, cosine, sine;
+    for (b2BodyId bodyId : scene.bodies) {
+        b2Transform transform = b2Body_GetTransform(bodyId);
+        positionX.push_back(transform.p.x);
+        positionY.push_back(transform.p.y);
+        cosine.push_back(transform.q.c);
+        sine.push_back(transform.q.s);
+    }
+    std::vector<sf::Vertex> kernelVertices(scene.bodies.size() * TRANSFORM_BATCH_VERTICES_PER_QUAD);
+    double kernelMs = msPerFrame([&] {
+        transformQuads(positionX.data(), positionY.data(), cosine.data(), sine.data(),
+                       scene.halfWidths.data(), scene.halfHeights.data(), scene.colors.data(),
+                       scene.bodies.size(), kernelVertices.data());
+    });
+
+    float maxError = 0.0f;
+    for (std::size_t v = 0; v < setterVertices.size(); ++v) {
+        sf::Vector2f difference = setterVertices[v].position - batchVertices[v].position;
+        maxError = std::max(maxError, std::max(std::fabs(difference.x), std::fabs(difference.y)));
+    }
+
+    std::printf("objects            %d\n", objectCount);
+    std::printf("setters            %.4f ms/frame\n", setterMs);
+    std::printf("batch              %.4f ms/frame (%.2fx)\n", batchMs, setterMs / batchMs);
+    std::printf("kernel only        %.4f ms/frame (%.2fx)\n", kernelMs, setterMs / kernelMs);
+    std::printf("max corner error   %.4f px\n\n", maxError);
+    b2DestroyWorld(scene.worldId);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<int> objectCounts;
+    for (int i = 1; i < argc; ++i) {
+        int count = std::atoi(argv[i]);
+        if (count <= 0) {
+            std::fprintf(stderr, "Usage: %s [objectCount...]\n", argv[0]);
+            return 1;
+        }
+        objectCounts.push_back(count);
+    }
+    if (objectCounts.empty()) {
+        objectCounts = {10000, 50000};
+    }
+
+#ifdef __SSE2__
+    std::printf("kernel             SSE2\n\n");
+#else
+    std::printf("kernel             scalar\n\n");
+#endif
+    for (int count : objectCounts) {
+        runCase(count);
+    }
+    return 0;
+}
@@ -7,6 +7,8 @@
  * This includes settings for map selection, window dimensions, and physics scaling.
  */
 
+#include <cstdint> // For the collision category masks
+
 // --- Map Selection ---
 #define SELECTED_MAP 1 // Set this to the desired map number
 
@@ -15,8 +17,77 @@ const unsigned int WINDOW_WIDTH  = 1280;
 const unsigned int WINDOW_HEIGHT = 720;
 const float PIXELS_PER_METER = 32.0f;
 
+// --- Rendering ---
+const unsigned int STATIC_TILE_SIZE_PX = 512; // Edge of a static layer cache tile, in pixels
+const float FREEZE_CACHE_MARGIN = 0.5f; // Extra area (fraction of the view) rendered around the camera while frozen
+
+// --- Level Streaming ---
+const float STREAMING_LOAD_RADIUS_M = 60.0f;   // Chunks closer than this to the player are activated
+const float STREAMING_UNLOAD_RADIUS_M = 90.0f; // Chunks farther than this are deactivated (hysteresis)
+const float STREAMING_BUDGET_MS = 2.0f;        // Time allowed for chunk activation per frame
+
+// --- Physics LOD ---
+const float PHYSICS_LOD_FULL_RADIUS_M = 40.0f;     // Regions closer than this to the player are stepped every frame
+const float PHYSICS_LOD_REDUCED_RADIUS_M = 100.0f; // Regions closer than this are stepped at a reduced rate, farther ones sleep
+const int PHYSICS_LOD_REDUCED_RATE = 4;            // A reduced-rate region is stepped once every N frames
+const int PHYSICS_LOD_REBUILD_FRAMES = 15;         // Frames between two recomputations of the regions and their tiers
+
+// --- Profiling ---
+const unsigned int TRACE_BUFFER_EVENTS = 1 << 16; // Trace zones kept per thread (ring buffer), when tracing is compiled in
+const int PHYSICS_WORKER_COUNT = 4;               // Box2D worker threads (including the main thread), capped by the hardware
+const int FRAME_BENCH_FRAMES_PER_LEVEL = 600;      // Frames rendered per level by the flythrough benchmark (--frame-bench)
+
+// --- Logging ---
+const unsigned int LOG_RING_CAPACITY = 256;       // Messages buffered per thread before new ones are dropped
+const unsigned int LOG_MESSAGE_BYTES = 240;       // Longest message text; longer messages are truncated
+const int LOG_DRAIN_INTERVAL_MS = 10;             // Period of the thread writing buffered messages out
+
+// --- Time Rewind ---
+const float REWIND_HISTORY_SECONDS = 30.0f;          // Physics steps kept for rewinding (held key scrubs back through them)
+const unsigned int REWIND_BUDGET_BYTES = 64u << 20;  // Encoded history memory; the oldest steps are dropped beyond it
+const int REWIND_STEPS_PER_FRAME = 1;                // Recorded steps undone per frame while rewinding (1 = real time)
+
+// --- Trajectory Preview ---
+const int TRAJECTORY_PREVIEW_STEPS = 120;            // Steps simulated ahead of a frozen world (2 s at 60 Hz)
+const int TRAJECTORY_ARC_STEPS = 90;                 // Steps simulated for the player's jump arc
+const int TRAJECTORY_SAMPLE_STEPS = 3;               // Steps between two points of a predicted path
+const int TRAJECTORY_SUB_STEPS = 4;                  // Box2D sub-steps of the prediction (the game uses 8)
+const float TRAJECTORY_PREVIEW_RADIUS_M = 30.0f;     // Only bodies closer than this to the player get a path
+const float TRAJECTORY_MIN_TRAVEL_M = 0.1f;          // Paths of bodies moving less than this are not drawn
+const float TRAJECTORY_REPLAN_DISTANCE_M = 0.5f;     // Player displacement that makes the frozen bodies' paths stale
+
+// --- Input ---
+const unsigned int INPUT_QUEUE_CAPACITY = 256;       // Key edges buffered between two simulation steps
+
+// --- Presentation ---
+const int PARALLAX_MAX_LAYERS = 4;                   // Background layers the compositor can blend in its single pass
+const float LOW_LATENCY_MARGIN_MS = 2.0f;            // Slack kept before the presentation deadline in low-latency mode
+const unsigned int LATENCY_SAMPLE_CAPACITY = 4096;   // Input-to-photon samples kept for the percentiles
+
+// --- Physics Debug Draw ---
+const int DEBUG_DRAW_CIRCLE_SEGMENTS = 16;           // Segments of debug circles (even: capsule ends use half of them)
+const std::uint8_t DEBUG_DRAW_FILL_ALPHA = 80;       // Opacity of debug shape interiors
+
+// --- Particles ---
+const float PARTICLE_CPU_BUDGET_MS = 2.0f;           // Update and batch writing of every particle, per frame
+const float PARTICLE_IMPACT_MIN_SPEED = 2.0f;        // Approach speed (m/s) of the slowest hit that reports an event
+const float PARTICLE_IMPACT_REFERENCE_SPEED = 6.0f;  // Hit approach speed (m/s) giving an impact of strength 1
+
+// --- Quality Governor ---
+const float QUALITY_FRAME_BUDGET_MS = 14.0f;         // Frame cost (90th percentile) the governor holds, under the 16.7 ms period
+const int QUALITY_WINDOW_FRAMES = 60;                // Frames between two decisions
+const float QUALITY_UPGRADE_RATIO = 0.7f;            // Quality is raised back when the cost falls under this share of the budget...
+const int QUALITY_UPGRADE_WINDOWS = 3;               // ...for this many windows in a row
+const int QUALITY_MIN_SUBSTEPS = 4;                  // Bounds of each knob
+const int QUALITY_MAX_SUBSTEPS = 8;
+const float QUALITY_MIN_OFFSCREEN_SCALE = 0.5f;
+const int QUALITY_MIN_PARTICLES = 256;
+const int QUALITY_MAX_PARTICLES = 4096;
+
 // --- Game Loop ---
 const float UPDATE_DELTA = 1.0f / 60.0f;
+const float KILL_PLANE_Y_M = -20.0f;                 // The player dies and dynamic objects are destroyed below this height
+const uint32_t MAP1_SPAWN_PERIOD_STEPS = 60;         // Map1 drops a pair of boxes every second of simulated time
 
 
 // --- Physics Collision Categories ---
@@ -0,0 +1,74 @@
+#ifndef DESTRUCTION_QUEUE_HPP
+#define DESTRUCTION_QUEUE_HPP
+
+#include <box2d/box2d.h>
+#include "game_object.hpp" // Includes utils.hpp and constants.hpp
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Destroys GameObjects in one batch after the physics step.
+ *
+ * Gameplay code (event handlers, spawners, the game loop) never destroys an object
+ * directly: destroyLater() only marks it, so pointers and indices held during the
+ * step and the event dispatch stay valid. flush() then destroys the bodies of every
+ * marked object (Box2D destroys their shapes and joints with them) and compacts
+ * gameObjects with swap-remove: each removed object is replaced by the last one, so
+ * a flush costs one pass plus one copy per removed object, and the storage stays as
+ * large as the live scene.
+ *
+ * Body ids are the stable handles: they survive compaction, and b2Body_IsValid tells
+ * when their object is gone. Indices into gameObjects must go through remapIndex()
+ * after a flush that returned true, and index-based caches must be re-indexed, as
+ * after LevelStreamer::update.
+ */
+class DestructionQueue {
+public:
+    /**
+     * @brief Marks an object for destruction at the next flush(). Marking twice is harmless.
+     */
+    void destroyLater(GameObject& obj);
+
+    /**
+     * @brief Marks every non-player dynamic object that fell below killY_m (off-map debris).
+     * @param gameObjects The vector of all GameObjects in the scene.
+     * @param killY_m Height under which objects are considered lost, in meters.
+     */
+    void destroyFallen(GameObjectList& gameObjects, float killY_m);
+
+    /**
+     * @brief Destroys the marked objects' bodies and removes them from gameObjects.
+     * Call after the step and the event dispatch, on the thread owning the world.
+     * @return True if gameObjects changed.
+     */
+    bool flush(GameObjectList& gameObjects);
+
+    /**
+     * @brief Index, after the last flush, of the object that was at `index` before it.
+     * @return The new index, or -1 if the object was destroyed (or index was -1).
+     */
+    int remapIndex(int index) const;
+
+    /**
+     * @brief Number of objects destroyed by the last flush.
+     */
+    std::size_t lastFlushCount() const { return removed_.size(); }
+
+    /**
+     * @brief Number of objects destroyed since the queue was created.
+     */
+    std::size_t totalDestroyed() const { return totalDestroyed_; }
+
+private:
+    struct Move {
+        int from;
+        int to;
+    };
+
+    std::size_t pending_ {0};  // Marks since the last flush (objects may have been removed since)
+    std::vector<int> removed_; // Indices before the last flush
+    std::vector<Move> moved_;
+    std::size_t totalDestroyed_ {0};
+};
+
+#endif // DESTRUCTION_QUEUE_HPP
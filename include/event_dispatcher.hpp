@@ -0,0 +1,129 @@
+#ifndef EVENT_DISPATCHER_HPP
+#define EVENT_DISPATCHER_HPP
+
+#include <box2d/box2d.h>
+#include "game_object.hpp" // Includes utils.hpp and constants.hpp
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Kinds of gameplay events read from the Box2D world after each step.
+ */
+enum class GameEventType {
+    SensorBegin, // objectA is the sensor, objectB the visitor
+    SensorEnd,   // objectA is the sensor, objectB the visitor
+    ContactBegin,
+    ContactEnd,
+    Hit,         // Requires enableHitEvents on one of the shapes
+    Count
+};
+
+/**
+ * @brief A sensor, contact or hit event resolved to the GameObjects involved.
+ * objectA always matches the first category the handler was registered with.
+ * The objects may be null if a shape has no GameObject or was destroyed.
+ */
+struct GameEvent {
+    GameEventType type;
+    GameObject* objectA {nullptr};
+    GameObject* objectB {nullptr};
+    b2ShapeId shapeA {b2_nullShapeId};
+    b2ShapeId shapeB {b2_nullShapeId};
+    b2Vec2 point {0.0f, 0.0f};  // Hit events only
+    b2Vec2 normal {0.0f, 0.0f}; // Hit events only, from A to B
+    float approachSpeed {0.0f}; // Hit events only
+};
+
+/**
+ * @brief Dispatches Box2D sensor and contact events to handlers registered per category pair.
+ *
+ * Each shape is classified by the lowest bit of its collision category (CATEGORY_PLAYER,
+ * CATEGORY_FLAG...). Handlers live in a table indexed by event type and the two categories,
+ * so routing an event costs a table lookup however many handler types exist, and events
+ * no handler cares about are skipped immediately. The time spent in each handler is
+ * accumulated so costly gameplay reactions can be spotted.
+ */
+class EventDispatcher {
+public:
+    using Handler = std::function<void(const GameEvent&)>;
+
+    /**
+     * @brief Accumulated cost of one handler.
+     */
+    struct HandlerStats {
+        std::string name;
+        uint64_t calls {0};
+        double totalMs {0.0};
+        double maxMs {0.0};
+    };
+
+    /**
+     * @brief Registers a handler for events between two collision categories.
+     * Contact and hit events match in either order (objects are swapped so objectA has
+     * categoryA); sensor events only match a categoryA sensor visited by a categoryB shape.
+     * The masks may share bits: a handler is called once per event even if both orders match.
+     * @param type The event type to listen to.
+     * @param categoryA Category bits of the first object (several bits register several pairs).
+     * @param categoryB Category bits of the second object.
+     * @param name Name used in the timing report.
+     * @param handler Function called for each matching event.
+     */
+    void on(GameEventType type, uint64_t categoryA, uint64_t categoryB, const std::string& name, Handler handler);
+
+    /**
+     * @brief Reads the sensor and contact events of the last step and calls the matching handlers.
+     * Call once after b2World_Step. Handlers must not add or remove GameObjects.
+     * @param worldId The ID of the Box2D world.
+     * @param gameObjects The vector of all GameObjects, used to resolve shapes.
+     */
+    void dispatch(b2WorldId worldId, GameObjectList& gameObjects);
+
+    /**
+     * @brief Per-handler timing counters, in registration order.
+     */
+    const std::vector<HandlerStats>& handlerStats() const { return stats_; }
+
+    /**
+     * @brief Prints the timing counters of the handlers that were called at least once.
+     */
+    void printStats(std::ostream& out) const;
+
+    /**
+     * @brief Removes every handler and counter. Call when the level is torn down.
+     */
+    void clear();
+
+private:
+    static const int CATEGORY_SLOTS = 16; // Category bits above this are not dispatched
+
+    struct Route {
+        std::size_t handler;
+        bool swapped; // Objects are passed in reverse order
+    };
+
+    using RouteTable = std::array<std::array<std::vector<Route>, CATEGORY_SLOTS>, CATEGORY_SLOTS>;
+
+    struct ShapeInfo {
+        std::size_t objectIndex;
+        int slot;
+    };
+
+    static int slotOf(uint64_t categoryBits);
+    void indexShapes(GameObjectList& gameObjects);
+    bool resolve(b2ShapeId shapeId, GameObjectList& gameObjects, GameObject*& object, int& slot);
+    void route(GameEvent& event, GameObjectList& gameObjects);
+
+    std::array<RouteTable, static_cast<std::size_t>(GameEventType::Count)> routes_;
+    std::vector<Handler> handlers_;
+    std::vector<HandlerStats> stats_;
+    std::unordered_map<uint64_t, ShapeInfo> shapes_; // Stored b2ShapeId -> owning GameObject
+    std::size_t indexedCount_ {0};
+    bool reindexed_ {false}; // The index is rebuilt at most once per dispatch
+};
+
+#endif // EVENT_DISPATCHER_HPP
@@ -0,0 +1,36 @@
+#ifndef FRAME_BENCHMARK_HPP
+#define FRAME_BENCHMARK_HPP
+
+#include "constants.hpp"
+#include <string>
+
+/**
+ * @brief Settings of the end-to-end frame benchmark (sfml_blob --frame-bench [frames] [output.json]).
+ */
+struct FrameBenchmarkOptions {
+    int framesPerLevel {FRAME_BENCH_FRAMES_PER_LEVEL};
+    std::string outPath {"frame_benchmark.json"};
+};
+
+/**
+ * @brief Renders every level along a scripted camera path and reports the cost of each frame.
+ *
+ * Each map is loaded and the camera travels at constant speed from the left edge of the
+ * level to its right edge in `framesPerLevel` frames, independently of the player.
+ * Physics, streaming, shape updates and the complete SceneRenderer frame are run every
+ * frame with a fixed time step and a fixed random seed (map1's box rain is scheduled
+ * on the TimerWheel, which advances once per simulation step), so runs are comparable
+ * across commits.
+ *
+ * Frames are rendered into an offscreen render texture: no window is opened, so there
+ * is no vsync and no frame rate limit. On Linux, Mesa is asked for its software
+ * rasterizer (LIBGL_ALWAYS_SOFTWARE=1, unless already set), so the benchmark runs on
+ * GPU-less machines under a virtual X server (e.g. xvfb-run).
+ *
+ * The JSON report gives, per level, the CPU frame time (mean, p50, p99, max) and the
+ * draw calls and vertices per frame (mean, max) counted by RenderStats.
+ * @return 0 on success, -1 if the renderer could not be set up or the report written.
+ */
+int runFrameBenchmark(const FrameBenchmarkOptions& options);
+
+#endif // FRAME_BENCHMARK_HPP
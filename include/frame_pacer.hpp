@@ -0,0 +1,89 @@
+#ifndef FRAME_PACER_HPP
+#define FRAME_PACER_HPP
+
+#include "constants.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Timing of one frame on the input clock (InputQueue::nowNs), carried with its snapshot
+ * from the simulation thread to the render thread.
+ */
+struct FrameTiming {
+    int64_t latchNs {0};     // Input was sampled for this frame
+    int64_t deadlineNs {0};  // Presentation deadline in low-latency mode, 0 otherwise
+    int64_t inputNs {-1};    // Oldest key press the frame reflects, -1 if none
+};
+
+/**
+ * @brief Bounded set of latency samples, in milliseconds, with percentiles.
+ * Keeps the newest LATENCY_SAMPLE_CAPACITY samples.
+ */
+class LatencySamples {
+public:
+    void add(float ms);
+    void clear();
+    std::size_t count() const { return samples_.size(); }
+
+    /**
+     * @brief The sample below which this fraction of the samples lies (0.5 for the median), 0 if empty.
+     */
+    float percentile(float fraction) const;
+
+private:
+    std::vector<float> samples_;
+    std::size_t next_ {0}; // Oldest sample, overwritten once full
+};
+
+/**
+ * @brief Paces frames in low-latency mode by late latching.
+ *
+ * By default the game samples input, steps and renders as soon as the previous frame
+ * was drawn, then display() waits for the frame rate limit: the frame shows input that
+ * is up to a whole frame old. In low-latency mode the window has no frame rate limit;
+ * instead latch() sleeps until the presentation deadline minus the expected cost of a
+ * frame (input to display() returning), so input is sampled as late as possible.
+ * Deadlines are spaced by UPDATE_DELTA. The cost estimate follows slower frames at
+ * once and faster ones gradually, and LOW_LATENCY_MARGIN_MS of slack is kept; a frame
+ * presented after its deadline is counted as missed and the next deadline is the first
+ * one still reachable.
+ *
+ * latch() is called on the simulation thread, presented() on the render thread.
+ */
+class FramePacer {
+public:
+    explicit FramePacer(bool lowLatency);
+
+    bool lowLatency() const { return lowLatency_; }
+
+    /**
+     * @brief Start of a frame, before polling input. In low-latency mode, sleeps until the
+     * latest point from which the frame can still meet its deadline.
+     */
+    FrameTiming latch();
+
+    /**
+     * @brief A frame's display() returned.
+     * @param timing The timing latch() gave that frame.
+     * @param presentNs Time display() returned, on the input clock.
+     */
+    void presented(const FrameTiming& timing, int64_t presentNs);
+
+    /**
+     * @brief Expected time from latch to display() returning, in milliseconds.
+     */
+    float frameCostMs() const { return static_cast<float>(frameCostNs_.load(std::memory_order_relaxed)) * 1e-6f; }
+
+    uint64_t missedDeadlines() const { return missed_.load(std::memory_order_relaxed); }
+
+private:
+    bool lowLatency_;
+    int64_t periodNs_;
+    int64_t nextDeadlineNs_ {0}; // Simulation thread
+    std::atomic<int64_t> frameCostNs_;
+    std::atomic<uint64_t> missed_ {0};
+};
+
+#endif // FRAME_PACER_HPP
@@ -0,0 +1,69 @@
+#ifndef FROZEN_SCENE_CACHE_HPP
+#define FROZEN_SCENE_CACHE_HPP
+
+#include <SFML/Graphics.hpp>
+#include "constants.hpp"
+#include <functional>
+#include <memory>
+#include <optional>
+
+/**
+ * @brief Offscreen snapshot of the world used while time is frozen.
+ *
+ * During a time freeze every body except the player is static, so the world only
+ * needs to be rendered once. The cache renders an area larger than the camera view
+ * (extended by FREEZE_CACHE_MARGIN on each side) into a render texture and then
+ * composites that texture every frame. The world is rendered again only when the
+ * camera leaves the cached area or the cache is invalidated. The texture can be
+ * rendered at a lower resolution than the window (setResolutionScale) and stretched.
+ */
+class FrozenSceneCache {
+public:
+    /**
+     * @brief Callback drawing the world (everything except the player, HUD and overlays).
+     * Receives the target to draw on and the view selecting the area to draw.
+     */
+    using DrawWorldFn = std::function<void(sf::RenderTarget&, const sf::View&)>;
+
+    /**
+     * @brief Draws the frozen world, re-rendering the snapshot first if needed.
+     * @param target The render target to draw on (its current view must be `view`).
+     * @param view The camera view.
+     * @param drawWorld Callback used to render the world into the snapshot.
+     */
+    void draw(sf::RenderTarget& target, const sf::View& view, const DrawWorldFn& drawWorld);
+
+    /**
+     * @brief Returns a sprite showing the frozen world, re-rendering the snapshot first if needed.
+     * The sprite references the snapshot texture, valid until the next snapshot() or invalidate().
+     * @return The sprite, or std::nullopt if no offscreen texture is available.
+     */
+    std::optional<sf::Sprite> snapshot(const sf::View& view, const DrawWorldFn& drawWorld);
+
+    /**
+     * @brief Discards the snapshot. Call when time resumes or the scene changes.
+     */
+    void invalidate() { valid_ = false; }
+
+    /**
+     * @brief Checks whether a snapshot is currently available.
+     */
+    bool isValid() const { return valid_; }
+
+    /**
+     * @brief Sets the texture resolution relative to the window (1 is pixel for pixel).
+     * A different scale discards the snapshot.
+     */
+    void setResolutionScale(float scale);
+
+private:
+    bool covers(const sf::View& view) const;
+    void render(const sf::View& view, const DrawWorldFn& drawWorld);
+
+    std::unique_ptr<sf::RenderTexture> texture_;
+    sf::FloatRect cachedArea_; // World pixel area held by the snapshot
+    float resolutionScale_ {1.0f};
+    bool valid_ {false};
+};
+
+#endif // FROZEN_SCENE_CACHE_HPP
@@ -4,6 +4,7 @@
 #include <SFML/Graphics.hpp>
 #include <box2d/box2d.h>
 #include "utils.hpp" // Includes constants.hpp
+#include "level_arena.hpp" // For GameObjectList storage
 #include <map>
 #include <string>
 #include <vector>
@@ -52,13 +53,14 @@ public:
     bool canJumpOn; // Actual gameplay flag, set during finalize
     bool isFlag_ {false}; // Actual flag, set during finalize
     bool isTremplin {false};
+    bool markedForDestruction_ {false}; // Set by DestructionQueue::destroyLater, removed at its next flush
 
     // Sprite and Animation specific (primarily for Player)
     std::optional<sf::Sprite> sprite;
     bool isPlayer; // Flag to identify the player object for animation, set during finalize
-    std::map<std::string, std::vector<sf::Texture>> animations; // e.g., "idle" -> {texture_idle}, "walk" -> {walk_tex1, walk_tex2}
+    std::map<std::string, std::vector<const sf::Texture*>> animations; // e.g., "idle" -> {texture_idle}, "walk" -> {walk_tex1, walk_tex2}; owned by TextureCache
     std::map<std::string, float> animationFrameDurations; // e.g., "walk" -> 0.15f (seconds per frame)
-    sf::Texture genericTexture_; // Texture for non-animated sprites (e.g., flag)
+    const sf::Texture* genericTexture_ {nullptr}; // Texture for non-animated sprites (e.g., flag), owned by TextureCache
     std::string spriteTexturePath_prop_; // Path for generic sprite texture
 
 
@@ -71,6 +73,27 @@ public:
     };
     std::optional<PlayerShapeInfo> playerShapeInfo; // Store if this is a player
 
+    /**
+     * @brief An extra shape on the object's body, for composite props (e.g. the tremplin).
+     * Each part has its own box, material, filter and sensor flags; all parts move
+     * rigidly with the body. The object's own size and properties still make its main shape.
+     */
+    struct ShapePart {
+        b2Vec2 offset {0.0f, 0.0f}; // Center of the box relative to the body, in meters
+        float width_m {1.0f};
+        float height_m {1.0f};
+        float density {1.0f};
+        float friction {0.7f};
+        float restitution {0.1f};
+        uint64_t categoryBits {CATEGORY_WORLD};
+        uint64_t maskBits {CATEGORY_PLAYER | CATEGORY_WORLD | CATEGORY_TREMPLIN};
+        bool isSensor {false};
+        bool enableSensorEvents {false};
+        bool canJumpOn {false};
+        b2ShapeId shapeId {b2_nullShapeId}; // Set by finalize()
+    };
+    std::vector<ShapePart> shapeParts; // Created by finalize(), after the main shape
+
     std::string currentAnimationName;
     int currentFrame;
     float animationTimer;
@@ -81,7 +104,9 @@ public:
      * @brief Default constructor.
      */
     GameObject();
-    GameObject(const GameObject& other);
+    // Textures are owned by TextureCache: copied sprites stay linked
+    GameObject(const GameObject& other) = default;
+    GameObject& operator=(const GameObject& other) = default;
 
     // --- Setters for properties ---
     void setPosition(float x, float y);
@@ -105,6 +130,7 @@ public:
     void setIsSensorProperty(bool isSensorProp); // Sets the property to make the shape a sensor
     void setEnableSensorEventsProperty(bool enableSensorEventsProp); // Sets property to enable sensor events
     void setPendingImpulsion(b2Vec2 impulsion); // Sets the pending impulsion
+    void addShapePart(const ShapePart& part); // Adds an extra shape to the body (before finalize)
     void setRotation(float degrees) {
         rotation_deg_ = degrees;
     }
@@ -118,6 +144,32 @@ public:
      */
     bool finalize(b2WorldId worldId);
 
+    // --- Pieces of finalize(), shared with Prefab ---
+    /**
+     * @brief Sets up the SFML shape, the gameplay flags and the generic sprite from the properties.
+     */
+    void prepareVisual();
+
+    /**
+     * @brief Body definition built from the properties, at (x_m_, y_m_).
+     */
+    b2BodyDef makeBodyDef() const;
+
+    /**
+     * @brief Definition of the main shape, built from the properties.
+     */
+    b2ShapeDef makeShapeDef() const;
+
+    /**
+     * @brief Definition of a shape part (no density on a static body).
+     */
+    b2ShapeDef makeShapeDef(const ShapePart& part) const;
+
+    /**
+     * @brief The box of a shape part, in body coordinates.
+     */
+    static b2Polygon makePartBox(const ShapePart& part);
+
 
     // Methods for player animation
     void loadPlayerAnimation(const std::string& name, const std::vector<std::string>& framePaths, float frameDuration);
@@ -132,22 +184,55 @@ public:
     void updateShape();
 
     /**
-     * @brief Draws the SFML shape to the render window.
-     * @param window The SFML RenderWindow to draw on.
+     * @brief Applies the pending impulsion (dynamic bodies only). Part of updateShape(),
+     * called alone for objects drawn as batched quads.
      */
-    void draw(sf::RenderWindow& window) const;
+    void applyPendingImpulsion();
 
     /**
-     * @brief Checks if the GameObject has a valid Box2D body.
-     * @return True if the bodyId is not null, false otherwise.
+     * @brief True for plain dynamic rectangles (no sprite, not the player).
+     * The renderer draws them through a TransformBatch straight from their body's
+     * transform, so the game loop does not update their sfShape.
      */
-    bool isValid() const;
+    bool drawnAsQuad() const;
 
     /**
-     * @brief Ensures the sprite's internal texture pointer is correctly linked
-     * to this GameObject's own texture members. Crucial after copying a GameObject.
+     * @brief Draws the SFML shape to a render target.
+     * @param target The SFML render target (window or render texture) to draw on.
      */
-    void ensureCorrectSpriteTextureLink();
+    void draw(sf::RenderTarget& target) const;
+
+    /**
+     * @brief The sprite draw() would draw, or nullptr if the object is drawn as its shape (or not at all).
+     */
+    const sf::Sprite* visibleSprite() const;
+
+    /**
+     * @brief The shape draw() would draw, or nullptr if the object is drawn as a sprite (or not at all).
+     */
+    const sf::RectangleShape* visibleShape() const;
+
+    /**
+     * @brief True if the shape is the object's main shape or one of its parts.
+     */
+    bool ownsShape(b2ShapeId shape) const;
+
+    /**
+     * @brief Whether the player can jump from the given shape of this object
+     * (canJumpOn for the main shape, the part's own flag for a part).
+     */
+    bool canJumpOnShape(b2ShapeId shape) const;
+
+    /**
+     * @brief Checks if the GameObject has a valid Box2D body.
+     * @return True if the bodyId is not null, false otherwise.
+     */
+    bool isValid() const;
 };
 
+/**
+ * @brief The list of a level's GameObjects. Its storage lives in the level's arena.
+ */
+using GameObjectList = std::vector<GameObject, ArenaAllocator<GameObject>>;
+
 #endif
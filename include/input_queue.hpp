@@ -0,0 +1,135 @@
+#ifndef INPUT_QUEUE_HPP
+#define INPUT_QUEUE_HPP
+
+#include <SFML/Window.hpp>
+#include "constants.hpp"
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Game actions the keyboard is bound to. Several keys can share an action
+ * (the arrows and QDZ both move and jump). F1 - F4 switch the physics debug view.
+ */
+enum class InputAction : uint8_t {
+    MoveLeft,
+    MoveRight,
+    Jump,
+    TimeFreeze,
+    Rewind,
+    Reset,
+    DebugShapes,
+    DebugBounds,
+    DebugJoints,
+    DebugContacts,
+    Count
+};
+
+/**
+ * @brief Press or release of an action, stamped when the window reported it.
+ */
+struct InputEvent {
+    int64_t timeNs;
+    InputAction action;
+    bool pressed;
+};
+
+/**
+ * @brief The input of one simulation step: what was held at its end and every edge since
+ * the previous step, one bit per InputAction. A key pressed and released between two
+ * steps shows as pressed and released without being held. This is what a replay records.
+ */
+struct InputStep {
+    uint32_t held {0};
+    uint32_t pressed {0};
+    uint32_t released {0};
+    std::array<float, static_cast<std::size_t>(InputAction::Count)> pressAge {}; // Seconds from the newest press to the step
+    int64_t firstPressNs {-1}; // Oldest press of the step on the input clock, -1 if none
+
+    static uint32_t bit(InputAction action) { return 1u << static_cast<unsigned>(action); }
+
+    /**
+     * @brief True if the action was held at the end of the step or tapped during it.
+     */
+    bool down(InputAction action) const { return ((held | pressed) & bit(action)) != 0; }
+    bool wasPressed(InputAction action) const { return (pressed & bit(action)) != 0; }
+    bool wasReleased(InputAction action) const { return (released & bit(action)) != 0; }
+
+    /**
+     * @brief Time between the newest press of the action and the step, 0 if it was not pressed.
+     */
+    float pressAgeSeconds(InputAction action) const { return pressAge[static_cast<std::size_t>(action)]; }
+};
+
+/**
+ * @brief Delay between a press being reported by the window and the step that used it.
+ */
+struct InputLatencyStats {
+    uint64_t presses {0};
+    float averageMs {0.0f};
+    float maxMs {0.0f};
+};
+
+/**
+ * @brief Keyboard input captured as timestamped events and resolved once per simulation step.
+ *
+ * push() is fed every window event: key events are mapped to actions and stamped, auto-repeats
+ * and extra keys of an already held action are dropped, and the resulting edges go into a
+ * single-producer, single-consumer lock-free ring of INPUT_QUEUE_CAPACITY events (so events
+ * could come from another thread than the one stepping). resolve() consumes the events up to
+ * the step's time and returns its InputStep, so no tap is lost however short it is, and
+ * accumulates the press-to-step latency.
+ *
+ * Losing the window focus releases every held action.
+ */
+class InputQueue {
+public:
+    InputQueue();
+
+    /**
+     * @brief Current time on the input clock, in nanoseconds.
+     */
+    static int64_t nowNs();
+
+    /**
+     * @brief Records a window event if it is a bound key, or a focus loss. Producer side.
+     * @return False if the ring was full and an edge was dropped.
+     */
+    bool push(const sf::Event& event);
+
+    /**
+     * @brief Consumes the edges that happened up to stepTimeNs. Consumer side.
+     * @param stepTimeNs Time of the step on the input clock (nowNs()).
+     */
+    InputStep resolve(int64_t stepTimeNs);
+
+    InputLatencyStats latencyStats() const;
+    void resetLatencyStats();
+
+    /**
+     * @brief Edges dropped because the ring was full.
+     */
+    uint64_t droppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    bool pushEdge(InputAction action, bool pressed, int64_t timeNs);
+
+    std::vector<InputEvent> ring_;
+    std::atomic<uint64_t> head_ {0}; // Written by the producer
+    std::atomic<uint64_t> tail_ {0}; // Written by the consumer
+    std::atomic<uint64_t> dropped_ {0};
+
+    // Producer
+    std::bitset<sf::Keyboard::KeyCount> keysDown_;
+    std::array<int, static_cast<std::size_t>(InputAction::Count)> keysPerAction_ {};
+
+    // Consumer
+    uint32_t held_ {0};
+    uint64_t latencyCount_ {0};
+    double latencySumMs_ {0.0};
+    float latencyMaxMs_ {0.0f};
+};
+
+#endif // INPUT_QUEUE_HPP
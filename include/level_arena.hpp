@@ -0,0 +1,122 @@
+#ifndef LEVEL_ARENA_HPP
+#define LEVEL_ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Bump allocator holding the game-side data of one level.
+ *
+ * Allocations are carved sequentially out of large blocks and individual frees are
+ * ignored; everything is released at once by reset() when the level is torn down.
+ * The first block is kept across resets, so loading level after level reuses the
+ * same memory instead of fragmenting the heap. Reserved blocks are reported to the
+ * MemoryTracker under MemorySubsystem::LevelArena.
+ */
+class LevelArena {
+public:
+    /**
+     * @param blockSize Size of each block reserved from the heap, in bytes.
+     */
+    explicit LevelArena(std::size_t blockSize = 256 * 1024);
+    ~LevelArena();
+
+    LevelArena(const LevelArena&) = delete;
+    LevelArena& operator=(const LevelArena&) = delete;
+
+    /**
+     * @brief Returns `bytes` of memory aligned to `alignment`.
+     */
+    void* allocate(std::size_t bytes, std::size_t alignment);
+
+    /**
+     * @brief Gives memory back. Only the most recent allocation is actually reclaimed.
+     */
+    void deallocate(void* ptr, std::size_t bytes);
+
+    /**
+     * @brief Releases every allocation. Objects living in the arena must be destroyed first.
+     */
+    void reset();
+
+    /**
+     * @brief Bytes handed out since the last reset.
+     */
+    std::size_t usedBytes() const { return usedBytes_; }
+
+    /**
+     * @brief Highest usedBytes() seen so far.
+     */
+    std::size_t peakBytes() const { return peakBytes_; }
+
+    /**
+     * @brief Number of allocations since the last reset.
+     */
+    std::size_t allocationCount() const { return allocationCount_; }
+
+private:
+    struct Block {
+        char* data;
+        std::size_t size;
+    };
+
+    void addBlock(std::size_t minSize);
+
+    std::size_t blockSize_;
+    std::vector<Block> blocks_;
+    std::size_t current_ {0}; // Index of the block being filled
+    std::size_t offset_ {0};  // First free byte in the current block
+    void* last_ {nullptr};    // Most recent allocation, the only one deallocate() can reclaim
+    std::size_t usedBytes_ {0};
+    std::size_t peakBytes_ {0};
+    std::size_t allocationCount_ {0};
+};
+
+/**
+ * @brief Standard allocator drawing from a LevelArena (or the heap when it has none).
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ArenaAllocator() noexcept = default;
+    explicit ArenaAllocator(LevelArena* arena) noexcept : arena_(arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena()) {}
+
+    T* allocate(std::size_t n) {
+        if (arena_ == nullptr) return std::allocator<T>().allocate(n);
+        return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        if (arena_ == nullptr) {
+            std::allocator<T>().deallocate(ptr, n);
+        } else {
+            arena_->deallocate(ptr, n * sizeof(T));
+        }
+    }
+
+    LevelArena* arena() const noexcept { return arena_; }
+
+private:
+    LevelArena* arena_ {nullptr};
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept {
+    return a.arena() == b.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept {
+    return !(a == b);
+}
+
+#endif // LEVEL_ARENA_HPP
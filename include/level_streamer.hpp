@@ -0,0 +1,103 @@
+#ifndef LEVEL_STREAMER_HPP
+#define LEVEL_STREAMER_HPP
+
+#include <box2d/box2d.h>
+#include "game_object.hpp" // Includes utils.hpp and constants.hpp
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Streams a long level in and out as spatial chunks along the X axis.
+ *
+ * A map registers its content as chunks: a horizontal extent plus a builder that
+ * creates the chunk's GameObjects (bodies, joints, sprites). Chunks whose extent comes
+ * within STREAMING_LOAD_RADIUS_M of the focus point (the player) are activated, and
+ * chunks farther than STREAMING_UNLOAD_RADIUS_M are deactivated: their bodies are
+ * destroyed and their GameObjects removed. Activation is spread across frames within
+ * STREAMING_BUDGET_MS. The transforms and velocities of dynamic objects are saved on
+ * deactivation and restored the next time the chunk is activated, so memory and step
+ * cost depend on the active window rather than on the total level length.
+ *
+ * Builders must be deterministic (create the same objects in the same order every time)
+ * and keep joints inside their own chunk. Objects destroyed while their chunk was active
+ * (see DestructionQueue) are created anew, at their initial state, on the next activation.
+ */
+class LevelStreamer {
+public:
+    /**
+     * @brief Creates the GameObjects of a chunk and appends them to the vector.
+     */
+    using ChunkBuilder = std::function<void(b2WorldId, GameObjectList&)>;
+
+    /**
+     * @brief Registers a chunk. Nothing is created until the chunk is activated.
+     * @param minX_m Left edge of the chunk content, in meters.
+     * @param maxX_m Right edge of the chunk content, in meters.
+     * @param builder Function creating the chunk's GameObjects.
+     */
+    void addChunk(float minX_m, float maxX_m, ChunkBuilder builder);
+
+    /**
+     * @brief Synchronously activates every chunk in range of the focus point.
+     * Call once after loading a map so the player does not start over unloaded ground.
+     * @return True if gameObjects changed.
+     */
+    bool prime(b2WorldId worldId, GameObjectList& gameObjects, float focusX_m);
+
+    /**
+     * @brief Activates and deactivates chunks around the focus point. Call once per frame.
+     * Removing objects compacts gameObjects, so indices into it must be recomputed
+     * whenever this returns true.
+     * @return True if gameObjects changed.
+     */
+    bool update(b2WorldId worldId, GameObjectList& gameObjects, float focusX_m);
+
+    /**
+     * @brief Forgets every chunk. The world itself is destroyed by the caller.
+     */
+    void clear();
+
+    /**
+     * @brief True if no chunk was registered (the map is not streamed).
+     */
+    bool empty() const { return chunks_.empty(); }
+
+    /**
+     * @brief Number of chunks currently instantiated in the world.
+     */
+    std::size_t activeChunkCount() const;
+
+    /**
+     * @brief Horizontal extent of every registered chunk, active or not.
+     * @return False if no chunk was registered.
+     */
+    bool extent(float& minX_m, float& maxX_m) const;
+
+private:
+    struct SavedBodyState {
+        b2Vec2 position;
+        b2Rot rotation;
+        b2Vec2 linearVelocity;
+        float angularVelocity;
+        bool valid {false}; // False if the body was destroyed before the chunk was deactivated
+    };
+
+    struct Chunk {
+        float minX_m {0.0f};
+        float maxX_m {0.0f};
+        ChunkBuilder builder;
+        bool active {false};
+        std::vector<uint64_t> bodies;      // Stored b2BodyIds of the chunk's GameObjects, in creation order
+        std::vector<SavedBodyState> saved; // One entry per body, empty until first deactivation
+    };
+
+    float distanceTo(const Chunk& chunk, float focusX_m) const;
+    void activate(b2WorldId worldId, Chunk& chunk, GameObjectList& gameObjects);
+    void deactivate(Chunk& chunk, GameObjectList& gameObjects);
+    bool activateInRange(b2WorldId worldId, GameObjectList& gameObjects, float focusX_m, bool budgeted);
+
+    std::vector<Chunk> chunks_;
+};
+
+#endif // LEVEL_STREAMER_HPP
@@ -0,0 +1,222 @@
+#ifndef LOGGER_HPP
+#define LOGGER_HPP
+
+#include "constants.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Severity of a log message. Messages below the logger's minimum level are skipped
+ * before anything is formatted.
+ */
+enum class LogLevel : uint8_t {
+    Debug,
+    Info,
+    Warning,
+    Error
+};
+
+/**
+ * @brief Subsystem a log message comes from. Each category can be muted on its own.
+ */
+enum class LogCategory : uint8_t {
+    General,
+    Loading,  // Map loaders and level objects
+    Gameplay,
+    Physics,
+    Render,
+    Assets,   // Textures, fonts and sounds
+    Memory,
+    Count
+};
+
+/**
+ * @brief One message as stored in a thread's ring buffer.
+ */
+struct LogRecord {
+    int64_t timeNs;
+    LogLevel level;
+    LogCategory category;
+    uint16_t length;
+    char text[LOG_MESSAGE_BYTES];
+};
+
+/**
+ * @brief Asynchronous logger: formatting happens on the calling thread, output on a
+ * background thread.
+ *
+ * Every thread that logs gets its own ring buffer of LOG_RING_CAPACITY records, with a
+ * single producer (the thread) and a single consumer (the drain thread), so logging
+ * takes no lock and never waits: when the ring is full the message is dropped and
+ * counted, and the drain thread reports the count. The drain thread wakes every
+ * LOG_DRAIN_INTERVAL_MS, merges the rings by timestamp and writes them to stderr or
+ * to the file given to openFile(), with one flush per wake-up.
+ *
+ * Use the LOG_* macros rather than LogLine directly: they skip disabled messages
+ * without evaluating the streamed arguments.
+ */
+class Logger {
+public:
+    static Logger& instance();
+
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    /**
+     * @brief True if messages of this level and category are written.
+     */
+    bool enabled(LogLevel level, LogCategory category) const {
+        return static_cast<int>(level) >= minLevel_.load(std::memory_order_relaxed) &&
+               (categoryMask_.load(std::memory_order_relaxed) & (1u << static_cast<unsigned>(category))) != 0;
+    }
+
+    /**
+     * @brief Skips messages below this level (Info by default).
+     */
+    void setMinLevel(LogLevel level);
+
+    /**
+     * @brief Mutes or unmutes a category (all enabled by default).
+     */
+    void setCategoryEnabled(LogCategory category, bool enabled);
+
+    /**
+     * @brief Writes the messages to a file instead of stderr.
+     * @param path Output file path (truncated).
+     * @return True if the file was opened; stderr is kept otherwise.
+     */
+    bool openFile(const std::string& path);
+
+    /**
+     * @brief Blocks until every message logged before the call has been written.
+     * For shutdown and tools, not for the game loop.
+     */
+    void flush();
+
+    /**
+     * @brief Messages dropped so far because a thread's ring was full.
+     */
+    uint64_t droppedCount() const;
+
+private:
+    friend class LogLine;
+    struct ThreadBuffer;
+
+    Logger();
+
+    ThreadBuffer& threadBuffer();
+    LogRecord* reserve();
+    void publish();
+    void run();
+    void drain();
+
+    mutable std::mutex registryMutex_;
+    std::vector<std::shared_ptr<ThreadBuffer>> registry_;
+
+    std::atomic<int> minLevel_ {static_cast<int>(LogLevel::Info)};
+    std::atomic<uint32_t> categoryMask_ {~0u};
+
+    // Drain thread state
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable drained_;
+    uint64_t flushRequests_ {0};  // Guarded by mutex_
+    uint64_t flushesDone_ {0};
+    bool stopping_ {false};
+
+    std::mutex sinkMutex_;        // Taken by openFile() and by the drain thread while writing
+    std::FILE* sink_ {stderr};
+    bool ownsSink_ {false};
+
+    // Drain thread only
+    std::vector<const LogRecord*> pending_;
+    std::string out_;
+
+    std::thread thread_;
+};
+
+/**
+ * @brief Formats one message straight into a slot of the calling thread's ring, which is
+ * published when the line is destroyed (at the end of the LOG_* statement).
+ * Text beyond LOG_MESSAGE_BYTES is cut. A message logged while another is being built on
+ * the same thread (from a streamed function call) is dropped.
+ */
+class LogLine {
+public:
+    LogLine(LogLevel level, LogCategory category, uint32_t suppressed = 0);
+    ~LogLine();
+
+    LogLine(const LogLine&) = delete;
+    LogLine& operator=(const LogLine&) = delete;
+
+    LogLine& operator<<(const char* text);
+    LogLine& operator<<(const std::string& text) { append(text.data(), text.size()); return *this; }
+    LogLine& operator<<(char c) { append(&c, 1); return *this; }
+    LogLine& operator<<(bool value) { return *this << (value ? "true" : "false"); }
+    LogLine& operator<<(int value) { return appendSigned(value); }
+    LogLine& operator<<(long value) { return appendSigned(value); }
+    LogLine& operator<<(long long value) { return appendSigned(value); }
+    LogLine& operator<<(unsigned int value) { return appendUnsigned(value); }
+    LogLine& operator<<(unsigned long value) { return appendUnsigned(value); }
+    LogLine& operator<<(unsigned long long value) { return appendUnsigned(value); }
+    LogLine& operator<<(float value) { return appendFloat(value); }
+    LogLine& operator<<(double value) { return appendFloat(value); }
+
+private:
+    void append(const char* text, std::size_t length);
+    LogLine& appendSigned(long long value);
+    LogLine& appendUnsigned(unsigned long long value);
+    LogLine& appendFloat(double value);
+
+    LogRecord* record_;     // Slot reserved in the thread's ring, nullptr if the message is dropped
+    uint32_t suppressed_;   // Messages the rate limiter skipped before this one
+};
+
+/**
+ * @brief Lets a message through at most once per period, counting the ones it skips.
+ * Safe to share between threads.
+ */
+class LogRateLimiter {
+public:
+    explicit LogRateLimiter(float periodSeconds)
+        : periodNs_(static_cast<int64_t>(periodSeconds * 1e9f)) {}
+
+    /**
+     * @brief True if the period since the last allowed message has elapsed.
+     */
+    bool allow();
+
+    /**
+     * @brief Number of messages skipped since the last call, reset to zero.
+     */
+    uint32_t takeSuppressed() { return suppressed_.exchange(0, std::memory_order_relaxed); }
+
+private:
+    int64_t periodNs_;
+    std::atomic<int64_t> nextAllowedNs_ {0};
+    std::atomic<uint32_t> suppressed_ {0};
+};
+
+#define LOG_AT(level, category) \
+    if (!Logger::instance().enabled(level, category)) {} else LogLine(level, category)
+#define LOG_DEBUG(category) LOG_AT(LogLevel::Debug, category)
+#define LOG_INFO(category) LOG_AT(LogLevel::Info, category)
+#define LOG_WARNING(category) LOG_AT(LogLevel::Warning, category)
+#define LOG_ERROR(category) LOG_AT(LogLevel::Error, category)
+// At most one message per period from this statement; the next one says how many were skipped
+#define LOG_RATE_LIMITED(periodSeconds, level, category) \
+    if (static LogRateLimiter logRateLimiter_(periodSeconds); \
+        !Logger::instance().enabled(level, category) || !logRateLimiter_.allow()) {} \
+    else LogLine(level, category, logRateLimiter_.takeSuppressed())
+
+#endif // LOGGER_HPP
@@ -0,0 +1,87 @@
+#ifndef MEMORY_TRACKER_HPP
+#define MEMORY_TRACKER_HPP
+
+#include <box2d/box2d.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+/**
+ * @brief Subsystems whose allocations are accounted separately.
+ */
+enum class MemorySubsystem {
+    Box2D,      // Everything Box2D allocates through b2SetAllocator
+    LevelArena, // Blocks reserved by the per-level arenas
+    TimeRewind, // History buffer of the time rewind
+    Count
+};
+
+/**
+ * @brief Counts the bytes, peak usage and allocations of each memory subsystem.
+ *
+ * Box2D is routed through a tracked allocator once installBox2DAllocator() is called
+ * (before the first world is created). Game-side level data goes through LevelArena,
+ * which reports the blocks it reserves here. Counters are atomic because Box2D may
+ * allocate from its worker threads.
+ */
+class MemoryTracker {
+public:
+    /**
+     * @brief Snapshot of the counters of one subsystem.
+     */
+    struct Stats {
+        int64_t bytes {0};       // Currently allocated
+        int64_t peakBytes {0};   // Highest value of bytes so far
+        uint64_t allocations {0};
+        uint64_t frees {0};
+    };
+
+    /**
+     * @brief Returns the process-wide tracker.
+     */
+    static MemoryTracker& instance();
+
+    /**
+     * @brief Routes every Box2D allocation through the tracker (b2SetAllocator).
+     * Must be called before any Box2D world is created.
+     */
+    static void installBox2DAllocator();
+
+    void recordAllocation(MemorySubsystem subsystem, std::size_t bytes);
+    void recordFree(MemorySubsystem subsystem, std::size_t bytes);
+
+    /**
+     * @brief Returns the current counters of a subsystem.
+     */
+    Stats stats(MemorySubsystem subsystem) const;
+
+    /**
+     * @brief Restarts peak tracking of a subsystem from its current usage.
+     */
+    void resetPeak(MemorySubsystem subsystem);
+
+    /**
+     * @brief Prints the counters of every subsystem.
+     * If a valid world is given, its detailed breakdown is also written by
+     * b2World_DumpMemoryStats (to box2d_memory.txt in the working directory).
+     * @param out The stream to print to.
+     * @param worldId The world to dump, or b2_nullWorldId.
+     */
+    void report(std::ostream& out, b2WorldId worldId = b2_nullWorldId) const;
+
+private:
+    MemoryTracker() = default;
+
+    struct Counters {
+        std::atomic<int64_t> bytes {0};
+        std::atomic<int64_t> peakBytes {0};
+        std::atomic<uint64_t> allocations {0};
+        std::atomic<uint64_t> frees {0};
+    };
+
+    std::array<Counters, static_cast<std::size_t>(MemorySubsystem::Count)> counters_;
+};
+
+#endif // MEMORY_TRACKER_HPP
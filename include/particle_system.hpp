@@ -0,0 +1,154 @@
+#ifndef PARTICLE_SYSTEM_HPP
+#define PARTICLE_SYSTEM_HPP
+
+#include <SFML/Graphics.hpp>
+#include <box2d/box2d.h>
+#include "constants.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Number of vertices written per particle: two triangles, sf::PrimitiveType::Triangles.
+ */
+const std::size_t PARTICLE_VERTICES_PER_QUAD = 6;
+
+/**
+ * @brief The pools of the game. Each pool has one texture and is drawn as one vertex batch.
+ */
+enum class ParticlePool : uint8_t {
+    Dust, // Untextured squares, part of the world: stop while time is frozen or rewound
+    Glow, // Soft discs of the time freeze effect itself: keep moving while time is frozen
+    Count
+};
+
+/**
+ * @brief Effects gameplay can trigger.
+ */
+enum class ParticleEffect : uint8_t {
+    FreezeBurst,    // Ring around the player when the time freeze starts
+    Landing,        // Dust under the player's feet
+    TremplinBounce, // Sparks where a tremplin throws an object
+    Impact,         // Debris of a hit between objects, scaled by the approach speed
+    Count
+};
+
+/**
+ * @brief The particles of one pool as they are drawn: one call, one texture (or none).
+ */
+struct ParticleBatch {
+    const sf::Texture* texture {nullptr};
+    std::vector<sf::Vertex> vertices; // Triangles, world pixels
+};
+
+/**
+ * @brief Short-lived visual particles in fixed-capacity pools.
+ *
+ * Each pool stores its particles as a structure of arrays (position, velocity, age,
+ * lifetime, size, color) allocated once at its capacity. update() integrates a pool
+ * in one pass, four particles per iteration with SSE2 when available (scalar code
+ * elsewhere): pool gravity and drag on the velocity, the velocity on the position,
+ * the age. Dead particles are then removed by moving the last live one in their
+ * slot, so live particles stay packed at the front. Positions are in meters, Box2D frame.
+ *
+ * Emission never allocates: when a pool holds its live limit (its capacity, lowered
+ * by setParticleCap) new particles are dropped and counted. Emitters are described
+ * per effect (pool, count, speed, spread, lifetime, size, color) and fired by gameplay
+ * with a position, a direction and a strength.
+ *
+ * writeBatches() turns every pool into a textured quad batch, fading particles out
+ * over their lifetime, so drawing all particles costs one draw call per pool.
+ */
+class ParticleSystem {
+public:
+    /**
+     * @param capacity Particles each pool can hold.
+     */
+    explicit ParticleSystem(std::size_t capacity);
+
+    /**
+     * @brief Creates the Glow texture (a soft disc). Needs an active OpenGL context.
+     * @return False if the texture could not be created (the pool is then drawn untextured).
+     */
+    bool loadTextures();
+
+    /**
+     * @brief Fires an effect.
+     * @param effect The effect.
+     * @param position Where, in meters.
+     * @param direction Main direction of the particles (need not be normalized; ignored by full-circle effects).
+     * @param strength Scales the particle count and speed (1: as the effect describes them).
+     */
+    void emit(ParticleEffect effect, b2Vec2 position, b2Vec2 direction, float strength = 1.0f);
+
+    /**
+     * @brief Advances every pool.
+     * @param dt Time step in seconds.
+     * @param worldPaused True while time is frozen or rewound: the Dust pool does not move then.
+     */
+    void update(float dt, bool worldPaused);
+
+    /**
+     * @brief Limits the live particles of each pool (the quality governor's particle cap).
+     * Live particles above the limit are kept until they die; emission waits for room.
+     */
+    void setParticleCap(std::size_t cap) { cap_ = cap; }
+
+    /**
+     * @brief Replaces the batches with the quads of every pool, one batch per pool.
+     */
+    void writeBatches(std::vector<ParticleBatch>& batches) const;
+
+    /**
+     * @brief Removes every particle (level change).
+     */
+    void clear();
+
+    std::size_t liveCount() const;
+    uint64_t droppedCount() const { return dropped_; }
+
+private:
+    struct Pool {
+        std::vector<float> positionX;
+        std::vector<float> positionY;
+        std::vector<float> velocityX;
+        std::vector<float> velocityY;
+        std::vector<float> age;
+        std::vector<float> lifetime;
+        std::vector<float> halfSize; // Meters
+        std::vector<sf::Color> color;
+        std::size_t count {0};
+        float gravity {0.0f}; // m/s^2, Box2D frame
+        float drag {0.0f};    // Share of the velocity lost per second
+        bool pausedWithWorld {false};
+        const sf::Texture* texture {nullptr};
+    };
+
+    struct Emitter {
+        ParticlePool pool;
+        int count;
+        float spread;   // Half angle around the direction, radians (pi: full circle)
+        float speedMin; // m/s
+        float speedMax;
+        float lifeMin;  // Seconds
+        float lifeMax;
+        float sizeMin;  // Meters
+        float sizeMax;
+        sf::Color color;
+    };
+
+    static void integrate(Pool& pool, float dt);
+    static void removeDead(Pool& pool);
+    float random01();
+
+    std::array<Pool, static_cast<std::size_t>(ParticlePool::Count)> pools_;
+    std::array<Emitter, static_cast<std::size_t>(ParticleEffect::Count)> emitters_;
+    std::size_t capacity_;
+    std::size_t cap_;
+    uint32_t randomState_ {0x9E3779B9u};
+    uint64_t dropped_ {0};
+    sf::Texture glowTexture_;
+};
+
+#endif // PARTICLE_SYSTEM_HPP
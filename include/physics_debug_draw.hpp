@@ -0,0 +1,109 @@
+#ifndef PHYSICS_DEBUG_DRAW_HPP
+#define PHYSICS_DEBUG_DRAW_HPP
+
+#include <SFML/Graphics.hpp>
+#include <box2d/box2d.h>
+#include "constants.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief What the physics debug view can show. Each is toggled on its own.
+ */
+enum class DebugDrawCategory : uint8_t {
+    Shapes,   // Body shapes, colored by body state (Box2D's colors)
+    Bounds,   // Fat AABBs of the broad-phase
+    Joints,   // Joint anchors and links
+    Contacts, // Contact points and normals
+    Count
+};
+
+/**
+ * @brief One frame of physics debug geometry, in world pixels: three batches, one draw call each.
+ */
+struct PhysicsDebugBatch {
+    sf::VertexArray fills {sf::PrimitiveType::Triangles};  // Translucent shape interiors
+    sf::VertexArray lines {sf::PrimitiveType::Lines};      // Outlines, bounds, joints, normals
+    sf::VertexArray points {sf::PrimitiveType::Triangles}; // Contact points, as small squares
+
+    /**
+     * @brief Empties the batches. Their storage is kept for the next frame.
+     */
+    void clear() {
+        fills.clear();
+        lines.clear();
+        points.clear();
+    }
+
+    std::size_t vertexCount() const { return fills.getVertexCount() + lines.getVertexCount() + points.getVertexCount(); }
+};
+
+/**
+ * @brief Box2D debug draw backend that accumulates b2World_Draw into vertex batches.
+ *
+ * Box2D reports every shape, bound, joint and contact through one callback each.
+ * Instead of drawing them one by one, the callbacks append triangles and lines to a
+ * PhysicsDebugBatch, so a frame is three draw calls however many shapes it shows.
+ * Circles and capsules are tessellated with a precomputed table of
+ * DEBUG_DRAW_CIRCLE_SEGMENTS directions; rounded polygons are drawn without their
+ * rounding.
+ *
+ * Drawing is limited to the camera view: drawingBounds is set to the view's rectangle,
+ * so b2World_Draw only visits the shapes the broad-phase finds there (and the joints
+ * and contacts of their bodies), which keeps large levels cheap.
+ *
+ * capture() reads the world: call it on the simulation thread, between steps. The
+ * batch can then be drawn on the render thread.
+ */
+class PhysicsDebugDraw {
+public:
+    PhysicsDebugDraw();
+
+    PhysicsDebugDraw(const PhysicsDebugDraw&) = delete;
+    PhysicsDebugDraw& operator=(const PhysicsDebugDraw&) = delete;
+
+    void setEnabled(DebugDrawCategory category, bool enabled);
+    bool enabled(DebugDrawCategory category) const { return (enabled_ & bit(category)) != 0; }
+    bool anyEnabled() const { return enabled_ != 0; }
+
+    /**
+     * @brief Switches a category on or off.
+     * @return True if it is now on.
+     */
+    bool toggle(DebugDrawCategory category);
+
+    /**
+     * @brief Replaces the batch with the enabled categories of the world, inside the view.
+     * @param worldId The world to draw.
+     * @param view The camera view (world pixels).
+     * @param batch Filled with the geometry (previous content is replaced).
+     */
+    void capture(b2WorldId worldId, const sf::View& view, PhysicsDebugBatch& batch);
+
+private:
+    static uint32_t bit(DebugDrawCategory category) { return 1u << static_cast<unsigned>(category); }
+
+    static void drawPolygon(const b2Vec2* vertices, int vertexCount, b2HexColor color, void* context);
+    static void drawSolidPolygon(b2Transform transform, const b2Vec2* vertices, int vertexCount, float radius,
+                                 b2HexColor color, void* context);
+    static void drawCircle(b2Vec2 center, float radius, b2HexColor color, void* context);
+    static void drawSolidCircle(b2Transform transform, float radius, b2HexColor color, void* context);
+    static void drawSolidCapsule(b2Vec2 p1, b2Vec2 p2, float radius, b2HexColor color, void* context);
+    static void drawSegment(b2Vec2 p1, b2Vec2 p2, b2HexColor color, void* context);
+    static void drawTransform(b2Transform transform, void* context);
+    static void drawPoint(b2Vec2 p, float size, b2HexColor color, void* context);
+
+    void appendPolygon(const b2Vec2* vertices, int vertexCount, b2HexColor color, bool solid);
+    void appendCircle(b2Vec2 center, b2Vec2 axis, float radius, b2HexColor color, bool solid);
+    void appendLine(sf::Vector2f a, sf::Vector2f b, sf::Color color);
+
+    b2DebugDraw draw_;
+    PhysicsDebugBatch* batch_ {nullptr};          // Set during capture()
+    std::array<b2Vec2, DEBUG_DRAW_CIRCLE_SEGMENTS> circle_; // Unit directions, counter-clockwise
+    std::vector<b2Vec2> outline_;                 // Scratch for circles and capsules
+    uint32_t enabled_ {0};                        // One bit per DebugDrawCategory
+};
+
+#endif // PHYSICS_DEBUG_DRAW_HPP
@@ -0,0 +1,109 @@
+#ifndef PHYSICS_LOD_HPP
+#define PHYSICS_LOD_HPP
+
+#include <box2d/box2d.h>
+#include "constants.hpp"
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @brief Physics level-of-detail: steps far-away regions of the world less often.
+ *
+ * Dynamic bodies are grouped into regions (bodies linked by joints or touching contacts,
+ * which Box2D must simulate together). Each region gets a tier from its distance to the
+ * focus point (usually the player):
+ * - Full: within PHYSICS_LOD_FULL_RADIUS_M, stepped every frame as usual.
+ * - Reduced: within PHYSICS_LOD_REDUCED_RADIUS_M, kept asleep and woken once every
+ *   PHYSICS_LOD_REDUCED_RATE frames for a single step covering the skipped frames
+ *   (velocities scaled by the rate, gravity by its square).
+ * - Dormant: farther away, kept asleep with its velocities saved until it comes back
+ *   into range.
+ *
+ * Sleeping islands cost Box2D almost nothing, so the step time depends on the number
+ * of bodies near the focus point rather than on the size of the level.
+ * Box2D clears the velocities of bodies it wakes up, so they are saved and restored here.
+ *
+ * Bodies rescaled by someone else (TimeDilationZones) must not be managed, or the saved
+ * state restored here would overwrite their scaling: exclude() keeps a body's whole
+ * region at full rate until include().
+ */
+class PhysicsLod {
+public:
+    enum class Tier { Full, Reduced, Dormant };
+
+    /**
+     * @brief Updates the regions and wakes the reduced-rate regions due this frame.
+     * Call right before b2World_Step.
+     * @param bodies The bodies managed by the LOD (non-dynamic or invalid ids are ignored).
+     * @param focus_m The point around which the world is simulated at full rate, in meters.
+     */
+    void beforeStep(const std::vector<b2BodyId>& bodies, b2Vec2 focus_m);
+
+    /**
+     * @brief Puts the reduced-rate regions stepped this frame back to sleep.
+     * Call right after b2World_Step.
+     */
+    void afterStep();
+
+    /**
+     * @brief Wakes every managed body and restores its velocities (e.g. before a time freeze).
+     */
+    void wakeAll();
+
+    /**
+     * @brief Keeps a body and its region at full rate. If the body was managed, it gets its saved
+     * velocities and gravity back now, before the caller changes them.
+     */
+    void exclude(b2BodyId bodyId);
+
+    /**
+     * @brief Lets an excluded body be managed again, from the next rebuild of the regions.
+     */
+    void include(b2BodyId bodyId);
+
+    /**
+     * @brief Forgets every managed and excluded body without touching the world. Call when the world is destroyed.
+     */
+    void clear();
+
+    /**
+     * @brief Number of regions currently in the given tier (as of the last rebuild).
+     */
+    std::size_t regionCount(Tier tier) const;
+
+private:
+    /**
+     * @brief State of a body put to sleep by the LOD.
+     */
+    struct ManagedBody {
+        b2BodyId bodyId;
+        b2Vec2 linearVelocity;
+        float angularVelocity;
+        float gravityScale;
+        float linearDamping;
+        float angularDamping;
+    };
+
+    struct Region {
+        std::vector<uint64_t> bodies; // Stored b2BodyIds
+        Tier tier {Tier::Full};
+        int phase {0};                // Frame slot (modulo the reduced rate) at which a reduced region steps
+    };
+
+    void rebuildRegions(const std::vector<b2BodyId>& bodies, b2Vec2 focus_m);
+    bool hasExcluded(const Region& region) const;
+    bool putToSleep(const Region& region);
+    void wake(uint64_t bodyKey, float velocityScale);
+    void release(uint64_t bodyKey);
+
+    std::vector<Region> regions_;
+    std::unordered_map<uint64_t, ManagedBody> managed_; // Bodies kept asleep by the LOD
+    std::vector<std::size_t> stepping_;                 // Reduced regions woken for the current step
+    std::unordered_set<uint64_t> excluded_;             // Bodies whose region stays at full rate
+    uint64_t frame_ {0};
+    int framesUntilRebuild_ {0};
+};
+
+#endif // PHYSICS_LOD_HPP
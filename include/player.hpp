@@ -4,9 +4,11 @@
 #include <SFML/Graphics.hpp>
 #include <box2d/box2d.h>
 #include <vector>
+#include "level_arena.hpp" // For ArenaAllocator
 
-// Forward declaration
+// Forward declarations
 class GameObject;
+using GameObjectList = std::vector<GameObject, ArenaAllocator<GameObject>>;
 
 /**
  * @brief Handles all player movement mechanics including jumping and horizontal movement.
@@ -22,14 +24,35 @@ class GameObject;
  * @param playerGameObject A reference to the player's GameObject for animation control
  * @param allGameObjects A constant reference to the vector of all GameObjects in the scene (for ground check)
  * @param jumpKeyHeld Whether the jump key is currently held
+ * @param jumpKeyPressed Whether the jump key was pressed since the previous step, even if released since
+ * @param jumpPressAge Seconds between that press and this step; the jump buffer counts from the press
  * @param leftKeyHeld Whether the left movement key is currently held
  * @param rightKeyHeld Whether the right movement key is currently held
  * @param dt Delta time since the last frame in seconds
+ * @return True if the player touched the ground this step after being in the air.
  */
-void movePlayer(b2WorldId worldId, b2BodyId playerBodyId, GameObject& playerGameObject,
-                const std::vector<GameObject>& allGameObjects,
-                bool jumpKeyHeld, bool leftKeyHeld, bool rightKeyHeld, float dt);
+bool movePlayer(b2WorldId worldId, b2BodyId playerBodyId, GameObject& playerGameObject,
+                const GameObjectList& allGameObjects,
+                bool jumpKeyHeld, bool jumpKeyPressed, float jumpPressAge,
+                bool leftKeyHeld, bool rightKeyHeld, float dt);
+
+/**
+ * @brief Vertical velocity given to the player by a jump, in m/s.
+ */
+float playerJumpVelocity();
+
+/**
+ * @brief Gravity scale movePlayer applies in the air while the jump key is held.
+ * @param verticalVelocity The player's vertical velocity in m/s (falling is faster than rising).
+ */
+float playerAirGravityScale(float verticalVelocity);
 
 void initializeSounds();
 
+/**
+ * @brief Loads the player's animation frames (idle, walk, jump, fall) and starts idle, facing right.
+ * @param playerGameObject The player's GameObject.
+ */
+void loadPlayerAnimations(GameObject& playerGameObject);
+
 #endif // PLAYER_HPP
@@ -0,0 +1,48 @@
+#ifndef PREFAB_HPP
+#define PREFAB_HPP
+
+#include <box2d/box2d.h>
+#include "game_object.hpp" // Includes utils.hpp and constants.hpp
+#include <vector>
+
+/**
+ * @brief A GameObject archetype prepared once and stamped into the world many times.
+ *
+ * Building an object through the setters and finalize() redoes the same work for
+ * every instance: the SFML shape, the texture lookup and sprite setup, the body and
+ * shape definitions and the polygons. A Prefab does all of it once, from an
+ * archetype configured with the usual setters (its position is ignored), and
+ * spawn() only copies the prepared object, creates the body at the requested
+ * position and attaches the precomputed shapes.
+ *
+ * Instances are identical to what finalize() would have produced for the same
+ * properties, so loaders and spawners can share one prefab per kind of object.
+ */
+class Prefab {
+public:
+    /**
+     * @param archetype The object to stamp, configured but not finalized.
+     */
+    explicit Prefab(const GameObject& archetype);
+
+    /**
+     * @brief Creates one instance centered at (x_m, y_m) and appends it to gameObjects.
+     * @return The new body, or b2_nullBodyId if Box2D could not create it.
+     */
+    b2BodyId spawn(b2WorldId worldId, GameObjectList& gameObjects, float x_m, float y_m) const;
+
+    /**
+     * @brief The prepared object every instance is copied from.
+     */
+    const GameObject& archetype() const { return archetype_; }
+
+private:
+    GameObject archetype_;
+    b2BodyDef bodyDef_;
+    b2ShapeDef shapeDef_;
+    b2Polygon box_;
+    std::vector<b2ShapeDef> partDefs_;
+    std::vector<b2Polygon> partBoxes_;
+};
+
+#endif // PREFAB_HPP
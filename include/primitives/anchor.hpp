@@ -0,0 +1,36 @@
+#ifndef PRIMITIVES_ANCHOR_HPP
+#define PRIMITIVES_ANCHOR_HPP
+
+#include "../game_object.hpp"
+#include "../prefab.hpp"
+#include <SFML/Graphics.hpp>
+
+/**
+ * @brief The invisible static point ropes hang from, prepared once for every level.
+ * Default collision: CATEGORY_WORLD, MASK_PLAYER | CATEGORY_WORLD. Not jumpable, not player.
+ */
+inline const Prefab& anchorPrefab() {
+    static const Prefab prefab = [] {
+        GameObject anchorObj;
+        anchorObj.setSize(pixelsToMeters(1), pixelsToMeters(1)); // Small, effectively invisible
+        anchorObj.setDynamic(false);
+        anchorObj.setColor(sf::Color::Transparent); // Invisible
+        return Prefab(anchorObj);
+    }();
+    return prefab;
+}
+
+/**
+ * @brief Creates a rope anchor.
+ *
+ * @param worldId The Box2D world ID.
+ * @param gameObjects Reference to the vector storing all game objects.
+ * @param x_m Center x-position of the anchor in meters.
+ * @param y_m Center y-position of the anchor in meters.
+ * @return The anchor's body, or b2_nullBodyId on failure.
+ */
+inline b2BodyId createAnchor(b2WorldId worldId, GameObjectList& gameObjects, float x_m, float y_m) {
+    return anchorPrefab().spawn(worldId, gameObjects, x_m, y_m);
+}
+
+#endif // PRIMITIVES_ANCHOR_HPP
@@ -8,7 +8,7 @@
 
 inline b2BodyId createBalance(
     b2WorldId worldId,
-    std::vector<GameObject>& gameObjects,
+    GameObjectList& gameObjects,
     float x_m, float y_m, float width_m, float height_m,
     bool isDynamic, sf::Color color,
     bool fixedRotation = false, float linearDamping = 0.0f,
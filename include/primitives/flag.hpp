@@ -2,9 +2,9 @@
 #define PRIMITIVES_FLAG_HPP
 
 #include "../game_object.hpp"
+#include "../logger.hpp"
 #include <vector>
 #include <SFML/Graphics.hpp>
-#include <iostream>
 
 /**
  * @brief Creates a flag GameObject and adds it to the game.
@@ -18,7 +18,7 @@
  */
 inline b2BodyId createFlag(
     b2WorldId worldId,
-    std::vector<GameObject>& gameObjects,
+    GameObjectList& gameObjects,
     float x_m, float y_m) {
 
     GameObject flagObj;
@@ -49,7 +49,7 @@ inline b2BodyId createFlag(
 
         return actualFlagInVector.bodyId; // Return the bodyId of the object in the vector
     }
-    std::cerr << "Failed to create flag object." << std::endl;
+    LOG_ERROR(LogCategory::Loading) << "Failed to create flag object.";
     return b2_nullBodyId;
 }
 
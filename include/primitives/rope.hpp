@@ -2,10 +2,11 @@
 #define PRIMITIVES_ROPE_HPP
 
 #include "../game_object.hpp" // Access to GameObject, Box2D, SFML, createAnchorBody
+#include "../prefab.hpp"      // Segments are stamped from one prefab
+#include "../logger.hpp"
 #include <vector>
 #include <cmath> // For b2Distance
 #include <SFML/Graphics.hpp> // For sf::Color
-#include <iostream> // For std::cerr
 
 /**
  * @brief Creates a segmented rope connecting two bodies.
@@ -32,7 +33,7 @@
  */
 inline bool createSegmentedRope(
     b2WorldId worldId,
-    std::vector<GameObject>& gameObjects,
+    GameObjectList& gameObjects,
     b2BodyId bodyA, b2Vec2 localAnchorA,
     b2BodyId bodyB, b2Vec2 localAnchorB,
     int numSegments,
@@ -48,7 +49,7 @@ inline bool createSegmentedRope(
     bool segmentsCollideWithPlayer = true) {
 
     if (B2_IS_NULL(bodyA) || B2_IS_NULL(bodyB) || numSegments < 1) {
-        std::cerr << "Error: Invalid parameters for createSegmentedRope." << std::endl;
+        LOG_ERROR(LogCategory::Loading) << "Invalid parameters for createSegmentedRope.";
         return false;
     }
 
@@ -61,7 +62,7 @@ inline bool createSegmentedRope(
         if (numSegments == 1) {
              // Potentially create a single joint, but this function is for *segmented* ropes.
              // For now, let's consider this an edge case that might not be desired.
-            std::cerr << "Warning: Rope total length is near zero." << std::endl;
+            LOG_WARNING(LogCategory::Loading) << "Rope total length is near zero.";
         } else {
             // Multiple segments for a zero length rope is problematic.
             return false;
@@ -74,68 +75,66 @@ inline bool createSegmentedRope(
     b2BodyId prevBodyId = bodyA;
     b2Vec2 prevBodyLocalConnectAnchor = localAnchorA;
 
-    for (int i = 0; i < numSegments; ++i) {
-        GameObject segmentObj; 
-        float segWidth, segHeight;
-        b2Vec2 currentSegmentLocalConnectAnchorToPrev; 
-        b2Vec2 currentSegmentLocalConnectAnchorToNext;
-
-        if (isVerticalOrientation) {
-            segWidth = segmentSecondaryDim;  // thickness
-            segHeight = actualSegmentLength; // length
-            currentSegmentLocalConnectAnchorToPrev = {0.0f, segHeight / 2.0f};    // Top-middle
-            currentSegmentLocalConnectAnchorToNext = {0.0f, -segHeight / 2.0f}; // Bottom-middle
-        } else { // Horizontal orientation
-            segWidth = actualSegmentLength; // length
-            segHeight = segmentSecondaryDim; // thickness
-            currentSegmentLocalConnectAnchorToPrev = {-segWidth / 2.0f, 0.0f};  // Middle-left
-            currentSegmentLocalConnectAnchorToNext = {segWidth / 2.0f, 0.0f}; // Middle-right
-        }
+    // Every segment of the rope is the same: prepare it once and stamp it along the rope
+    float segWidth, segHeight;
+    b2Vec2 currentSegmentLocalConnectAnchorToPrev;
+    b2Vec2 currentSegmentLocalConnectAnchorToNext;
+    if (isVerticalOrientation) {
+        segWidth = segmentSecondaryDim;  // thickness
+        segHeight = actualSegmentLength; // length
+        currentSegmentLocalConnectAnchorToPrev = {0.0f, segHeight / 2.0f};    // Top-middle
+        currentSegmentLocalConnectAnchorToNext = {0.0f, -segHeight / 2.0f}; // Bottom-middle
+    } else { // Horizontal orientation
+        segWidth = actualSegmentLength; // length
+        segHeight = segmentSecondaryDim; // thickness
+        currentSegmentLocalConnectAnchorToPrev = {-segWidth / 2.0f, 0.0f};  // Middle-left
+        currentSegmentLocalConnectAnchorToNext = {segWidth / 2.0f, 0.0f}; // Middle-right
+    }
+
+    GameObject segmentObj;
+    segmentObj.setSize(segWidth, segHeight);
+    segmentObj.setDynamic(true); // Rope segments are always dynamic
+    segmentObj.setColor(color);
+    segmentObj.setFixedRotation(false); // Rope segments should rotate
+    segmentObj.setLinearDamping(segmentLinearDamping);
+    segmentObj.setDensity(segmentDensity);
+    segmentObj.setFriction(segmentFriction);
+    segmentObj.setRestitution(segmentRestitution);
+
+    segmentObj.setIsPlayerProperty(false); // Segments are not the player
+    segmentObj.setCanJumpOnProperty(segmentsCanBeJumpedOn);
+    segmentObj.setCollidesWithPlayerProperty(segmentsCollideWithPlayer);
+    // Note: setIsPlayerProperty(false) and setCollidesWithPlayerProperty() will set appropriate
+    // categoryBits_ and maskBits_ by default. If more specific filtering is needed for rope segments,
+    // segmentObj.setCollisionFilterData(CATEGORY_ROPE_SEGMENT, MASK_ROPE_SEGMENT) could be used.
+    const Prefab segmentPrefab(segmentObj);
 
+    for (int i = 0; i < numSegments; ++i) {
         // Initial position for segment (interpolated along the straight line between worldPosA and worldPosB)
         float t = (i + 0.5f) / numSegments;
         b2Vec2 segmentCenterPos = {
             worldPosA.x + t * (worldPosB.x - worldPosA.x),
             worldPosA.y + t * (worldPosB.y - worldPosA.y)
         };
-        
-        segmentObj.setPosition(segmentCenterPos.x, segmentCenterPos.y);
-        segmentObj.setSize(segWidth, segHeight);
-        segmentObj.setDynamic(true); // Rope segments are always dynamic
-        segmentObj.setColor(color);
-        segmentObj.setFixedRotation(false); // Rope segments should rotate
-        segmentObj.setLinearDamping(segmentLinearDamping);
-        segmentObj.setDensity(segmentDensity);
-        segmentObj.setFriction(segmentFriction);
-        segmentObj.setRestitution(segmentRestitution);
-        
-        segmentObj.setIsPlayerProperty(false); // Segments are not the player
-        segmentObj.setCanJumpOnProperty(segmentsCanBeJumpedOn);
-        segmentObj.setCollidesWithPlayerProperty(segmentsCollideWithPlayer);
-        // Note: setIsPlayerProperty(false) and setCollidesWithPlayerProperty() will set appropriate
-        // categoryBits_ and maskBits_ by default. If more specific filtering is needed for rope segments,
-        // segmentObj.setCollisionFilterData(CATEGORY_ROPE_SEGMENT, MASK_ROPE_SEGMENT) could be used.
-
-        if (segmentObj.finalize(worldId)) {
-            gameObjects.push_back(segmentObj);
-            b2BodyId currentSegmentBodyId = segmentObj.bodyId;
-
-            b2RevoluteJointDef revoluteDef = b2DefaultRevoluteJointDef();
-            revoluteDef.bodyIdA = prevBodyId;
-            revoluteDef.bodyIdB = currentSegmentBodyId;
-            revoluteDef.localAnchorA = prevBodyLocalConnectAnchor;
-            revoluteDef.localAnchorB = currentSegmentLocalConnectAnchorToPrev;
-            revoluteDef.collideConnected = false; // Segments of the same rope should not collide
-            b2CreateRevoluteJoint(worldId, &revoluteDef);
-
-            prevBodyId = currentSegmentBodyId;
-            prevBodyLocalConnectAnchor = currentSegmentLocalConnectAnchorToNext;
-        } else {
-            std::cerr << "Failed to create rope segment " << i << std::endl;
+
+        b2BodyId currentSegmentBodyId = segmentPrefab.spawn(worldId, gameObjects, segmentCenterPos.x, segmentCenterPos.y);
+        if (B2_IS_NULL(currentSegmentBodyId)) {
+            LOG_ERROR(LogCategory::Loading) << "Failed to create rope segment " << i;
             // Consider cleanup of already created segments if this happens mid-rope.
             // For simplicity, we'll just return false.
             return false; 
         }
+
+        b2RevoluteJointDef revoluteDef = b2DefaultRevoluteJointDef();
+        revoluteDef.bodyIdA = prevBodyId;
+        revoluteDef.bodyIdB = currentSegmentBodyId;
+        revoluteDef.localAnchorA = prevBodyLocalConnectAnchor;
+        revoluteDef.localAnchorB = currentSegmentLocalConnectAnchorToPrev;
+        revoluteDef.collideConnected = false; // Segments of the same rope should not collide
+        b2CreateRevoluteJoint(worldId, &revoluteDef);
+
+        prevBodyId = currentSegmentBodyId;
+        prevBodyLocalConnectAnchor = currentSegmentLocalConnectAnchorToNext;
     }
 
     // Connect the last rope segment to bodyB
@@ -0,0 +1,59 @@
+#ifndef PRIMITIVES_TIME_ZONE_HPP
+#define PRIMITIVES_TIME_ZONE_HPP
+
+#include "../game_object.hpp"
+#include "../logger.hpp"
+#include "../time_dilation.hpp"
+#include <SFML/Graphics.hpp>
+
+/**
+ * @brief Creates a time-dilation zone and the translucent rectangle that shows it.
+ * The rectangle is a static sensor: it collides with nothing and only marks the zone.
+ * Its tint tells the effect: blue freezes, purple slows down, orange speeds up.
+ *
+ * @param worldId The Box2D world ID.
+ * @param gameObjects Reference to the vector storing all game objects.
+ * @param zones The zones of the level.
+ * @param x_m Center x-position of the zone in meters.
+ * @param y_m Center y-position of the zone in meters.
+ * @param width_m Width of the zone in meters.
+ * @param height_m Height of the zone in meters.
+ * @param timeScale Rate of time inside the zone (0 freezes).
+ * @return The zone's id in zones.
+ */
+inline int createTimeDilationZone(
+    b2WorldId worldId,
+    GameObjectList& gameObjects,
+    TimeDilationZones& zones,
+    float x_m, float y_m,
+    float width_m, float height_m,
+    float timeScale) {
+
+    GameObject zoneObj;
+    zoneObj.setPosition(x_m, y_m);
+    zoneObj.setSize(width_m, height_m);
+    zoneObj.setDynamic(false);
+    if (timeScale <= 0.0f) {
+        zoneObj.setColor(sf::Color(100, 150, 255, 60)); // Same blue as the time freeze overlay
+    } else if (timeScale < 1.0f) {
+        zoneObj.setColor(sf::Color(170, 90, 255, 60));
+    } else {
+        zoneObj.setColor(sf::Color(255, 160, 40, 60));
+    }
+    zoneObj.setIsSensorProperty(true);
+    zoneObj.setFriction(0.0f);
+    zoneObj.setRestitution(0.0f);
+
+    if (zoneObj.finalize(worldId)) {
+        gameObjects.push_back(zoneObj);
+    } else {
+        LOG_ERROR(LogCategory::Loading) << "Failed to create time zone visual.";
+    }
+
+    b2AABB area;
+    area.lowerBound = {x_m - width_m / 2.0f, y_m - height_m / 2.0f};
+    area.upperBound = {x_m + width_m / 2.0f, y_m + height_m / 2.0f};
+    return zones.add(area, timeScale);
+}
+
+#endif // PRIMITIVES_TIME_ZONE_HPP
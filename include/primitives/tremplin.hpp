@@ -2,101 +2,77 @@
 #define TREMPLIN_HPP
 
 #include "../game_object.hpp"
+#include "../logger.hpp"
 #include <vector>
 #include <SFML/Graphics.hpp>
-#include <iostream>
 
 
 /**
- * @brief Creates a segmented rope connecting two bodies.
+ * @brief Creates a tremplin (springboard): one body with three shapes.
+ *
+ * The main shape is the solid frame, slightly wider and lower than the board; the
+ * player cannot jump from it. A bouncy board part (restitution 0.45) is the surface
+ * the player lands and jumps on, and a sensor part with the tremplin category tells
+ * the "tremplin bounce" handler which objects to throw up. The three shapes share
+ * the body, so a dynamic tremplin stays in one piece and is drawn once, as its sprite.
  *
  * @param worldId The Box2D world ID.
- * @param gameObjects Reference to the vector storing all game objects (rope segments will be added here).
- * @param bodyA The first body to attach the rope to.
- * @param localAnchorA Local attachment point on bodyA.
- * @param bodyB The second body to attach the rope to.
- * @param localAnchorB Local attachment point on bodyB.
- * @param numSegments Number of segments in the rope (must be >= 1).
- * @param segmentPrimaryDim Length of each segment along the rope's primary axis.
- * @param segmentSecondaryDim Thickness of each segment.
- * @param isVerticalOrientation True if segments are primarily vertical (primaryDim=height, secondaryDim=width),
- *                              False if segments are primarily horizontal (primaryDim=width, secondaryDim=height).
- * @param color Color of the rope segments.
- * @param segmentLinearDamping Linear damping for segments (default: 0.2f).
- * @param segmentDensity Density for segments (default: 0.05f).
- * @param segmentFriction Friction for segments (default: 0.5f).
- * @param segmentRestitution Restitution for segments (default: 0.1f).
- * @param segmentsCanBeJumpedOn Can player jump on these rope segments? (default: false)
- * @param segmentsCollideWithPlayer Should player collide with these rope segments? (default: true)
- * @return True if the rope was created successfully, false otherwise.
+ * @param gameObjects Reference to the vector storing all game objects.
+ * @param is_dynamic Whether the tremplin can be pushed around.
+ * @param x_m Center x-position of the tremplin in meters.
+ * @param y_m Center y-position of the tremplin in meters.
  */
 inline void createTremplin(
     b2WorldId worldId,
-    std::vector<GameObject>& gameObjects,
+    GameObjectList& gameObjects,
     bool is_dynamic,
     float x_m, float y_m) {
 
     GameObject tremplinObj;
-    GameObject tremplinObj2;
-    GameObject tremplinSensor;
 
     // Tremplin dimensions (140x50 pixels)
     float tremplinWidthM = pixelsToMeters(140.0f);
     float tremplinHeightM = pixelsToMeters(50.0f);
 
+    // Frame: the main shape
     tremplinObj.setPosition(x_m, y_m);
     tremplinObj.setSize(tremplinWidthM+pixelsToMeters(14), tremplinHeightM-pixelsToMeters(6));
     tremplinObj.setDynamic(is_dynamic);
     tremplinObj.setColor(sf::Color::Transparent); // Fallback color if sprite fails
-    
+    tremplinObj.setSpriteTexturePath("../assets/sprite/objects/tremplin-1.png"); // Path to tremplin image
     tremplinObj.setCanJumpOnProperty(false);
     tremplinObj.setCollidesWithPlayerProperty(true);
-    //tremplinObj.setIsTremplinProperty(true);
-    //tremplinObj.setIsSensorProperty(true); // Make the tremplin a sensor
-    //tremplinObj.setEnableSensorEventsProperty(true); // Enable sensor events for the tremplin
-
-    // Default physics properties for a static sensor-like object
+    tremplinObj.setIsTremplinProperty(true); // Identifies the object in the bounce handler
+    // The frame itself is plain world geometry; the tremplin category is carried by the sensor part
+    tremplinObj.setCollisionFilterData(CATEGORY_WORLD, CATEGORY_PLAYER | CATEGORY_WORLD | CATEGORY_TREMPLIN);
     tremplinObj.setFriction(0.7f);
     tremplinObj.setRestitution(0.1f);
-    
-    // Collision properties are handled by setIstremplinProperty and setIsPlayerProperty
-
-    tremplinObj2.setPosition(x_m, y_m);
-    tremplinObj2.setSize(tremplinWidthM, tremplinHeightM);
-    tremplinObj2.setDynamic(is_dynamic);
-    tremplinObj2.setCanJumpOnProperty(true);
-    tremplinObj2.setCollidesWithPlayerProperty(true);
-    tremplinObj2.setColor(sf::Color::Transparent);
-    tremplinObj2.setFriction(0.0f);
-    tremplinObj2.setRestitution(0.45f);
-
-
-
-    tremplinSensor.setPosition(x_m , y_m);
-    tremplinSensor.setSize(tremplinWidthM, tremplinHeightM);
-    tremplinSensor.setDynamic(is_dynamic);
-    tremplinSensor.setCanJumpOnProperty(false);
-
-    tremplinSensor.setSpriteTexturePath("../assets/sprite/objects/tremplin-1.png"); // Path to tremplin image
-    tremplinSensor.setIsTremplinProperty(true);
-    tremplinSensor.setIsSensorProperty(true);
-    tremplinSensor.setEnableSensorEventsProperty(true);
-
 
+    // Board: where the player lands and bounces
+    GameObject::ShapePart board;
+    board.width_m = tremplinWidthM;
+    board.height_m = tremplinHeightM;
+    board.friction = 0.0f;
+    board.restitution = 0.45f;
+    board.canJumpOn = true;
+    tremplinObj.addShapePart(board);
+
+    // Sensor: objects entering it get thrown up
+    GameObject::ShapePart sensor;
+    sensor.width_m = tremplinWidthM;
+    sensor.height_m = tremplinHeightM;
+    sensor.categoryBits = CATEGORY_TREMPLIN;
+    sensor.maskBits = CATEGORY_PLAYER | CATEGORY_WORLD;
+    sensor.isSensor = true;
+    sensor.enableSensorEvents = true;
+    tremplinObj.addShapePart(sensor);
 
     if (tremplinObj.finalize(worldId)) {
         gameObjects.push_back(tremplinObj);
+    } else {
+        LOG_ERROR(LogCategory::Loading) << "Failed to create tremplin.";
     }
-
-    if (tremplinObj2.finalize(worldId)) {
-        gameObjects.push_back(tremplinObj2);
-    }
-
-    if (tremplinSensor.finalize(worldId)) {
-        gameObjects.push_back(tremplinSensor);
-    }
-
-}  
+}
 
 
 #endif // TREMPLIN_HPP
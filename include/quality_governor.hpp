@@ -0,0 +1,70 @@
+#ifndef QUALITY_GOVERNOR_HPP
+#define QUALITY_GOVERNOR_HPP
+
+#include "constants.hpp"
+#include "frame_pacer.hpp" // For LatencySamples
+#include <cstdint>
+
+/**
+ * @brief The quality knobs the governor trades for frame time. The defaults are the best quality.
+ */
+struct QualitySettings {
+    int physicsSubSteps {QUALITY_MAX_SUBSTEPS};  // Box2D sub-steps per step
+    float offscreenScale {1.0f};                 // Resolution of the offscreen frozen world, relative to the window
+    int parallaxLayers {2};                      // 0: plain sky, 1: background, 2: background and clouds
+    int particleCap {QUALITY_MAX_PARTICLES};     // Live particles allowed
+    bool debugOverlays {true};                   // Debug overlays may be drawn (when switched on)
+};
+
+/**
+ * @brief Holds the frame time under QUALITY_FRAME_BUDGET_MS by adjusting QualitySettings.
+ *
+ * The cost of a frame is the longer of the simulation thread's work (waits excluded)
+ * and the render thread's draw, since the two overlap. Every QUALITY_WINDOW_FRAMES
+ * frames the governor takes the 90th percentile of the window:
+ * - above the budget, it lowers one knob by one notch, in this order: debug overlays
+ *   (only while one is shown, otherwise turning them off saves nothing), particle cap,
+ *   parallax layers, offscreen resolution, physics sub-steps;
+ * - under QUALITY_UPGRADE_RATIO of the budget for QUALITY_UPGRADE_WINDOWS windows in a row,
+ *   it raises one notch back, in reverse order;
+ * - otherwise it keeps the settings.
+ * A change is followed by a window without decision so its effect can be measured.
+ * Every decision is logged with the percentile that caused it.
+ */
+class QualityGovernor {
+public:
+    /**
+     * @brief Records the cost of a frame, and decides at the end of a window.
+     * @param simulationMs Work of the simulation thread, in milliseconds.
+     * @param drawMs Draw time of the render thread, in milliseconds.
+     * @param debugOverlaysShown True if a debug overlay was switched on for this frame.
+     * @return True if the settings changed.
+     */
+    bool addFrame(float simulationMs, float drawMs, bool debugOverlaysShown);
+
+    /**
+     * @brief Allows debug overlays again: the user just switched one on, which wins over the budget.
+     */
+    void restoreDebugOverlays();
+
+    const QualitySettings& settings() const { return settings_; }
+
+    /**
+     * @brief Number of decisions (lowered or raised) taken so far.
+     */
+    uint64_t changes() const { return changes_; }
+
+private:
+    bool lower(float p90Ms);
+    bool raise(float p90Ms);
+
+    QualitySettings settings_;
+    LatencySamples window_;
+    int framesInWindow_ {0};
+    bool settling_ {false}; // The window after a change is not judged
+    int cheapWindows_ {0};  // Consecutive windows under the upgrade threshold
+    bool debugOverlaysShown_ {false};
+    uint64_t changes_ {0};
+};
+
+#endif // QUALITY_GOVERNOR_HPP
@@ -0,0 +1,74 @@
+#ifndef RENDER_STATS_HPP
+#define RENDER_STATS_HPP
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Counts the draw calls and vertices submitted during the current frame.
+ *
+ * SFML does not expose these numbers, so every draw of the game goes through the
+ * countedDraw() helpers below, which record the call and forward it to the target.
+ * Draws into offscreen textures (static tiles, frozen snapshot) are counted as well.
+ * Counters are atomic: with the render thread, offscreen layers are drawn by the
+ * simulation thread and the window by the render thread.
+ */
+class RenderStats {
+public:
+    /**
+     * @brief Returns the process-wide counters.
+     */
+    static RenderStats& instance();
+
+    /**
+     * @brief Resets the per-frame counters. Call at the start of every frame.
+     */
+    void beginFrame() {
+        drawCalls_.store(0, std::memory_order_relaxed);
+        vertices_.store(0, std::memory_order_relaxed);
+    }
+
+    void recordDraw(std::size_t vertexCount) {
+        drawCalls_.fetch_add(1, std::memory_order_relaxed);
+        vertices_.fetch_add(vertexCount, std::memory_order_relaxed);
+    }
+
+    uint64_t drawCalls() const { return drawCalls_.load(std::memory_order_relaxed); }
+    uint64_t vertices() const { return vertices_.load(std::memory_order_relaxed); }
+
+private:
+    RenderStats() = default;
+
+    std::atomic<uint64_t> drawCalls_ {0};
+    std::atomic<uint64_t> vertices_ {0};
+};
+
+/**
+ * @brief Draws a shape and records its fill (triangle fan) and outline (triangle strip).
+ */
+void countedDraw(sf::RenderTarget& target, const sf::Shape& shape, const sf::RenderStates& states = sf::RenderStates::Default);
+
+/**
+ * @brief Draws a sprite (one quad) and records it.
+ */
+void countedDraw(sf::RenderTarget& target, const sf::Sprite& sprite, const sf::RenderStates& states = sf::RenderStates::Default);
+
+/**
+ * @brief Draws a text and records it (one quad per character).
+ */
+void countedDraw(sf::RenderTarget& target, const sf::Text& text, const sf::RenderStates& states = sf::RenderStates::Default);
+
+/**
+ * @brief Draws a batch of vertices (one draw call) and records it.
+ */
+void countedDraw(sf::RenderTarget& target, const sf::Vertex* vertices, std::size_t vertexCount, sf::PrimitiveType type,
+                 const sf::RenderStates& states = sf::RenderStates::Default);
+
+/**
+ * @brief Draws a vertex array (one draw call) and records it. Empty arrays are not drawn.
+ */
+void countedDraw(sf::RenderTarget& target, const sf::VertexArray& vertices, const sf::RenderStates& states = sf::RenderStates::Default);
+
+#endif // RENDER_STATS_HPP
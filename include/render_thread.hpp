@@ -0,0 +1,93 @@
+#ifndef RENDER_THREAD_HPP
+#define RENDER_THREAD_HPP
+
+#include <SFML/Graphics.hpp>
+#include "scene_renderer.hpp"
+#include "frame_pacer.hpp"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Draws and presents frames on a dedicated thread, from double-buffered snapshots.
+ *
+ * The simulation thread fills the back snapshot with SceneRenderer::capture() and
+ * submits it; the render thread draws it to the window and calls display(), which
+ * blocks on vsync or the frame rate limit. Meanwhile the simulation thread already
+ * steps physics and updates the scene for the next frame.
+ *
+ * Before capturing, the simulation thread calls waitUntilDrawn(): cached layers
+ * (static tiles, frozen world) are shared textures that capture() may re-render,
+ * so the previous frame must have been drawn, but it may still be presenting.
+ * The same wait is required before clearing those caches (level change).
+ *
+ * When display() returns, the frame counts as presented: the time since the oldest key
+ * press it reflects (SceneSnapshot::timing) is recorded as an input-to-photon sample,
+ * and the FramePacer, if any, is told the frame's cost. With vsync the swap may still
+ * be queued at that point; under a software GL context it is done.
+ *
+ * The window's OpenGL context belongs to the render thread while it runs. Events
+ * must still be polled on the thread that created the window, and stop() must be
+ * called before closing it.
+ */
+class RenderThread {
+public:
+    RenderThread(sf::RenderWindow& window, SceneRenderer& renderer, FramePacer* pacer = nullptr);
+    ~RenderThread();
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    /**
+     * @brief The snapshot to fill for the next frame. Only valid after waitUntilDrawn().
+     */
+    SceneSnapshot& backSnapshot() { return snapshots_[back_]; }
+
+    /**
+     * @brief Blocks until every submitted frame has been drawn (presenting may still run).
+     */
+    void waitUntilDrawn();
+
+    /**
+     * @brief Hands the back snapshot to the render thread and swaps the buffers.
+     */
+    void submit();
+
+    /**
+     * @brief Finishes the frame in flight, stops the thread and gives the window's
+     * context back to the calling thread. Called by the destructor; safe to call twice.
+     */
+    void stop();
+
+    /**
+     * @brief Input-to-photon latencies recorded since the previous call, in milliseconds.
+     */
+    LatencySamples takeInputToPhoton();
+
+    /**
+     * @brief Time the render thread spent drawing the last frame (display() excluded), in milliseconds.
+     */
+    float lastDrawMs() const { return static_cast<float>(lastDrawNs_.load(std::memory_order_relaxed)) * 1e-6f; }
+
+private:
+    void run();
+
+    sf::RenderWindow& window_;
+    SceneRenderer& renderer_;
+    FramePacer* pacer_;
+    std::array<SceneSnapshot, 2> snapshots_;
+    int back_ {0};
+
+    std::mutex mutex_;
+    std::condition_variable wake_;  // Signals the render thread: frame submitted or stop requested
+    std::condition_variable drawn_; // Signals the simulation thread: submitted frame drawn
+    int pendingFront_ {-1};         // Snapshot submitted and not drawn yet, or -1
+    bool stopping_ {false};
+    LatencySamples inputToPhoton_;  // Guarded by mutex_
+    std::atomic<int64_t> lastDrawNs_ {0};
+    std::thread thread_;
+};
+
+#endif // RENDER_THREAD_HPP
@@ -0,0 +1,84 @@
+#ifndef SCENE_COMPOSITOR_HPP
+#define SCENE_COMPOSITOR_HPP
+
+#include <SFML/Graphics.hpp>
+#include "constants.hpp"
+#include <array>
+
+/**
+ * @brief Draws the parallax background in one fullscreen pass and grades the rest of the
+ * frame (time freeze tint, transition fade) inside the draws instead of overlays.
+ *
+ * The background pass is a single window-sized quad whose fragment shader samples every
+ * parallax layer (up to PARALLAX_MAX_LAYERS) at its own scroll offset and blends them
+ * over the sky color, so more layers cost texture reads but no extra pass. The offsets
+ * (camera position times the layer's factor, plus drift) are uniforms.
+ *
+ * The freeze tint and the fade used to be alpha-blended window-sized rectangles. Both are
+ * linear in the color they cover, so applying them to each draw before blending gives
+ * the same image: the world is drawn with states() carrying the tint and the fade, the
+ * player, trajectories and HUD (above the tint) with the fade only.
+ *
+ * Shaders may be unavailable: available() is then false and the renderer keeps drawing
+ * textured rectangles and overlays.
+ */
+class SceneCompositor {
+public:
+    /**
+     * @brief A background layer: a repeated texture scrolling at a fraction of the camera speed.
+     */
+    struct Layer {
+        const sf::Texture* texture {nullptr};
+        float parallaxFactor {0.0f}; // Texture pixels scrolled per camera pixel
+        float driftFactor {0.0f};    // Share of SceneFrame::cloudDriftOffset applied
+    };
+
+    /**
+     * @brief Compiles the shaders. Needs an active OpenGL context.
+     * @return False if shaders are unavailable or failed to compile.
+     */
+    bool load();
+
+    bool available() const { return available_; }
+
+    /**
+     * @brief Sets the layers, back to front. Extra layers beyond PARALLAX_MAX_LAYERS are ignored.
+     */
+    void setLayers(const std::array<Layer, PARALLAX_MAX_LAYERS>& layers, int layerCount);
+
+    /**
+     * @brief Fills the target with the sky and the parallax layers, tinted and faded. Replaces clear().
+     * @param target The window or render texture; its view is left at the default view.
+     * @param view The camera view.
+     * @param cloudDriftOffset Drift of the drifting layers, in texture pixels.
+     * @param layerCount Number of layers drawn (the quality governor may drop the front ones).
+     */
+    void drawBackground(sf::RenderTarget& target, const sf::View& view, float cloudDriftOffset, int layerCount);
+
+    /**
+     * @brief Sets the grading of the next draws.
+     * @param tint Freeze tint color; its alpha is the tint strength (0 for none).
+     * @param fade Fade to black, 0 (none) to 1 (black).
+     */
+    void setGrade(sf::Color tint, float fade);
+
+    /**
+     * @brief Render states applying the current grade.
+     * @param textured True for sprites and text, false for shapes and vertex batches without texture.
+     */
+    const sf::RenderStates& states(bool textured) const { return textured ? texturedStates_ : colorStates_; }
+
+private:
+    sf::Shader backgroundShader_;
+    sf::Shader texturedShader_;
+    sf::Shader colorShader_;
+    sf::RenderStates texturedStates_;
+    sf::RenderStates colorStates_;
+    std::array<Layer, PARALLAX_MAX_LAYERS> layers_ {};
+    int layerCount_ {0};
+    sf::Glsl::Vec4 tint_ {0.0f, 0.0f, 0.0f, 0.0f};
+    float fade_ {0.0f};
+    bool available_ {false};
+};
+
+#endif // SCENE_COMPOSITOR_HPP
@@ -0,0 +1,155 @@
+#ifndef SCENE_RENDERER_HPP
+#define SCENE_RENDERER_HPP
+
+#include <SFML/Graphics.hpp>
+#include "game_object.hpp" // Includes utils.hpp and constants.hpp
+#include "static_layer_cache.hpp"
+#include "frozen_scene_cache.hpp"
+#include "transform_batch.hpp"
+#include "frame_pacer.hpp"
+#include "physics_debug_draw.hpp"
+#include "particle_system.hpp"
+#include "scene_compositor.hpp"
+#include <cstddef>
+#include <optional>
+#include <variant>
+#include <vector>
+
+/**
+ * @brief Per-frame inputs of the renderer that come from gameplay state.
+ */
+struct SceneFrame {
+    sf::View view;                       // Camera view (world pixels)
+    float cloudDriftOffset {0.0f};       // Cloud texture drift, in pixels (paused during a freeze)
+    bool worldFrozen {false};            // Time freeze applied: the world comes from the frozen snapshot
+    float timeFreezeOverlayAlpha {0.0f}; // 0 - 255
+    float transitionAlpha {0.0f};        // 0 - 255, black fade between levels
+    bool showInstructions {false};       // Controls reminder at the bottom of the screen (level 1)
+    int parallaxLayers {2};              // 0: plain sky, 1: background, 2: background and clouds
+};
+
+/**
+ * @brief A copy of one object's visual, as GameObject::draw would draw it.
+ */
+using SceneDrawable = std::variant<sf::RectangleShape, sf::Sprite>;
+
+/**
+ * @brief Everything needed to draw one frame, copied out of the scene.
+ *
+ * A snapshot does not reference any GameObject, so it can be drawn while the
+ * simulation already modifies the scene for the next frame. The layer sprites
+ * reference the static tiles or the frozen world texture, which only change when
+ * the next snapshot is captured. Snapshots are reused from frame to frame: their
+ * vectors keep their capacity and their drawables are assigned in place.
+ */
+struct SceneSnapshot {
+    SceneFrame frame;
+    std::vector<sf::Sprite> layer;      // Static tiles, or the frozen world, drawn first
+    std::vector<sf::Vertex> quads;      // Plain dynamic rectangles (GameObject::drawnAsQuad), one draw call
+    std::vector<SceneDrawable> world;   // Other objects except the player, in draw order (first worldCount used)
+    std::size_t worldCount {0};
+    std::optional<SceneDrawable> player; // Drawn above the time freeze overlay
+    std::vector<sf::Vertex> trajectories; // Predicted paths while frozen (TrajectoryPreview), lines above the overlay
+    std::vector<ParticleBatch> particles; // One batch per particle pool (ParticleSystem), above the world
+    PhysicsDebugBatch physicsDebug;     // Box2D debug view (PhysicsDebugDraw), above the player
+    FrameTiming timing;                 // Set by the game loop, read once the frame is presented
+
+    void clear() {
+        layer.clear();
+        quads.clear();
+        trajectories.clear();
+        for (ParticleBatch& batch : particles) {
+            batch.vertices.clear();
+        }
+        physicsDebug.clear();
+        worldCount = 0;
+        player.reset();
+    }
+
+    template <typename Drawable>
+    void addWorld(const Drawable& drawable) {
+        if (worldCount < world.size()) {
+            world[worldCount] = drawable;
+        } else {
+            world.emplace_back(drawable);
+        }
+        ++worldCount;
+    }
+};
+
+/**
+ * @brief Draws a complete frame of the game: parallax background, world, overlays, player, HUD.
+ *
+ * Rendering is split in two steps so it can run on its own thread. capture() copies
+ * the scene into a SceneSnapshot; it runs on the simulation thread because it reads
+ * GameObjects and updates the cached layers (StaticLayerCache, FrozenSceneCache).
+ * draw() only reads the snapshot and can run on any thread owning the target.
+ * render() does both in sequence. Every draw goes through countedDraw() so
+ * RenderStats holds the draw calls and vertices of the frame.
+ *
+ * Plain dynamic rectangles are not copied as shapes: their quads are computed from
+ * the body transforms by a TransformBatch and drawn in one call, right after the
+ * static layer and before the other objects.
+ *
+ * When shaders are available, the background, time freeze tint and transition fade go
+ * through a SceneCompositor: one fullscreen pass for the parallax layers, and the tint
+ * and fade applied inside the other draws instead of window-sized overlays.
+ */
+class SceneRenderer {
+public:
+    SceneRenderer(StaticLayerCache& staticLayer, FrozenSceneCache& frozenScene);
+
+    /**
+     * @brief Loads the background and cloud textures and the HUD font.
+     * A missing font is only reported (text is then not drawn properly).
+     * @return False if a texture could not be loaded.
+     */
+    bool loadAssets();
+
+    /**
+     * @brief Copies the visuals of the scene into a snapshot.
+     * The previous snapshot must have been drawn already: the cached layers it
+     * references may be re-rendered here.
+     * @param snapshot The snapshot to fill (previous content is replaced).
+     * @param frame The per-frame gameplay inputs.
+     * @param gameObjects The vector of all GameObjects in the scene.
+     * @param playerIndex Index of the player in gameObjects, or -1.
+     */
+    void capture(SceneSnapshot& snapshot, const SceneFrame& frame, const GameObjectList& gameObjects, int playerIndex);
+
+    /**
+     * @brief Draws a captured frame. The target's view is left at its default view.
+     * @param target The window or render texture to draw on.
+     * @param snapshot The frame to draw.
+     */
+    void draw(sf::RenderTarget& target, const SceneSnapshot& snapshot);
+
+    /**
+     * @brief Captures and draws one frame on the calling thread.
+     */
+    void render(sf::RenderTarget& target, const SceneFrame& frame, const GameObjectList& gameObjects, int playerIndex);
+
+private:
+    void drawComposited(sf::RenderTarget& target, const SceneSnapshot& snapshot);
+    void drawParallax(sf::RenderTarget& target, const SceneFrame& frame);
+    void drawWorld(sf::RenderTarget& target, const sf::View& view, const GameObjectList& gameObjects, int playerIndex);
+    void batchQuads(const GameObjectList& gameObjects, std::vector<sf::Vertex>& vertices);
+
+    StaticLayerCache& staticLayer_;
+    FrozenSceneCache& frozenScene_;
+    SceneSnapshot scratch_; // Used by render()
+    TransformBatch quadBatch_;
+    std::vector<sf::Vertex> frozenQuads_; // Quads of the frozen world snapshot
+
+    sf::Texture backgroundTexture_;
+    sf::Texture cloudTexture_;
+    sf::RectangleShape backgroundShape_;
+    sf::RectangleShape cloudShape_;
+    sf::RectangleShape timeFreezeOverlay_;
+    sf::RectangleShape transitionOverlay_;
+    SceneCompositor compositor_;
+    sf::Font font_;
+    sf::Text instructionText_;
+};
+
+#endif // SCENE_RENDERER_HPP
@@ -0,0 +1,116 @@
+#ifndef STATIC_LAYER_CACHE_HPP
+#define STATIC_LAYER_CACHE_HPP
+
+#include <SFML/Graphics.hpp>
+#include <box2d/box2d.h>
+#include "game_object.hpp" // Includes utils.hpp and constants.hpp
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Caches the visuals of static GameObjects into tiled render textures.
+ *
+ * Static scenery (ground, walls, anchors, flags...) never moves, so instead of
+ * redrawing every rectangle each frame it is rasterized once into square tiles of
+ * STATIC_TILE_SIZE_PX pixels. Each frame only the tiles intersecting the camera view
+ * are drawn, so the cost of static scenery no longer depends on how many objects a
+ * map defines. A tile is re-rendered only after it has been invalidated.
+ */
+class StaticLayerCache {
+public:
+    /**
+     * @brief Indexes static GameObjects that were appended since the last call.
+     * Cheap when nothing was added, so it can be called every frame. New objects
+     * mark the tiles they overlap as dirty.
+     * @param gameObjects The vector of all GameObjects in the scene.
+     */
+    void sync(GameObjectList& gameObjects);
+
+    /**
+     * @brief Re-indexes the whole scene after objects were removed or reordered.
+     * Objects that disappeared are dropped from their tiles (which are re-rendered,
+     * or released once empty) and objects that appeared are added.
+     * @param gameObjects The vector of all GameObjects in the scene.
+     */
+    void resync(GameObjectList& gameObjects);
+
+    /**
+     * @brief Checks whether a GameObject is drawn through the cache.
+     * Cached objects must be skipped by the regular per-object update and draw passes.
+     * @param obj The GameObject to test.
+     * @return True if the object's visual lives in the static layer.
+     */
+    bool isCached(const GameObject& obj) const;
+
+    /**
+     * @brief Marks every tile overlapping the given object as dirty.
+     * Call this after changing the visual of a cached object (e.g. setColor).
+     * @param obj The cached GameObject that changed.
+     */
+    void invalidate(const GameObject& obj);
+
+    /**
+     * @brief Marks every tile overlapping a world-space pixel rectangle as dirty.
+     * @param worldRectPx The rectangle in SFML world coordinates (pixels).
+     */
+    void invalidate(const sf::FloatRect& worldRectPx);
+
+    /**
+     * @brief Draws the tiles visible through the given view, re-rendering dirty ones first.
+     * @param target The render target to draw on (its current view must be `view`).
+     * @param view The camera view used to select visible tiles.
+     * @param gameObjects The vector of all GameObjects, used to re-render dirty tiles.
+     */
+    void draw(sf::RenderTarget& target, const sf::View& view, const GameObjectList& gameObjects);
+
+    /**
+     * @brief Re-renders the dirty tiles visible through the view and appends one sprite per
+     * visible tile, for drawing later (possibly on another thread). The sprites reference the
+     * tile textures: they stay valid until the next sync, resync, invalidate or clear.
+     * @param view The camera view used to select visible tiles.
+     * @param gameObjects The vector of all GameObjects, used to re-render dirty tiles.
+     * @param sprites Receives the tile sprites, in draw order.
+     */
+    void collectVisibleTiles(const sf::View& view, const GameObjectList& gameObjects, std::vector<sf::Sprite>& sprites);
+
+    /**
+     * @brief Drops every tile and indexed object. Call when the level is torn down.
+     */
+    void clear();
+
+    /**
+     * @brief Number of tiles currently holding at least one static object.
+     */
+    std::size_t tileCount() const { return tiles_.size(); }
+
+private:
+    using TileKey = std::pair<int, int>; // Tile column and row in world pixel space
+
+    struct Tile {
+        std::unique_ptr<sf::RenderTexture> texture; // Allocated the first time the tile is visible
+        std::unordered_set<uint64_t> bodies;        // Stored b2BodyIds of the objects overlapping this tile
+        bool dirty {true};
+    };
+
+    struct TileRange {
+        int minX {0}, maxX {-1}, minY {0}, maxY {-1}; // Empty range for invisible objects
+    };
+
+    static sf::FloatRect visualBounds(const GameObject& obj);
+    static bool hasVisibleContent(const GameObject& obj);
+    static bool isCacheable(const GameObject& obj);
+    void add(GameObject& obj);
+    void remove(uint64_t bodyKey, const TileRange& range);
+    void renderTile(const TileKey& key, Tile& tile, const GameObjectList& gameObjects);
+
+    std::map<TileKey, Tile> tiles_;
+    std::unordered_map<uint64_t, TileRange> cachedBodies_; // Stored b2BodyId -> tiles it covers
+    std::size_t indexedCount_ {0}; // Number of gameObjects already scanned by sync()
+};
+
+#endif // STATIC_LAYER_CACHE_HPP
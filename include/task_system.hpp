@@ -0,0 +1,70 @@
+#ifndef TASK_SYSTEM_HPP
+#define TASK_SYSTEM_HPP
+
+#include <box2d/box2d.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Thread pool running Box2D's parallel tasks (b2WorldDef::enqueueTask / finishTask).
+ *
+ * With N workers, N - 1 threads are started and the thread calling b2World_Step is the
+ * last worker: it runs queued work while it waits in finishTask. Box2D's solver needs
+ * all N workers running at the same time, which this guarantees. Each task range
+ * executed is recorded as a "Box2D task" trace zone on the worker's thread.
+ */
+class TaskSystem {
+public:
+    /**
+     * @param workerCount Total number of workers, including the stepping thread (at least 1).
+     */
+    explicit TaskSystem(int workerCount);
+    ~TaskSystem();
+
+    TaskSystem(const TaskSystem&) = delete;
+    TaskSystem& operator=(const TaskSystem&) = delete;
+
+    /**
+     * @brief Makes worlds created from this definition run their tasks on the pool.
+     * Does nothing with a single worker (Box2D then runs everything inline).
+     * The pool must outlive every world created from the definition.
+     */
+    void configure(b2WorldDef& worldDef);
+
+    int workerCount() const { return workerCount_; }
+
+private:
+    struct Task {
+        b2TaskCallback* callback {nullptr};
+        void* context {nullptr};
+        std::atomic<int> pendingJobs {0};
+    };
+
+    struct Job {
+        Task* task;
+        int startIndex;
+        int endIndex;
+    };
+
+    static void* enqueueTask(b2TaskCallback* callback, int itemCount, int minRange, void* taskContext, void* userContext);
+    static void finishTask(void* userTask, void* userContext);
+
+    void workerLoop(uint32_t workerIndex);
+    bool runOneJob(uint32_t workerIndex);
+    void runJob(const Job& job, uint32_t workerIndex);
+
+    int workerCount_;
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable jobAvailable_;
+    std::deque<Job> jobs_;
+    std::vector<std::unique_ptr<Task>> freeTasks_; // Recycled once finishTask returns
+    bool stopping_ {false};
+};
+
+#endif // TASK_SYSTEM_HPP
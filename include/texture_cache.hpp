@@ -0,0 +1,50 @@
+#ifndef TEXTURE_CACHE_HPP
+#define TEXTURE_CACHE_HPP
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @brief Loads each texture file once and shares it between every GameObject using it.
+ *
+ * Textures are owned by the cache for the lifetime of the program, so the returned
+ * pointers stay valid when GameObjects are copied, moved between vectors or destroyed
+ * and re-created (e.g. when a level chunk is streamed out and back in).
+ */
+class TextureCache {
+public:
+    /**
+     * @brief Returns the process-wide texture cache.
+     */
+    static TextureCache& instance();
+
+    /**
+     * @brief Returns the texture loaded from `path`, loading it on first use.
+     * A failed load is remembered so the file is not retried on every request.
+     * @param path Path of the image file.
+     * @return Pointer to the shared texture, or nullptr if the file could not be loaded.
+     */
+    const sf::Texture* get(const std::string& path);
+
+    /**
+     * @brief Number of texture paths requested so far (including failed loads).
+     */
+    std::size_t size() const { return textures_.size(); }
+
+    /**
+     * @brief Enables or disables texture loading. While disabled, get() returns nullptr
+     * without touching the disk or the GPU (headless runs such as the benchmark suite).
+     */
+    void setLoadingEnabled(bool enabled) { loadingEnabled_ = enabled; }
+    bool loadingEnabled() const { return loadingEnabled_; }
+
+private:
+    TextureCache() = default;
+
+    std::unordered_map<std::string, std::unique_ptr<sf::Texture>> textures_; // nullptr marks a failed load
+    bool loadingEnabled_ {true};
+};
+
+#endif // TEXTURE_CACHE_HPP
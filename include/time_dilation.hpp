@@ -0,0 +1,111 @@
+#ifndef TIME_DILATION_HPP
+#define TIME_DILATION_HPP
+
+#include <box2d/box2d.h>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class PhysicsLod;
+
+/**
+ * @brief Areas of the level where time runs at another rate: frozen, slowed down or sped up.
+ *
+ * Each zone is an axis-aligned box with a time scale (0 freezes, 0.5 is half speed,
+ * 2 is double speed). Before each step, update() finds the dynamic bodies inside the
+ * zones with b2World_OverlapAABB and compares them with the bodies it already tracks:
+ * a body entering gets its velocities multiplied by the scale and its gravity scale
+ * by the scale squared (accelerations scale with time twice); a body leaving gets
+ * its own velocities and gravity back. The cost of a step is proportional to the
+ * bodies inside zones, not to the size of the world.
+ *
+ * Zones may overlap: a body inside several of them runs at the product of their
+ * scales. In a frozen zone bodies stop and keep their velocity for when they leave.
+ * Collisions are not rescaled, so a body pushed out of a frozen zone resumes its
+ * saved motion.
+ *
+ * The global time freeze (WorldFreezer) makes bodies static: do not update the zones
+ * while it is applied.
+ *
+ * PhysicsLod also changes velocities and gravity scales, of the bodies it puts to
+ * sleep. Pass it to update() and call update() before PhysicsLod::beforeStep: a body
+ * entering a zone is first excluded from the LOD, which gives it back the state it
+ * saved, and only then scaled by the zone. Its region stays at full rate while it is
+ * tracked, and the LOD may manage it again once it has left and got its normal time back.
+ */
+class TimeDilationZones {
+public:
+    /**
+     * @brief Adds a zone.
+     * @param area The zone, in meters.
+     * @param timeScale Rate of time inside the zone (0 freezes, must not be negative).
+     * @return The zone's id, for remove() and setTimeScale().
+     */
+    int add(const b2AABB& area, float timeScale);
+
+    /**
+     * @brief Removes a zone. Its bodies get their normal time back at the next update().
+     */
+    void remove(int zoneId);
+
+    /**
+     * @brief Changes the time scale of a zone, applied at the next update().
+     */
+    void setTimeScale(int zoneId, float timeScale);
+
+    /**
+     * @brief Tracks bodies entering and leaving the zones and rescales them. Call before each step.
+     * @param worldId The world to query.
+     * @param excludedBodyId A body never affected (the player), or b2_nullBodyId.
+     * @param lod The level of detail of the world, kept off the tracked bodies, or nullptr if the world runs without one.
+     */
+    void update(b2WorldId worldId, b2BodyId excludedBodyId, PhysicsLod* lod);
+
+    /**
+     * @brief Forgets every zone and body without touching them (the world is being destroyed).
+     */
+    void clear();
+
+    std::size_t zoneCount() const { return zones_.size(); }
+
+    /**
+     * @brief Number of bodies currently inside at least one zone.
+     */
+    std::size_t trackedCount() const { return tracked_.size(); }
+
+private:
+    struct Zone {
+        int id;
+        b2AABB area;
+        float timeScale;
+    };
+
+    struct TrackedBody {
+        b2BodyId bodyId;
+        float timeScale {1.0f};       // Scale currently applied to the body
+        float targetScale {1.0f};     // Product of the zones found during this update
+        float originalGravityScale {1.0f};
+        b2Vec2 savedLinearVelocity {0.0f, 0.0f}; // Unscaled velocities, kept while frozen
+        float savedAngularVelocity {0.0f};
+        uint32_t seenStamp {0};       // Last update() that found the body
+        int lastZone {-1};            // Last zone that counted it (a body may have several shapes)
+        bool entering {false};        // Found by the query, not set up yet
+    };
+
+    struct QueryContext {
+        TimeDilationZones* zones;
+        b2BodyId excludedBodyId;
+        int zoneIndex;
+    };
+
+    static bool collectBody(b2ShapeId shapeId, void* context);
+    void retime(TrackedBody& body, float timeScale);
+
+    std::vector<Zone> zones_;
+    std::unordered_map<uint64_t, TrackedBody> tracked_; // Keyed by b2StoreBodyId
+    uint32_t stamp_ {0};
+    int nextZoneId_ {0};
+};
+
+#endif // TIME_DILATION_HPP
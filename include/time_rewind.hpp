@@ -0,0 +1,126 @@
+#ifndef TIME_REWIND_HPP
+#define TIME_REWIND_HPP
+
+#include <box2d/box2d.h>
+#include "constants.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Memory and length limits of the rewind history.
+ */
+struct TimeRewindConfig {
+    float historySeconds {REWIND_HISTORY_SECONDS}; // Longest history kept, in simulated seconds
+    std::size_t budgetBytes {REWIND_BUDGET_BYTES}; // Encoded history size; the oldest steps are dropped beyond it
+};
+
+/**
+ * @brief Records every physics step so the world can be played backwards.
+ *
+ * After each b2World_Step, record() reads the world's move events, so only bodies
+ * that moved are visited (sleeping and static bodies cost nothing). Each body keeps
+ * its last recorded state, quantized: position (1/4096 m) and angle (1/65536 turn),
+ * plus its displacement over the previous recorded step, which stands for the
+ * velocity. A step is stored as the change of that displacement per body (second
+ * order delta), zigzag varint encoded: a falling or sliding body costs a few bytes.
+ *
+ * Steps live in a ring buffer; when the history is longer than the configured
+ * duration or the encoded size exceeds the budget, the oldest steps are dropped.
+ * stepBack() undoes the newest step: positions and displacements are restored
+ * exactly (up to the quantization) and each body gets the velocity of its restored
+ * displacement. Bodies created during the undone steps keep the state they were
+ * created with; destroyed bodies are skipped.
+ *
+ * The history refers to bodies by id: clear() it whenever the world is destroyed.
+ */
+class TimeRewind {
+public:
+    explicit TimeRewind(const TimeRewindConfig& config = TimeRewindConfig());
+    ~TimeRewind();
+
+    TimeRewind(const TimeRewind&) = delete;
+    TimeRewind& operator=(const TimeRewind&) = delete;
+
+    /**
+     * @brief Records the step b2World_Step just performed. Call once after every step.
+     * @param worldId The world that was stepped.
+     */
+    void record(b2WorldId worldId);
+
+    /**
+     * @brief Undoes the newest recorded step. The world must not be stepped in between.
+     * @return False if there is no history left.
+     */
+    bool stepBack();
+
+    /**
+     * @brief Forgets the history and every body (the buffer is kept).
+     */
+    void clear();
+
+    bool canRewind() const { return stepCount_ > 0; }
+
+    /**
+     * @brief Number of recorded steps that can be undone.
+     */
+    std::size_t stepCount() const { return stepCount_; }
+
+    /**
+     * @brief Duration of the history, in simulated seconds.
+     */
+    float historySeconds() const { return static_cast<float>(stepCount_) * UPDATE_DELTA; }
+
+    /**
+     * @brief Encoded size of the history.
+     */
+    std::size_t historyBytes() const { return usedBytes_; }
+
+private:
+    struct State {
+        int32_t x {0};
+        int32_t y {0};
+        uint16_t angle {0};
+        int32_t dx {0};     // Displacement over the last recorded step
+        int32_t dy {0};
+        int16_t dAngle {0};
+    };
+
+    struct Slot {
+        b2BodyId bodyId;
+        State state;
+        bool born {false}; // False until the body's first record (or after it was undone)
+    };
+
+    struct SlotRef {
+        uint16_t generation {0};
+        uint32_t slot {0}; // Slot index + 1, 0 when unused
+    };
+
+    struct StepInfo {
+        std::size_t start; // Offset in the ring buffer
+        std::size_t size;
+    };
+
+    uint32_t slotFor(b2BodyId bodyId);
+    void pushStep();
+    void dropOldestStep();
+    void applyState(const Slot& slot) const;
+
+    TimeRewindConfig config_;
+    std::size_t maxSteps_;
+
+    std::vector<Slot> slots_;       // Every body seen since clear(), never reused
+    std::vector<SlotRef> slotRefs_; // Indexed by the body's index in the world
+
+    std::unique_ptr<uint8_t[]> buffer_; // Ring of encoded steps, allocated on first use
+    std::size_t bufferSize_ {0};
+    std::size_t usedBytes_ {0};
+    std::vector<StepInfo> steps_;   // Ring of maxSteps_ entries
+    std::size_t firstStep_ {0};
+    std::size_t stepCount_ {0};
+    std::vector<uint8_t> scratch_;  // Step being encoded or decoded
+};
+
+#endif // TIME_REWIND_HPP
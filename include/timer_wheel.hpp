@@ -0,0 +1,121 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Handle of a scheduled timer. Stays safe to cancel after the timer fired or was
+ * cancelled: a slot reused by another timer gets a new generation.
+ */
+struct TimerId {
+    uint32_t index {0};      // Index in the pool + 1: 0 is never a timer
+    uint32_t generation {0};
+
+    bool isNull() const { return index == 0; }
+};
+
+/**
+ * @brief Gameplay timers counted in simulation steps, on a hierarchical timer wheel.
+ *
+ * The wheel has TIMER_WHEEL_LEVELS levels of TIMER_WHEEL_SLOTS slots. A timer goes into
+ * the finest level whose span covers its delay, in the slot of its expiry step: level 0
+ * holds the next 64 steps one per slot, level 1 the next 64 * 64 steps 64 per slot, and
+ * so on. Every step the level 0 slot of the new step fires; each time a level wraps
+ * around, the next slot of the level above is cascaded down. Each timer is therefore
+ * touched once per level it goes through, whatever the number of pending timers.
+ *
+ * Slots are singly linked lists threaded through a pool of small timer records, the
+ * callbacks being stored apart. Scheduling pushes onto a slot's list; cancelling only
+ * flags the record, which is recycled when its slot is next fired or cascaded. Both are
+ * O(1) and touch a single record. Timers expiring on the same step fire in no
+ * particular order.
+ *
+ * The owner calls advance() once per simulation step, so timers follow the simulation
+ * clock: they stop while time is frozen or rewound, and run at the same pace whatever
+ * the frame rate. Callbacks may schedule and cancel timers, including their own.
+ */
+class TimerWheel {
+public:
+    using Callback = std::function<void()>;
+
+    TimerWheel();
+
+    /**
+     * @brief Runs a callback once, `delaySteps` steps from now (at least 1: the next advance()).
+     */
+    TimerId schedule(uint32_t delaySteps, Callback callback);
+
+    /**
+     * @brief Runs a callback every `periodSteps` steps (at least 1), first `periodSteps` from now.
+     */
+    TimerId scheduleRepeating(uint32_t periodSteps, Callback callback);
+
+    /**
+     * @brief Cancels a pending timer.
+     * @return False if the timer already fired (one-shot), was cancelled, or is null.
+     */
+    bool cancel(TimerId id);
+
+    /**
+     * @brief True if the timer will still fire.
+     */
+    bool isPending(TimerId id) const;
+
+    /**
+     * @brief Moves the clock forward one step at a time, firing the timers that expire.
+     */
+    void advance(uint32_t steps = 1);
+
+    /**
+     * @brief Cancels every timer and restarts the clock at 0 (level change).
+     */
+    void clear();
+
+    /**
+     * @brief Steps advanced since construction or the last clear().
+     */
+    uint64_t now() const { return now_; }
+
+    /**
+     * @brief Number of pending timers.
+     */
+    std::size_t pendingCount() const { return pendingCount_; }
+
+private:
+    static const int TIMER_WHEEL_SLOT_BITS = 6;
+    static const uint32_t TIMER_WHEEL_SLOTS = 1u << TIMER_WHEEL_SLOT_BITS;
+    static const int TIMER_WHEEL_LEVELS = 4; // 2^24 steps, about 77 hours at 60 Hz
+    static const uint32_t NO_TIMER = 0xFFFFFFFFu;
+
+    enum class TimerState : uint8_t {
+        Free,      // In free_
+        Pending,   // In a slot, will fire
+        Cancelled  // Still in a slot, recycled when the slot is walked
+    };
+
+    struct alignas(64) Timer { // One cache line per timer, callback included
+        uint64_t expiry {0};
+        uint32_t next {NO_TIMER};  // Next timer of the same slot
+        uint32_t period {0};       // 0 for one-shot timers
+        uint32_t generation {0};
+        TimerState state {TimerState::Free};
+        Callback callback;
+    };
+
+    TimerId add(uint32_t delaySteps, uint32_t period, Callback callback);
+    void insert(uint32_t index);
+    void recycle(uint32_t index);
+    uint32_t takeSlot(int level, uint32_t slot);
+    void tick();
+
+    std::vector<Timer> timers_;
+    std::vector<uint32_t> free_;
+    uint32_t heads_[TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS];
+    uint64_t now_ {0};
+    std::size_t pendingCount_ {0};
+};
+
+#endif // TIMER_WHEEL_HPP
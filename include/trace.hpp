@@ -0,0 +1,90 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Low-overhead recording of timed zones, exported as Chrome trace-event JSON.
+ *
+ * Each thread writes its zones into its own fixed-size ring buffer (TRACE_BUFFER_EVENTS
+ * entries, oldest overwritten first), so recording takes no lock. The export can be
+ * opened in chrome://tracing or https://ui.perfetto.dev to inspect any recent frame.
+ *
+ * The TRACE_* macros compile to nothing unless CHRONO2D_TRACING is defined
+ * (cmake -DCHRONO2D_TRACING=ON), so instrumented code costs nothing in normal builds.
+ */
+class Trace {
+public:
+    /**
+     * @brief Current time on the trace clock, in nanoseconds.
+     */
+    static int64_t nowNs();
+
+    /**
+     * @brief Records a finished zone in the calling thread's ring buffer.
+     * @param name Zone name. Must outlive the trace (use string literals).
+     * @param startNs Start time from nowNs().
+     * @param endNs End time from nowNs().
+     */
+    static void record(const char* name, int64_t startNs, int64_t endNs);
+
+    /**
+     * @brief Names the calling thread in the exported trace.
+     */
+    static void setThreadName(const std::string& name);
+
+    /**
+     * @brief Writes the content of every thread's ring buffer as Chrome trace-event JSON.
+     * Call while other threads are idle (e.g. between frames) for a consistent snapshot.
+     * @param path Output file path.
+     * @return True if the file was written.
+     */
+    static bool exportChromeJson(const std::string& path);
+};
+
+/**
+ * @brief Records the lifetime of a scope (or until end() is called) as a trace zone.
+ */
+class TraceZone {
+public:
+    explicit TraceZone(const char* name) : name_(name), startNs_(Trace::nowNs()) {}
+    ~TraceZone() { end(); }
+
+    TraceZone(const TraceZone&) = delete;
+    TraceZone& operator=(const TraceZone&) = delete;
+
+    /**
+     * @brief Closes the zone before the end of the scope.
+     */
+    void end() {
+        if (name_ != nullptr) {
+            Trace::record(name_, startNs_, Trace::nowNs());
+            name_ = nullptr;
+        }
+    }
+
+private:
+    const char* name_;
+    int64_t startNs_;
+};
+
+#ifdef CHRONO2D_TRACING
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+// Zone covering the rest of the enclosing scope
+#define TRACE_ZONE(name) TraceZone TRACE_CONCAT(traceZone_, __LINE__)(name)
+// Zone closed explicitly with TRACE_ZONE_END, for sections that are not a scope
+#define TRACE_ZONE_BEGIN(var, name) TraceZone var(name)
+#define TRACE_ZONE_END(var) var.end()
+#define TRACE_THREAD_NAME(name) Trace::setThreadName(name)
+#define TRACE_EXPORT(path) Trace::exportChromeJson(path)
+#else
+#define TRACE_ZONE(name) ((void)0)
+#define TRACE_ZONE_BEGIN(var, name) ((void)0)
+#define TRACE_ZONE_END(var) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#define TRACE_EXPORT(path) ((void)0)
+#endif
+
+#endif // TRACE_HPP
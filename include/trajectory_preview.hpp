@@ -0,0 +1,179 @@
+#ifndef TRAJECTORY_PREVIEW_HPP
+#define TRAJECTORY_PREVIEW_HPP
+
+#include <SFML/Graphics.hpp>
+#include <box2d/box2d.h>
+#include "game_object.hpp" // Includes utils.hpp and constants.hpp
+#include "world_freezer.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Predicts, while time is frozen, what the world will do when it resumes.
+ *
+ * When the freeze is applied, capture() copies the scene into plain descriptions:
+ * every body with its shapes and revolute joints, and for frozen bodies the type and
+ * velocities WorldFreezer will give back. A worker thread rebuilds the scene in two
+ * scratch worlds it owns and simulates them ahead:
+ * - the resume world, where frozen bodies move again and the player stands still:
+ *   the paths of the bodies near the player over TRAJECTORY_PREVIEW_STEPS;
+ * - the frozen world, where only the player moves: the arc of a jump started from
+ *   the player's current state over TRAJECTORY_ARC_STEPS, with movePlayer's gravity.
+ *
+ * The main thread never waits for a prediction: update() only posts the player's
+ * state, and paths() takes the newest finished result if the worker is not holding
+ * the lock, otherwise it keeps the previous one. Every request bumps a generation
+ * that the worker checks between steps, so a prediction made stale by a newer
+ * request (the player moved, the scene was streamed, time resumed) is abandoned.
+ *
+ * The scratch worlds are created once and reused: when the captured bodies are the
+ * same as the previous capture (same bodies, types and shape counts) their state is
+ * only reset, otherwise they are rebuilt. Description, sample and vertex buffers
+ * keep their capacity from one prediction to the next.
+ *
+ * Time-dilation zones and gameplay events are not predicted.
+ */
+class TrajectoryPreview {
+public:
+    TrajectoryPreview();
+    ~TrajectoryPreview();
+
+    TrajectoryPreview(const TrajectoryPreview&) = delete;
+    TrajectoryPreview& operator=(const TrajectoryPreview&) = delete;
+
+    /**
+     * @brief Copies the frozen scene and starts predicting it. Call after WorldFreezer::freeze
+     * (and freezeNew), on the thread owning the world.
+     * @param worldId The game's world (for its gravity).
+     * @param gameObjects The vector of all GameObjects in the scene.
+     * @param playerBodyId The player's body.
+     * @param freezer The freezer holding the bodies' saved types and velocities.
+     */
+    void capture(b2WorldId worldId, const GameObjectList& gameObjects, b2BodyId playerBodyId, const WorldFreezer& freezer);
+
+    /**
+     * @brief Posts the player's current state. Cheap: a new jump arc is only requested
+     * when the state changed, new body paths when the player moved far enough.
+     */
+    void update(b2BodyId playerBodyId);
+
+    /**
+     * @brief Abandons the captured scene and any running prediction (time resumes, level change).
+     */
+    void cancel();
+
+    /**
+     * @brief The newest predicted paths, as line segments (PrimitiveType::Lines) in world pixels.
+     * Never blocks; call from the thread that calls capture().
+     */
+    const std::vector<sf::Vertex>& paths();
+
+private:
+    struct BodyDesc {
+        uint64_t key;           // b2StoreBodyId of the game's body
+        b2BodyType type;        // Type when time resumes
+        b2Transform transform;
+        b2Vec2 linearVelocity;  // Velocities when time resumes
+        float angularVelocity;
+        float linearDamping;
+        float angularDamping;
+        float gravityScale;
+        bool fixedRotation;
+        bool isBullet;
+        int firstShape;         // Range in shapes
+        int shapeCount;
+    };
+
+    struct ShapeDesc {
+        b2ShapeType type;
+        union {
+            b2Polygon polygon;
+            b2Circle circle;
+            b2Capsule capsule;
+            b2Segment segment;
+        };
+        float density;
+        float friction;
+        float restitution;
+        b2Filter filter;
+    };
+
+    struct JointDesc {
+        int bodyA;              // Indices in bodies
+        int bodyB;
+        b2RevoluteJointDef def;
+    };
+
+    struct SceneDesc {
+        b2Vec2 gravity {0.0f, -10.0f};
+        std::vector<BodyDesc> bodies;
+        std::vector<ShapeDesc> shapes;
+        std::vector<JointDesc> joints;
+        int player {-1};        // Index in bodies
+    };
+
+    struct PlayerState {
+        b2Transform transform;
+        b2Vec2 linearVelocity;
+    };
+
+    void run();
+    void buildWorlds();
+    void resetWorlds();
+    bool sameStructure() const;
+    bool predictBodies(const PlayerState& player, uint32_t generation);
+    bool predictArc(const PlayerState& player, uint32_t generation);
+    void publish(uint32_t sceneSerial);
+
+    // Main thread
+    std::unordered_map<uint64_t, const WorldFreezer::FrozenBody*> frozenByKey_;
+    std::unordered_map<uint64_t, int> bodyIndex_;
+    std::vector<b2ShapeId> shapeIds_;
+    std::vector<b2JointId> jointIds_;
+    SceneDesc captured_;
+    PlayerState lastPosted_ {};
+    b2Vec2 lastPlanPosition_ {0.0f, 0.0f};
+    bool hasScene_ {false};
+    std::vector<sf::Vertex> front_;
+    uint32_t frontVersion_ {0};
+
+    // Shared, guarded by mutex_
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    SceneDesc pending_;         // Swapped with captured_ / scene_
+    bool sceneRequested_ {false};
+    bool bodiesRequested_ {false};
+    bool arcRequested_ {false};
+    bool sceneValid_ {false};
+    uint32_t sceneSerial_ {0};  // Bumped by capture() and cancel()
+    PlayerState postedPlayer_ {};
+    std::vector<sf::Vertex> ready_; // Newest finished result
+    uint32_t readyVersion_ {0};
+    bool stopping_ {false};
+
+    // Checked by the worker between steps
+    std::atomic<uint32_t> bodiesGeneration_ {0};
+    std::atomic<uint32_t> arcGeneration_ {0};
+
+    // Worker thread
+    SceneDesc scene_;
+    std::vector<BodyDesc> built_; // Bodies the scratch worlds currently hold
+    std::size_t builtJoints_ {0};
+    b2WorldId resumeWorld_;
+    b2WorldId frozenWorld_;
+    std::vector<b2BodyId> resumeBodies_;
+    std::vector<b2BodyId> frozenBodies_;
+    std::vector<int> tracked_;  // Bodies whose path is predicted
+    std::vector<b2Vec2> samples_;
+    std::vector<sf::Vertex> bodyLines_;
+    std::vector<sf::Vertex> arcLines_;
+    std::vector<sf::Vertex> work_;
+    std::thread thread_;
+};
+
+#endif // TRAJECTORY_PREVIEW_HPP
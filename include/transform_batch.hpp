@@ -0,0 +1,86 @@
+#ifndef TRANSFORM_BATCH_HPP
+#define TRANSFORM_BATCH_HPP
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <box2d/box2d.h>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Number of vertices written per object: two triangles, sf::PrimitiveType::Triangles.
+ */
+const std::size_t TRANSFORM_BATCH_VERTICES_PER_QUAD = 6;
+
+/**
+ * @brief Converts body transforms to screen-space quads in one pass.
+ *
+ * The per-object path (GameObject::updateShape) goes through b2Rot_GetAngle, a
+ * degree conversion and the sf::Transformable setters, and SFML later rebuilds a
+ * matrix with sin/cos from that angle. This batch instead gathers the transforms
+ * into arrays (structure of arrays) and computes the four corners of every quad
+ * directly from the rotation's cosine and sine, with the meters-to-pixels scale
+ * and the Y flip folded in. Four objects are processed per iteration with SSE2
+ * when available, the remainder (or every object elsewhere) with scalar code.
+ *
+ * Quads are written as two triangles with their color and no texture, so a whole
+ * batch is a single draw call. Corners match an sf::RectangleShape of the same
+ * size with its origin at the center, as set up by GameObject::finalize().
+ */
+class TransformBatch {
+public:
+    /**
+     * @brief Removes every object. Arrays keep their capacity.
+     */
+    void clear();
+
+    /**
+     * @brief Reserves room for a number of objects.
+     */
+    void reserve(std::size_t count);
+
+    /**
+     * @brief Adds an object, reading the current transform of its body.
+     * @param bodyId The body of the object (must be valid).
+     * @param halfWidth_m Half of the object's width, in meters.
+     * @param halfHeight_m Half of the object's height, in meters.
+     * @param color The fill color of the quad.
+     */
+    void add(b2BodyId bodyId, float halfWidth_m, float halfHeight_m, sf::Color color);
+
+    /**
+     * @brief Adds an object from an already known transform.
+     */
+    void add(const b2Transform& transform, float halfWidth_m, float halfHeight_m, sf::Color color);
+
+    /**
+     * @brief Number of objects in the batch.
+     */
+    std::size_t size() const { return positionX_.size(); }
+
+    /**
+     * @brief Writes the quads of every object at the end of a vertex buffer.
+     * @param vertices The buffer; size() * TRANSFORM_BATCH_VERTICES_PER_QUAD vertices are appended.
+     */
+    void writeQuads(std::vector<sf::Vertex>& vertices) const;
+
+private:
+    // Meters, Box2D frame
+    std::vector<float> positionX_;
+    std::vector<float> positionY_;
+    std::vector<float> cosine_;
+    std::vector<float> sine_;
+    std::vector<float> halfWidth_;
+    std::vector<float> halfHeight_;
+    std::vector<sf::Color> color_;
+};
+
+/**
+ * @brief The kernel behind TransformBatch::writeQuads, on raw arrays.
+ * Writes count * TRANSFORM_BATCH_VERTICES_PER_QUAD vertices to out.
+ */
+void transformQuads(const float* positionX, const float* positionY, const float* cosine, const float* sine,
+                    const float* halfWidth, const float* halfHeight, const sf::Color* color,
+                    std::size_t count, sf::Vertex* out);
+
+#endif // TRANSFORM_BATCH_HPP
@@ -0,0 +1,66 @@
+#ifndef WORLD_FREEZER_HPP
+#define WORLD_FREEZER_HPP
+
+#include <box2d/box2d.h>
+#include "game_object.hpp" // Includes utils.hpp and constants.hpp
+#include <vector>
+
+/**
+ * @brief Implements the time freeze: every body but the player is made static and restored later.
+ *
+ * Freezing saves each body's type and velocities and turns it into a static body, so
+ * the player can walk on objects stopped mid-air. Restoring gives every body back its
+ * type and velocities, so the world resumes exactly where it stopped.
+ */
+class WorldFreezer {
+public:
+    /**
+     * @brief Freezes every non-player body of the scene.
+     * @param gameObjects The vector of all GameObjects in the scene.
+     * @param playerBodyId The player's body, which keeps moving.
+     */
+    void freeze(GameObjectList& gameObjects, b2BodyId playerBodyId);
+
+    /**
+     * @brief Freezes bodies that appeared since freeze() (e.g. streamed-in chunks).
+     * Bodies that are already static are skipped, so calling it again is harmless.
+     */
+    void freezeNew(GameObjectList& gameObjects, b2BodyId playerBodyId);
+
+    /**
+     * @brief Restores the type and velocities of every frozen body still alive.
+     */
+    void restore();
+
+    /**
+     * @brief Forgets the frozen bodies without touching them (the world is being destroyed).
+     */
+    void clear() { frozenBodies_.clear(); }
+
+    /**
+     * @brief Number of bodies currently frozen.
+     */
+    std::size_t frozenCount() const { return frozenBodies_.size(); }
+
+    /**
+     * @brief What a frozen body will get back when restored.
+     */
+    struct FrozenBody {
+        b2BodyId bodyId;
+        b2BodyType originalType;
+        b2Vec2 linearVelocity;
+        float angularVelocity;
+    };
+
+    /**
+     * @brief The bodies currently frozen, with their saved type and velocities.
+     */
+    const std::vector<FrozenBody>& frozenBodies() const { return frozenBodies_; }
+
+private:
+    void freezeBody(b2BodyId bodyId);
+
+    std::vector<FrozenBody> frozenBodies_;
+};
+
+#endif // WORLD_FREEZER_HPP
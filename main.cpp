@@ -4,6 +4,31 @@
 #include "include/game_object.hpp"
 #include "include/player.hpp"
 #include "include/constants.hpp"
+#include "include/static_layer_cache.hpp"
+#include "include/frozen_scene_cache.hpp"
+#include "include/level_streamer.hpp"
+#include "include/destruction_queue.hpp"
+#include "include/timer_wheel.hpp"
+#include "include/input_queue.hpp"
+#include "include/frame_pacer.hpp"
+#include "include/quality_governor.hpp"
+#include "include/physics_lod.hpp"
+#include "include/event_dispatcher.hpp"
+#include "include/memory_tracker.hpp"
+#include "include/level_arena.hpp"
+#include "include/task_system.hpp"
+#include "include/trace.hpp"
+#include "include/world_freezer.hpp"
+#include "include/trajectory_preview.hpp"
+#include "include/time_rewind.hpp"
+#include "include/time_dilation.hpp"
+#include "include/scene_renderer.hpp"
+#include "include/physics_debug_draw.hpp"
+#include "include/particle_system.hpp"
+#include "include/render_stats.hpp"
+#include "include/frame_benchmark.hpp"
+#include "include/render_thread.hpp"
+#include "include/logger.hpp"
 
 // --- Map Loading ---
 #include "maps/map0.hpp" // Change this to load different maps
@@ -22,72 +47,100 @@
 #include <filesystem> // Required for std::filesystem::current_path
 #include <SFML/Audio.hpp>
 #include <cstdint>
-
-// Helper function to find GameObject by shapeId
-GameObject* findGameObjectByShapeId(b2ShapeId shapeId, std::vector<GameObject>& gameObjects) {
-    if (B2_IS_NULL(shapeId)) return nullptr;
-    for (auto& obj : gameObjects) {
-        if (B2_ID_EQUALS(obj.shapeId, shapeId)) {
-            return &obj;
-        }
-    }
-    return nullptr;
-}
-
+#include <cstdlib> // For std::atoi, std::getenv
+#include <string>
+#include <thread> // For std::thread::hardware_concurrency
 
 /**
  * @brief Main entry point for the SFML Box2D Platformer game.
  * Initializes the game window, physics world, game objects, and runs the main game loop.
+ * With `--frame-bench [framesPerLevel] [output.json]`, runs the offscreen camera
+ * flythrough benchmark of every level instead (see frame_benchmark.hpp).
  * @return 0 if the game exits successfully, -1 on critical initialization failure.
  */
-int main() {
+int main(int argc, char* argv[]) {
+    // Track Box2D allocations; must happen before the first world is created
+    MemoryTracker::installBox2DAllocator();
+    // Log messages go to stderr unless CHRONO2D_LOG_FILE names a file
+    if (const char* logPath = std::getenv("CHRONO2D_LOG_FILE")) {
+        Logger::instance().openFile(logPath);
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "--frame-bench") {
+        FrameBenchmarkOptions benchOptions;
+        if (argc > 2) benchOptions.framesPerLevel = std::max(1, std::atoi(argv[2]));
+        if (argc > 3) benchOptions.outPath = argv[3];
+        return runFrameBenchmark(benchOptions);
+    }
+
     sf::RenderWindow window(sf::VideoMode({WINDOW_WIDTH, WINDOW_HEIGHT}), "Chrono2D");
-    window.setFramerateLimit(60);
+    // CHRONO2D_LOW_LATENCY=1 samples input just before each presentation deadline instead of
+    // right after the previous frame was drawn; the pacer then spaces the frames itself
+    const char* lowLatencySetting = std::getenv("CHRONO2D_LOW_LATENCY");
+    FramePacer framePacer(lowLatencySetting != nullptr && std::string(lowLatencySetting) != "0");
+    window.setFramerateLimit(framePacer.lowLatency() ? 0 : 60);
+    // Lowers physics and rendering quality when frames get too expensive, raises it back after
+    QualityGovernor quality;
+    // Box2D shapes, bounds, joints and contacts batched for drawing, switched with F1 - F4
+    PhysicsDebugDraw physicsDebug;
+    // Freeze, landing and impact effects, at most QUALITY_MAX_PARTICLES per pool
+    ParticleSystem particles(QUALITY_MAX_PARTICLES);
 
     // Camera view for scrolling
     sf::View view = window.getDefaultView();
 
-    // --- Load Font for UI Text ---
-    sf::Font font;
-    if (!font.openFromFile("../assets/fonts/ARIAL.TTF")) {
-        // Try alternative font paths if the first fails
-        if (!font.openFromFile("/System/Library/Fonts/Arial.ttf") && 
-            !font.openFromFile("/usr/share/fonts/truetype/liberation/LiberationSans-Regular.ttf") &&
-            !font.openFromFile("C:/Windows/Fonts/arial.ttf")) {
-            std::cerr << "Warning: Could not load font. Text will not display properly." << std::endl;
-        }
-    }
-
-    // --- Create Instruction Text ---
-    sf::Text instructionText(font, "Press F to freeze time, R to restart", 24);
-    instructionText.setFillColor(sf::Color::White);
-    instructionText.setStyle(sf::Text::Bold);
-    // Position at bottom center of screen
-    sf::FloatRect textBounds = instructionText.getLocalBounds();
-    instructionText.setPosition(sf::Vector2f(WINDOW_WIDTH / 2.0f - textBounds.size.x / 2.0f, WINDOW_HEIGHT - 100.0f));
-
     // Initialize Box2D world
     b2Vec2 gravity = {0.0f, -10.0f};
     b2WorldDef worldDef = b2DefaultWorldDef();
     worldDef.gravity = gravity;
+    worldDef.hitEventThreshold = PARTICLE_IMPACT_MIN_SPEED; // Softer hits throw no particles
+    // Box2D spreads its work over a small thread pool (the main thread being one of the workers)
+    unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    TaskSystem physicsTasks(static_cast<int>(std::min(hardwareThreads, static_cast<unsigned int>(PHYSICS_WORKER_COUNT))));
+    physicsTasks.configure(worldDef);
+    TRACE_THREAD_NAME("Main");
     b2WorldId worldId = b2CreateWorld(&worldDef);
     if (B2_IS_NULL(worldId)) {
-        std::cerr << "Failed to create Box2D world." << std::endl;
+        LOG_ERROR(LogCategory::Physics) << "Failed to create Box2D world.";
         return -1;
     }
 
-    std::vector<GameObject> gameObjects;
+    // Game-side level data is allocated from an arena released wholesale at level change
+    LevelArena levelArena;
+    GameObjectList gameObjects{ArenaAllocator<GameObject>(&levelArena)};
     b2BodyId playerBodyId = b2_nullBodyId;
     int playerIndex = -1;
 
+    // Static scenery is rasterized once into tiles instead of being redrawn every frame
+    StaticLayerCache staticLayer;
+    // While time is frozen the whole world (minus the player) is rendered once and reused
+    FrozenSceneCache frozenScene;
+    // Long levels register their content as chunks created and destroyed around the player
+    LevelStreamer streamer;
+    // Objects marked dead by gameplay are destroyed together after the step
+    DestructionQueue destruction;
+    // Gameplay timers (spawners...), counted in simulation steps
+    TimerWheel timers;
+    // Key events stamped as the window reports them, resolved once per step
+    InputQueue input;
+    // Regions far from the player are stepped at a reduced rate or kept asleep
+    PhysicsLod physicsLod;
+    std::vector<b2BodyId> lodBodies;
+    // Routes sensor and contact events to gameplay handlers by collision category
+    EventDispatcher events;
+
+    // Draws the parallax background, the world, the overlays and the HUD
+    SceneRenderer sceneRenderer(staticLayer, frozenScene);
+
     // --- Time Freeze State ---
     static bool timeFreeze = false;
     static bool wasInTimeFreeze = false;
-    static std::vector<std::tuple<b2BodyId, b2BodyType, b2Vec2, float>> frozenBodyData;
+    WorldFreezer worldFreezer;
+    TimeRewind timeRewind; // Every physics step, for scrubbing back while the rewind key is held
+    TimeDilationZones timeZones; // Freeze / slow-motion / fast-forward areas placed by the maps
+    TrajectoryPreview trajectoryPreview; // What the frozen world will do when time resumes, computed on a worker thread
 
     // --- Transition overlay ---
-    sf::RectangleShape transitionOverlay(sf::Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT));
-    transitionOverlay.setFillColor(sf::Color(0, 0, 0, 0)); // Start transparent
     bool isTransitioning = false;
     bool isFadingOut = false;
     bool isFadingIn = false;
@@ -95,8 +148,6 @@ int main() {
     const float TRANSITION_SPEED = 255.0f / 1.0f; // Full fade in 1 second
 
     // --- TimeFreeze overlay ---
-    sf::RectangleShape timeFreezeOverlay(sf::Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT));
-    timeFreezeOverlay.setFillColor(sf::Color(0, 0, 0, 0)); // Start transparent
     bool isTimeFreezeTransitioning = false;
     bool isTimeFreezeOverlayFadingIn = false;
     bool isTimeFreezeOverlayFadingOut = false;
@@ -112,30 +163,23 @@ int main() {
     std::unique_ptr<sf::Sound> timeFreezeSound;
     bool soundsInitialized = false;
     if (!timeFreezeSoundBuffer.loadFromFile("../assets/audio/timefreezesound.wav")) {
-        std::cerr << "Failed to load time freeze sound!" << std::endl;
+        LOG_ERROR(LogCategory::Assets) << "Failed to load time freeze sound!";
         return -1;
     }
     if (!timeUnfreezeSoundBuffer.loadFromFile("../assets/audio/timeunfreezesound.wav")) {
-        std::cerr << "Failed to load time unfreeze sound!" << std::endl;
+        LOG_ERROR(LogCategory::Assets) << "Failed to load time unfreeze sound!";
         return -1;
     }
 
-    // --- Load Background Map
-    sf::Texture backgroundTexture;
-    if (!backgroundTexture.loadFromFile("../assets/objects/background.png")) {
-        return -1; // Échec de chargement
+    // --- Load Background, Clouds and HUD Font ---
+    if (!sceneRenderer.loadAssets()) {
+        return -1;
     }
-    backgroundTexture.setRepeated(true);
-    sf::RectangleShape backgroundShape;
-    backgroundShape.setTexture(&backgroundTexture);
-
-    sf::Texture cloudTexture;
-    if (!cloudTexture.loadFromFile("../assets/objects/cloud.png")) {
-        return -1; // Échec de chargement
+    if (!particles.loadTextures()) {
+        LOG_WARNING(LogCategory::Assets) << "Failed to create the particle texture: glow particles are drawn as squares.";
     }
-    cloudTexture.setRepeated(true);
-    sf::RectangleShape cloudShape;
-    cloudShape.setTexture(&cloudTexture);
+    // Frames are drawn and presented on their own thread, overlapping the next simulation step
+    RenderThread renderThread(window, sceneRenderer, &framePacer);
     
     // Create sound objects
     timeFreezeSound = std::make_unique<sf::Sound>(timeFreezeSoundBuffer);
@@ -150,7 +194,7 @@ int main() {
     sf::Music backgroundMusic;
     // Load the music file
     if (!backgroundMusic.openFromFile("../assets/audio/backgroundmusic.ogg")) {
-        std::cerr << "Failed to load background music!" << std::endl;
+        LOG_ERROR(LogCategory::Assets) << "Failed to load background music!";
         return -1;
     }
     // Set music properties
@@ -169,13 +213,22 @@ int main() {
         if (level == 0) {
             playerIndex = loadMap0(worldId, gameObjects, playerBodyId);
         } else if (level == 1) {
-            playerIndex = loadMap1(worldId, gameObjects, playerBodyId);
+            playerIndex = loadMap1(worldId, gameObjects, playerBodyId, timeZones);
+            startMap1Spawner(timers, worldId, gameObjects);
         } else if (level == 2) {
             playerIndex = loadMap2(worldId, gameObjects, playerBodyId);
         } else if (level == 3) {
             playerIndex = loadMap3(worldId, gameObjects, playerBodyId);
         } else if (level == 4) {
-            playerIndex = loadMap4(worldId, gameObjects, playerBodyId);
+            playerIndex = loadMap4(worldId, gameObjects, playerBodyId, streamer);
+        }
+        if (!streamer.empty() && !B2_IS_NULL(playerBodyId)) {
+            streamer.prime(worldId, gameObjects, b2Body_GetPosition(playerBodyId).x);
+            for (size_t i = 0; i < gameObjects.size(); ++i) {
+                if (B2_ID_EQUALS(gameObjects[i].bodyId, playerBodyId)) {
+                    playerIndex = static_cast<int>(i);
+                }
+            }
         }
         
         
@@ -184,22 +237,13 @@ int main() {
             isFadingOut = false;  // Make sure we're not fading out
             isFadingIn = true;    // Set to fade in
             transitionAlpha = 255.0f; // Start fully black
-            transitionOverlay.setFillColor(sf::Color(0, 0, 0, 255)); // Set to fully black
         }
 
             // --- Initialize Player Animations ---
             if (playerIndex != -1) {
-                GameObject& playerObject = gameObjects[playerIndex];
-                std::string basePath = "../assets/sprite/character/Poses/";
-
-                playerObject.loadPlayerAnimation("idle", {basePath + "female_idle.png"}, 0.1f);
-                playerObject.loadPlayerAnimation("walk", {basePath + "female_walk1.png", basePath + "female_walk2.png"}, 0.15f);
-                playerObject.loadPlayerAnimation("jump", {basePath + "female_jump.png"}, 0.1f);
-                playerObject.loadPlayerAnimation("fall", {basePath + "female_fall.png"}, 0.1f);
-
-                playerObject.setPlayerAnimation("idle", false); // Initial state: idle, facing right
+                loadPlayerAnimations(gameObjects[playerIndex]);
             } else {
-                std::cerr << "Player object not found after map loading." << std::endl;
+                LOG_ERROR(LogCategory::Loading) << "Player object not found after map loading.";
             }
 
             // --- Game Loop Variables ---
@@ -207,20 +251,55 @@ int main() {
             sf::Clock cloudClock; // Add clock for cloud movement
             sf::Time cloudPausedTime = sf::Time::Zero;
             bool cloudClockPaused = false; 
-            int32_t subSteps = 8;   // Number of physics sub-steps per frame
+            int32_t subSteps = quality.settings().physicsSubSteps; // Physics sub-steps per frame, lowered under load
             bool levelCompleted = false; // Flag to ensure "Level completed!" message prints only once   
             bool levelReset = false; // Flag to reset the current level
+
+            // --- Gameplay Event Handlers ---
+            events.on(GameEventType::SensorBegin, CATEGORY_FLAG, CATEGORY_PLAYER, "flag reached",
+                      [&levelCompleted](const GameEvent& event) {
+                if (event.objectA && event.objectB && event.objectA->isFlag_prop_ && event.objectA->isSensor_prop_ && event.objectB->isPlayer) {
+                    LOG_INFO(LogCategory::Gameplay) << "Level completed !";
+                    levelCompleted = true;
+                }
+            });
+            events.on(GameEventType::SensorBegin, CATEGORY_TREMPLIN, CATEGORY_WORLD, "tremplin bounce",
+                      [&particles](const GameEvent& event) {
+                // objectA owns the sensor: the sensor part of a tremplin
+                GameObject* visitor = event.objectB;
+                if (event.objectA && visitor && event.objectA->isTremplin_prop_ &&
+                    visitor->isDynamic_val_ && !visitor->isPlayer_prop_) {
+                    visitor->setPendingImpulsion({0.f, 1.5f});
+                    particles.emit(ParticleEffect::TremplinBounce, b2Body_GetPosition(visitor->bodyId), {0.0f, 1.0f});
+                }
+            });
+            events.on(GameEventType::Hit, CATEGORY_WORLD, CATEGORY_WORLD | CATEGORY_PLAYER, "impact particles",
+                      [&particles](const GameEvent& event) {
+                // Debris thrown up from the contact point, more and faster for harder hits
+                float strength = std::min(event.approachSpeed / PARTICLE_IMPACT_REFERENCE_SPEED, 2.0f);
+                particles.emit(ParticleEffect::Impact, event.point, {0.0f, 1.0f}, strength);
+            });
+
             while (window.isOpen()) {
+                TRACE_ZONE("Frame");
+                FrameTiming frameTiming;
+                {
+                    TRACE_ZONE("Frame pacing");
+                    frameTiming = framePacer.latch(); // Waits for the latch point in low-latency mode
+                }
+                int64_t frameWorkStartNs = InputQueue::nowNs();
                 float elapsed_time = clock.restart().asSeconds();
                 float dt = UPDATE_DELTA;
 
                 // --- SFML Event Handling ---
-                bool jumpKeyHeld = false;
+                TRACE_ZONE_BEGIN(inputZone, "Input");
                 while (std::optional<sf::Event> event = window.pollEvent()) {
                     if (event) {
                         if (event->is<sf::Event::Closed>()) {
+                            renderThread.stop(); // Must not present to a closed window
                             window.close();
                         }
+                        input.push(*event);
                     }
                 }
 
@@ -248,8 +327,6 @@ int main() {
                             isTransitioning = false;
                         }
                     }
-                    transitionOverlay.setFillColor(sf::Color(0, 0, 0, static_cast<std::uint8_t>(transitionAlpha)));
-                    
                 }
                 if (isTimeFreezeTransitioning) {
                     if (isTimeFreezeOverlayFadingIn) {
@@ -268,36 +345,51 @@ int main() {
                             timeFreeze = false; // Actually disable time freeze after fade out
                         }
                     }
-                    
-                    // Update overlay color with current alpha
-                    timeFreezeOverlay.setFillColor(sf::Color(100, 150, 255, static_cast<std::uint8_t>(timeFreezeOverlayAlpha))); // Light blue tint
                 }
 
                 // --- Input State Update ---
-                // Check current state of movement and jump keys
-                bool wantsToMoveLeft = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Left) || sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Q);
-                bool wantsToMoveRight = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Right) || sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D);
-                jumpKeyHeld = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Space) || sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Up) || sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Z);
-                // Detect F key just pressed for time freeze toggle
-                static bool prevFKeyState = false;
-                bool currFKeyState = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::F);
-                bool wantsToTimeFreeze = false;
-                if (currFKeyState && !prevFKeyState) {
-                    wantsToTimeFreeze = true;
-                }
-                prevFKeyState = currFKeyState;
+                // Edges since the previous step: a key tapped between two steps still counts
+                InputStep stepInput = input.resolve(InputQueue::nowNs());
+                frameTiming.inputNs = stepInput.firstPressNs; // Measured up to this frame's presentation
+                bool wantsToMoveLeft = stepInput.down(InputAction::MoveLeft);
+                bool wantsToMoveRight = stepInput.down(InputAction::MoveRight);
+                bool jumpKeyHeld = stepInput.down(InputAction::Jump);
+                bool jumpKeyPressed = stepInput.wasPressed(InputAction::Jump);
+                bool wantsToTimeFreeze = stepInput.wasPressed(InputAction::TimeFreeze);
+
+                // Rewind is held, not toggled
+                bool rewindKeyHeld = stepInput.down(InputAction::Rewind);
 
                 // Detect R key press for level reset
-                if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::R)) {
+                if (stepInput.down(InputAction::Reset)) {
                     levelReset = true;
                 }
 
+                // Physics debug view categories
+                static const struct { InputAction action; DebugDrawCategory category; const char* name; } debugToggles[] = {
+                    {InputAction::DebugShapes, DebugDrawCategory::Shapes, "shapes"},
+                    {InputAction::DebugBounds, DebugDrawCategory::Bounds, "bounds"},
+                    {InputAction::DebugJoints, DebugDrawCategory::Joints, "joints"},
+                    {InputAction::DebugContacts, DebugDrawCategory::Contacts, "contacts"},
+                };
+                for (const auto& toggle : debugToggles) {
+                    if (stepInput.wasPressed(toggle.action)) {
+                        bool on = physicsDebug.toggle(toggle.category);
+                        if (on) quality.restoreDebugOverlays();
+                        LOG_INFO(LogCategory::Physics) << "Physics debug " << toggle.name << (on ? " on" : " off");
+                    }
+                }
+                TRACE_ZONE_END(inputZone);
+
                 // --- Time Freeze Logic ---
                 
                 if (wantsToTimeFreeze) {
                     if (!timeFreeze) {
                         // Starting time freeze - begin fade in
                         timeFreeze = true;
+                        if (!B2_IS_NULL(playerBodyId)) {
+                            particles.emit(ParticleEffect::FreezeBurst, b2Body_GetPosition(playerBodyId), {0.0f, 1.0f});
+                        }
                         isTimeFreezeTransitioning = true;
                         isTimeFreezeOverlayFadingIn = true;
                         isTimeFreezeOverlayFadingOut = false;
@@ -306,7 +398,7 @@ int main() {
                         }
                         cloudPausedTime += cloudClock.getElapsedTime();
                         cloudClockPaused = true;
-                        std::cout << "Time frozen - fading in overlay." << std::endl;
+                        LOG_INFO(LogCategory::Gameplay) << "Time frozen - fading in overlay.";
                     } else if (!isTimeFreezeTransitioning) {
                         // Ending time freeze - begin fade out
                         isTimeFreezeTransitioning = true;
@@ -317,7 +409,7 @@ int main() {
                         }
                         cloudClock.restart();
                         cloudClockPaused = false;
-                        std::cout << "Time unfrozen - fading out overlay." << std::endl;
+                        LOG_INFO(LogCategory::Gameplay) << "Time unfrozen - fading out overlay.";
                     }
                 }
 
@@ -326,135 +418,148 @@ int main() {
                     wantsToMoveLeft = false;
                     wantsToMoveRight = false;
                     jumpKeyHeld = false;
+                    jumpKeyPressed = false;
                     wantsToTimeFreeze = false;
+                    rewindKeyHeld = false;
                 }
+
+                // Frozen bodies are static: rewinding only runs in normal time
+                bool rewinding = rewindKeyHeld && !timeFreeze && timeRewind.canRewind();
                 
 
                 // --- Player Movement ---
-                if (playerIndex != -1 && !B2_IS_NULL(playerBodyId)) {
-                    movePlayer(worldId, playerBodyId, gameObjects[playerIndex], gameObjects, jumpKeyHeld,
+                if (!rewinding && playerIndex != -1 && !B2_IS_NULL(playerBodyId)) {
+                    TRACE_ZONE("movePlayer");
+                    bool landed = movePlayer(worldId, playerBodyId, gameObjects[playerIndex], gameObjects, jumpKeyHeld,
+                            jumpKeyPressed, stepInput.pressAgeSeconds(InputAction::Jump),
                             wantsToMoveLeft, wantsToMoveRight, dt);
                     
                     // Check if player has fallen off the map
                     b2Vec2 playerPos = b2Body_GetPosition(playerBodyId);
-                    if (playerPos.y < -20.0f) { // Death plane at y = -20 meters
+                    if (landed) {
+                        // Dust under the feet
+                        b2Vec2 feet = {playerPos.x, playerPos.y - gameObjects[playerIndex].height_m_ / 2.0f};
+                        particles.emit(ParticleEffect::Landing, feet, {0.0f, 1.0f});
+                    }
+                    if (playerPos.y < KILL_PLANE_Y_M) { // Death plane
                         levelReset = true;
                     }
                 }
 
-                // Add these vectors to store original body types
-                
-
                 if(!timeFreeze){
                     // Just exited freeze mode - restore original body types AND velocities
                     if (wasInTimeFreeze) {
-                        for (const auto& data : frozenBodyData) {
-                            b2BodyId bodyId = std::get<0>(data);
-                            b2BodyType originalType = std::get<1>(data);
-                            b2Vec2 originalLinearVel = std::get<2>(data);
-                            float originalAngularVel = std::get<3>(data);
-                            
-                            if (!B2_IS_NULL(bodyId)) {
-                                // Restore body type
-                                b2Body_SetType(bodyId, originalType);
-                                // Restore velocities
-                                b2Body_SetLinearVelocity(bodyId, originalLinearVel);
-                                b2Body_SetAngularVelocity(bodyId, originalAngularVel);
-                            }
-                        }
-                        frozenBodyData.clear();
+                        trajectoryPreview.cancel();
+                        worldFreezer.restore();
                         wasInTimeFreeze = false;
                     }
                     
-                    // Normal physics for everything
-                    b2World_Step(worldId, dt, subSteps);
+                    if (rewinding) {
+                        // Play the recorded steps backwards instead of stepping the world
+                        TRACE_ZONE("Rewind");
+                        for (int step = 0; step < REWIND_STEPS_PER_FRAME; ++step) {
+                            if (!timeRewind.stepBack()) break;
+                        }
+                    } else {
+                        // Normal physics, at full rate only around the player
+                        lodBodies.clear();
+                        for (const auto& obj : gameObjects) {
+                            if (obj.isDynamic_val_ && !B2_IS_NULL(obj.bodyId)) {
+                                lodBodies.push_back(obj.bodyId);
+                            }
+                        }
+                        b2Vec2 lodFocus = B2_IS_NULL(playerBodyId) ? b2Vec2{0.0f, 0.0f} : b2Body_GetPosition(playerBodyId);
+                        {
+                            TRACE_ZONE("Time zones");
+                            timeZones.update(worldId, playerBodyId, &physicsLod); // Before the LOD: see TimeDilationZones
+                        }
+                        physicsLod.beforeStep(lodBodies, lodFocus);
+                        {
+                            TRACE_ZONE("b2World_Step");
+                            b2World_Step(worldId, dt, subSteps);
+                        }
+                        physicsLod.afterStep();
+                        {
+                            // Only normal-time steps advance the timers: they stop under freeze and rewind
+                            TRACE_ZONE("Timers");
+                            timers.advance();
+                        }
+                        TRACE_ZONE("Record rewind history");
+                        timeRewind.record(worldId);
+                    }
                 } else {
                     // Just entered freeze mode - store original types AND velocities
                     if (!wasInTimeFreeze) {
-                        frozenBodyData.clear();
-                        for (auto& obj : gameObjects) {
-                            if (!B2_IS_NULL(obj.bodyId) && !B2_ID_EQUALS(obj.bodyId, playerBodyId)) {
-                                // Store original body type and velocities
-                                b2BodyType originalType = b2Body_GetType(obj.bodyId);
-                                b2Vec2 originalLinearVel = b2Body_GetLinearVelocity(obj.bodyId);
-                                float originalAngularVel = b2Body_GetAngularVelocity(obj.bodyId);
-                                
-                                frozenBodyData.push_back(std::make_tuple(obj.bodyId, originalType, originalLinearVel, originalAngularVel));
-                                
-                                // Make completely immovable
-                                b2Body_SetType(obj.bodyId, b2_staticBody);
-                                b2Body_SetLinearVelocity(obj.bodyId, {0.0f, 0.0f});
-                                b2Body_SetAngularVelocity(obj.bodyId, 0.0f);
-                            }
-                        }
+                        physicsLod.wakeAll(); // Sleeping bodies report zero velocity
+                        worldFreezer.freeze(gameObjects, playerBodyId);
+                        trajectoryPreview.capture(worldId, gameObjects, playerBodyId, worldFreezer);
                         wasInTimeFreeze = true;
                     }
                     
                     // During freeze - physics step with static bodies
-                    b2World_Step(worldId, dt, subSteps);
+                    {
+                        TRACE_ZONE("b2World_Step");
+                        b2World_Step(worldId, dt, subSteps);
+                    }
+                    trajectoryPreview.update(playerBodyId); // New jump arc if the player moved
+                    TRACE_ZONE("Record rewind history");
+                    timeRewind.record(worldId); // Only the player moves
                 }
 
-                // When exiting freeze mode, restore original body types
-                static bool wasInFreeze = false;
-                if (wasInFreeze && !timeFreeze) {
-                    // Restore original body types
-                    for (const auto& data : frozenBodyData) {
-                        b2BodyId bodyId = std::get<0>(data);
-                        b2BodyType originalType = std::get<1>(data);
-                        b2Vec2 originalLinearVel = std::get<2>(data);
-                        float originalAngularVel = std::get<3>(data);
-                        
-                        if (!B2_IS_NULL(bodyId)) {
-                            // Restore body type
-                            b2Body_SetType(bodyId, originalType);
-                            // Restore velocities
-                            b2Body_SetLinearVelocity(bodyId, originalLinearVel);
-                            b2Body_SetAngularVelocity(bodyId, originalAngularVel);
+                // --- Gameplay Events (flag, tremplin...) ---
+                // While rewinding the world is not stepped: the events are those of the last step
+                if (!levelCompleted && !rewinding) {
+                    TRACE_ZONE("Sensor events");
+                    events.dispatch(worldId, gameObjects);
+                }
+
+                // --- Particles ---
+                // World particles stop with the world: under time freeze and while rewinding
+                {
+                    TRACE_ZONE("Particles");
+                    particles.setParticleCap(static_cast<std::size_t>(quality.settings().particleCap));
+                    particles.update(dt, timeFreeze || rewinding);
+                }
+
+                // --- Deferred Destruction ---
+                // Debris that fell off the map and objects marked by the events are destroyed together
+                {
+                    TRACE_ZONE("Destroy objects");
+                    destruction.destroyFallen(gameObjects, KILL_PLANE_Y_M);
+                    if (destruction.flush(gameObjects)) {
+                        // Objects were swap-removed: indices and cached layers are stale
+                        playerIndex = destruction.remapIndex(playerIndex);
+                        renderThread.waitUntilDrawn(); // Released tiles may still be in use
+                        staticLayer.resync(gameObjects);
+                        frozenScene.invalidate();
+                        if (wasInTimeFreeze) {
+                            trajectoryPreview.capture(worldId, gameObjects, playerBodyId, worldFreezer);
                         }
                     }
-                    frozenBodyData.clear();
                 }
-                wasInFreeze = timeFreeze;
-                
-                // --- Sensor Event Handling for Flag and Tremplin ---
-                if (!levelCompleted) {
-                    b2SensorEvents sensorEvents = b2World_GetSensorEvents(worldId);
-                    
-                    for (int i = 0; i < sensorEvents.beginCount; ++i) {
-                        b2SensorBeginTouchEvent event = sensorEvents.beginEvents[i];
-                        GameObject* objA = findGameObjectByShapeId(event.sensorShapeId, gameObjects); // Shape that is the sensor
-                        GameObject* objB = findGameObjectByShapeId(event.visitorShapeId, gameObjects); // Shape that entered the sensor
-
-                        if (objA && objB) {
-                            bool playerHitFlag = false;
-                            // Check if one is player and the other is the flag sensor
-                            // Case 1: objA is the flag sensor, objB is the player
-                            if (objA->isFlag_prop_ && objA->isSensor_prop_ && objB->isPlayer) {
-                                playerHitFlag = true;
-                            } 
-                            // Case 2: objB is the flag sensor, objA is the player
-                            else if (objB->isFlag_prop_ && objB->isSensor_prop_ && objA->isPlayer) {
-                                playerHitFlag = true;
-                            }
 
-                            if (playerHitFlag) {
-                                std::cout << "Level completed !" << std::endl;
-                                levelCompleted = true;
-                                // Optional: Add further game end logic here (e.g., stop player, show message on screen)
+                // --- Level Streaming ---
+                if (!streamer.empty() && !B2_IS_NULL(playerBodyId)) {
+                    TRACE_ZONE("Level streaming");
+                    if (streamer.update(worldId, gameObjects, b2Body_GetPosition(playerBodyId).x)) {
+                        // Objects were removed and/or appended: indices and cached layers are stale
+                        playerIndex = -1;
+                        for (size_t i = 0; i < gameObjects.size(); ++i) {
+                            if (B2_ID_EQUALS(gameObjects[i].bodyId, playerBodyId)) {
+                                playerIndex = static_cast<int>(i);
                             }
                         }
-                        if (objA && objB) {
-                            if (objA->isTremplin_prop_ && objA->isSensor_prop_ && objB->isDynamic_val_ && !objB->isPlayer_prop_) {
-                                b2Vec2 impulse = {0.f, 1.5f};
-                                objB->setPendingImpulsion(impulse);
-                            }
-                            else if (objB->isTremplin_prop_ && objB->isSensor_prop_ && objA->isDynamic_val_) {
-                                b2Vec2 impulse = {0, 10.0f};
-                                objA->setPendingImpulsion(impulse);
-                            }
+                        renderThread.waitUntilDrawn(); // Released tiles may still be in use
+                        staticLayer.resync(gameObjects);
+                        frozenScene.invalidate();
+
+                        // Chunks streamed in during a freeze must be frozen like the rest of the world.
+                        // Bodies frozen earlier are already static, so only the new ones are caught here.
+                        if (wasInTimeFreeze) {
+                            worldFreezer.freezeNew(gameObjects, playerBodyId);
+                            trajectoryPreview.capture(worldId, gameObjects, playerBodyId, worldFreezer);
                         }
                     }
-                    // Note: You might also want to handle sensorEvents.endEvents if needed
                 }
 
 
@@ -464,14 +569,34 @@ int main() {
                 }
 
                 // --- Update SFML Graphics ---
+                // Once the freeze has been applied every non-player body is static:
+                // their shapes cannot change, so only the player needs updating.
+                bool worldFrozen = timeFreeze && wasInTimeFreeze;
+                if (!worldFrozen) {
+                    frozenScene.invalidate();
+                }
 
-                for (auto& obj : gameObjects) {
-                    obj.updateShape();
+                TRACE_ZONE_BEGIN(updateShapeZone, "updateShape");
+                for (size_t i = 0; i < gameObjects.size(); ++i) {
+                    if (worldFrozen && static_cast<int>(i) != playerIndex) continue;
+                    if (gameObjects[i].drawnAsQuad()) {
+                        // Drawn from its body transform by the renderer's batch
+                        gameObjects[i].applyPendingImpulsion();
+                    } else if (!staticLayer.isCached(gameObjects[i])) {
+                        gameObjects[i].updateShape();
+                    }
                 }
+                TRACE_ZONE_END(updateShapeZone);
 
-                if (level == 1) {
-                    updateMap1(worldId, gameObjects, timeFreeze);
+                int64_t renderWaitNs = InputQueue::nowNs();
+                {
+                    // The previous frame must be drawn before its cached layers change
+                    TRACE_ZONE("Wait for render thread");
+                    renderThread.waitUntilDrawn();
                 }
+                renderWaitNs = InputQueue::nowNs() - renderWaitNs;
+                staticLayer.sync(gameObjects);
+                frozenScene.setResolutionScale(quality.settings().offscreenScale);
 
                 // --- Camera Follow Player ---
                 if (!B2_IS_NULL(playerBodyId)) {
@@ -480,84 +605,41 @@ int main() {
                     view.setCenter(center);
                 }
 
-                // Parallax background
-                const float backgroundParallaxFactor = 0.1f;
-                const float cloudParallaxFactor = 0.2f;
+                // --- Rendering ---
+                TRACE_ZONE_BEGIN(captureZone, "Capture scene");
                 const float cloudDriftSpeed = 0.005f; // Pixels per millisecond drift speed
-                sf::Vector2f viewTopLeft = view.getCenter() - view.getSize();
-
-                backgroundShape.setPosition(viewTopLeft);
-                backgroundShape.setSize(view.getSize() * 5.0f);
-                sf::Rect<int> bgTextureRect(
-                    sf::Vector2i(
-                        static_cast<int>(view.getCenter().x * backgroundParallaxFactor),
-                        static_cast<int>(view.getCenter().y * backgroundParallaxFactor)
-                    ),
-                    sf::Vector2i(
-                        static_cast<int>(view.getSize().x),
-                        static_cast<int>(view.getSize().y)
-                    )
-                );
-                backgroundShape.setTextureRect(bgTextureRect);
-
-                cloudShape.setPosition(viewTopLeft);
-                cloudShape.setSize(view.getSize() * 5.0f);
-                // Add time-based drift to cloud movement
-                float cloudDriftOffset;
+                SceneFrame sceneFrame;
+                sceneFrame.view = view;
                 if (cloudClockPaused) {
-                    cloudDriftOffset = cloudPausedTime.asMilliseconds() * cloudDriftSpeed;
+                    sceneFrame.cloudDriftOffset = cloudPausedTime.asMilliseconds() * cloudDriftSpeed;
                 } else {
-                    cloudDriftOffset = (cloudPausedTime + cloudClock.getElapsedTime()).asMilliseconds() * cloudDriftSpeed;
+                    sceneFrame.cloudDriftOffset = (cloudPausedTime + cloudClock.getElapsedTime()).asMilliseconds() * cloudDriftSpeed;
                 }
-                sf::Rect<int> cloudTextureRect(
-                    sf::Vector2i(
-                        static_cast<int>(view.getCenter().x * cloudParallaxFactor + cloudDriftOffset),
-                        static_cast<int>(view.getCenter().y * cloudParallaxFactor)
-                    ),
-                    sf::Vector2i(
-                        static_cast<int>(view.getSize().x),
-                        static_cast<int>(view.getSize().y)
-                    )
-                );
-                cloudShape.setTextureRect(cloudTextureRect);
-
-                window.setView(view); 
-
-                // --- Rendering ---
-                window.clear(sf::Color(135, 206, 235));
-                window.draw(backgroundShape);
-                window.draw(cloudShape);
-
-                // Draw all game objects
-                for (size_t i = 0; i < gameObjects.size(); ++i) {
-                    if (i != playerIndex) {  // Don't draw player yet
-                        gameObjects[i].draw(window);
-                    }
+                sceneFrame.worldFrozen = worldFrozen;
+                sceneFrame.timeFreezeOverlayAlpha = timeFreezeOverlayAlpha;
+                sceneFrame.transitionAlpha = transitionAlpha;
+                sceneFrame.showInstructions = (level == 1);
+                sceneFrame.parallaxLayers = quality.settings().parallaxLayers;
+                RenderStats::instance().beginFrame();
+                sceneRenderer.capture(renderThread.backSnapshot(), sceneFrame, gameObjects, playerIndex);
+                if (worldFrozen) {
+                    renderThread.backSnapshot().trajectories = trajectoryPreview.paths();
                 }
-                window.setView(window.getDefaultView());
-                
-                if (timeFreezeOverlayAlpha > 0.0f) {
-                    window.draw(timeFreezeOverlay);
+                particles.writeBatches(renderThread.backSnapshot().particles);
+                if (physicsDebug.anyEnabled() && quality.settings().debugOverlays) {
+                    TRACE_ZONE("Physics debug draw");
+                    physicsDebug.capture(worldId, view, renderThread.backSnapshot().physicsDebug);
                 }
-
-                // --- Draw Instruction Text for Level 1 ---
-                if (level == 1) {
-                    window.draw(instructionText);
+                renderThread.backSnapshot().timing = frameTiming;
+                renderThread.submit(); // Drawn and presented while the next frame is simulated
+                TRACE_ZONE_END(captureZone);
+
+                // --- Quality Governor ---
+                float simulationMs = static_cast<float>(InputQueue::nowNs() - frameWorkStartNs - renderWaitNs) * 1e-6f;
+                if (quality.addFrame(simulationMs, renderThread.lastDrawMs(), physicsDebug.anyEnabled())) {
+                    subSteps = quality.settings().physicsSubSteps;
                 }
 
-                window.setView(view); 
-
-                if (playerIndex != -1) {
-                    gameObjects[playerIndex].draw(window);
-                }
-                window.setView(window.getDefaultView());
-                
-                if (isTransitioning || transitionAlpha > 0) {
-                    window.draw(transitionOverlay);
-                }
-
-                window.display();
-
                 // --- Check for Level Completion or Reset ---
                 if (levelCompleted || levelReset) {
                     isTransitioning = true;
@@ -565,7 +647,28 @@ int main() {
                 }
             }
             // Reset gameObjects for the next level
-            gameObjects.clear();
+            LOG_INFO(LogCategory::Memory) << "Level arena: " << levelArena.usedBytes() << " bytes in "
+                                          << levelArena.allocationCount() << " allocations (peak " << levelArena.peakBytes() << ")";
+            MemoryTracker::instance().report(std::cout, worldId);
+            gameObjects = GameObjectList(ArenaAllocator<GameObject>(&levelArena)); // Destroys the objects, keeps no storage
+            renderThread.waitUntilDrawn();
+            staticLayer.clear();
+            frozenScene.invalidate();
+            streamer.clear();
+            physicsLod.clear();
+            events.printStats(std::cout);
+            events.clear();
+            particles.clear();
+            InputLatencyStats inputLatency = input.latencyStats();
+            LOG_INFO(LogCategory::Gameplay) << "Input latency: " << inputLatency.averageMs << " ms average, "
+                                            << inputLatency.maxMs << " ms max over " << inputLatency.presses << " presses";
+            input.resetLatencyStats();
+            LatencySamples inputToPhoton = renderThread.takeInputToPhoton();
+            LOG_INFO(LogCategory::Render) << "Input to photon (" << (framePacer.lowLatency() ? "low-latency" : "default")
+                                          << " presentation): p50 " << inputToPhoton.percentile(0.5f) << " ms, p90 "
+                                          << inputToPhoton.percentile(0.9f) << " ms, p99 " << inputToPhoton.percentile(0.99f)
+                                          << " ms over " << inputToPhoton.count() << " frames, "
+                                          << framePacer.missedDeadlines() << " missed deadlines";
             playerBodyId = b2_nullBodyId;
             playerIndex = -1;
             levelCompleted = false; // Reset for the next level
@@ -573,14 +676,20 @@ int main() {
             // Reset time freeze state
             timeFreeze = false;
             wasInTimeFreeze = false;
-            frozenBodyData.clear();
+            worldFreezer.clear();
+            trajectoryPreview.cancel();
+            timeRewind.clear(); // Refers to bodies of the destroyed world
+            timeZones.clear();
+            timers.clear(); // Spawners and pending cues belong to the level
             
             // Reset Freeze overlay state
             isTimeFreezeTransitioning = false;
             isTimeFreezeOverlayFadingIn = false;
             isTimeFreezeOverlayFadingOut = false;
             timeFreezeOverlayAlpha = 0.0f;
-            timeFreezeOverlay.setFillColor(sf::Color(100, 150, 255, 0)); // Reset to transparent
+
+            // Nothing lives in the arena anymore: release the whole level at once
+            levelArena.reset();
 
 
 
@@ -591,6 +700,9 @@ int main() {
             cloudClock.restart(); // Reset cloud clock for next level
 
         }
+    // The last frames of every thread can be opened in chrome://tracing or Perfetto
+    TRACE_EXPORT("chrono2d_trace.json");
+
     // --- Cleanup ---
     // Destroy the Box2D world and all bodies/shapes within it.
     if (!B2_IS_NULL(worldId)) {
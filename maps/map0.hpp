@@ -4,10 +4,11 @@
 #include <SFML/Graphics.hpp>
 #include <box2d/box2d.h>
 #include "../include/game_object.hpp" // Includes utils.hpp and constants.hpp
+#include "../include/logger.hpp"
 #include "../include/primitives/rope.hpp"      // For createSegmentedRope
 #include "../include/primitives/flag.hpp"      // For createFlag
+#include "../include/primitives/anchor.hpp"    // For createAnchor
 #include <vector>
-#include <iostream> // For std::cout, std::cerr
 #include <cmath>    // For b2Distance, M_PI / b2_pi
 
 /**
@@ -20,7 +21,7 @@
  * @return The index of the player GameObject in the gameObjects vector, or -1 if not created.
  */
 inline int loadMap0(b2WorldId worldId,
-                     std::vector<GameObject>& gameObjects,
+                     GameObjectList& gameObjects,
                      b2BodyId& playerBodyId) { 
 
     playerBodyId = b2_nullBodyId;
@@ -44,7 +45,7 @@ inline int loadMap0(b2WorldId worldId,
         if (groundObj.finalize(worldId)) {
             gameObjects.push_back(groundObj);
         } else {
-            std::cerr << "Failed to create ground object in map1." << std::endl;
+            LOG_ERROR(LogCategory::Loading) << "Failed to create ground object in map1.";
         }
     }
 
@@ -73,7 +74,7 @@ inline int loadMap0(b2WorldId worldId,
             gameObjects.push_back(playerObj);
             playerIndex = static_cast<int>(gameObjects.size() - 1);
         } else {
-            std::cerr << "Failed to create player object in map1." << std::endl;
+            LOG_ERROR(LogCategory::Loading) << "Failed to create player object in map1.";
             playerIndex = -1; 
         }
     }
@@ -105,7 +106,7 @@ inline int loadMap0(b2WorldId worldId,
         if (boxObj.finalize(worldId)) {
             gameObjects.push_back(boxObj);
         } else {
-            std::cerr << "Failed to create pushable box object in map1." << std::endl;
+            LOG_ERROR(LogCategory::Loading) << "Failed to create pushable box object in map1.";
         }
     }
 
@@ -143,26 +144,14 @@ inline int loadMap0(b2WorldId worldId,
                 b2Body_SetMassData(platformBodyId, massData);
             }
         } else {
-            std::cerr << "Failed to create hanging platform object in map1." << std::endl;
+            LOG_ERROR(LogCategory::Loading) << "Failed to create hanging platform object in map1.";
         }
     }
     
     // --- Create Segmented Rope for Hanging Platform ---
-    b2BodyId hangingAnchorBodyId = b2_nullBodyId;
-    {
-        GameObject anchorObj;
-        anchorObj.setPosition(pixelsToMeters(1500), pixelsToMeters(500));
-        anchorObj.setSize(pixelsToMeters(1), pixelsToMeters(1)); // Small, effectively invisible
-        anchorObj.setDynamic(false);
-        anchorObj.setColor(sf::Color::Transparent); // Invisible
-        // Default collision: CATEGORY_WORLD, MASK_PLAYER | CATEGORY_WORLD. Fine for a static anchor.
-        // Not jumpable, not player.
-        if (anchorObj.finalize(worldId)) {
-            gameObjects.push_back(anchorObj);
-            hangingAnchorBodyId = anchorObj.bodyId;
-        } else {
-            std::cerr << "Failed to create hanging anchor for rope." << std::endl;
-        }
+    b2BodyId hangingAnchorBodyId = createAnchor(worldId, gameObjects, pixelsToMeters(1500), pixelsToMeters(500));
+    if (B2_IS_NULL(hangingAnchorBodyId)) {
+        LOG_ERROR(LogCategory::Loading) << "Failed to create hanging anchor for rope.";
     }
 
     const int numRopeSegments = 10;
@@ -189,34 +178,14 @@ inline int loadMap0(b2WorldId worldId,
     b2Vec2 leftAnchorPosWorld  = { pixelsToMeters(100), pixelsToMeters(200) };
     b2Vec2 rightAnchorPosWorld = { pixelsToMeters(800), pixelsToMeters(200) };
 
-    b2BodyId leftBridgeAnchorBodyId = b2_nullBodyId;
-    {
-        GameObject anchorObj;
-        anchorObj.setPosition(leftAnchorPosWorld.x, leftAnchorPosWorld.y);
-        anchorObj.setSize(pixelsToMeters(1), pixelsToMeters(1));
-        anchorObj.setDynamic(false);
-        anchorObj.setColor(sf::Color::Transparent);
-        if (anchorObj.finalize(worldId)) {
-            gameObjects.push_back(anchorObj);
-            leftBridgeAnchorBodyId = anchorObj.bodyId;
-        } else {
-            std::cerr << "Failed to create left bridge anchor." << std::endl;
-        }
+    b2BodyId leftBridgeAnchorBodyId = createAnchor(worldId, gameObjects, leftAnchorPosWorld.x, leftAnchorPosWorld.y);
+    if (B2_IS_NULL(leftBridgeAnchorBodyId)) {
+        LOG_ERROR(LogCategory::Loading) << "Failed to create left bridge anchor.";
     }
 
-    b2BodyId rightBridgeAnchorBodyId = b2_nullBodyId;
-    {
-        GameObject anchorObj;
-        anchorObj.setPosition(rightAnchorPosWorld.x, rightAnchorPosWorld.y);
-        anchorObj.setSize(pixelsToMeters(1), pixelsToMeters(1));
-        anchorObj.setDynamic(false);
-        anchorObj.setColor(sf::Color::Transparent);
-        if (anchorObj.finalize(worldId)) {
-            gameObjects.push_back(anchorObj);
-            rightBridgeAnchorBodyId = anchorObj.bodyId;
-        } else {
-            std::cerr << "Failed to create right bridge anchor." << std::endl;
-        }
+    b2BodyId rightBridgeAnchorBodyId = createAnchor(worldId, gameObjects, rightAnchorPosWorld.x, rightAnchorPosWorld.y);
+    if (B2_IS_NULL(rightBridgeAnchorBodyId)) {
+        LOG_ERROR(LogCategory::Loading) << "Failed to create right bridge anchor.";
     }
 
     float hSegmentThickness = pixelsToMeters(3); 
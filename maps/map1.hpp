@@ -4,25 +4,31 @@
 #include <SFML/Graphics.hpp>
 #include <box2d/box2d.h>
 #include "../include/game_object.hpp" // Includes utils.hpp and constants.hpp
+#include "../include/logger.hpp"
+#include "../include/prefab.hpp"        // For map1BoxPrefab
+#include "../include/timer_wheel.hpp"   // For startMap1Spawner
 #include "../include/primitives/rope.hpp"      // For createSegmentedRope
 #include "../include/primitives/flag.hpp"      // For createFlag
+#include "../include/primitives/time_zone.hpp" // For createTimeDilationZone
 #include <vector>
-#include <iostream> // For std::cout, std::cerr
 #include <cmath>    // For b2Distance, M_PI / b2_pi
-#include <chrono>   // For timing
 
 /**
  * @brief Loads the game objects for Map 1 into the world.
  * This includes the ground with a big hole in the middle, player, 
- * and a box spawning system that drops boxes every second.
+ * a box spawning system that drops boxes every second, and two time zones
+ * over the hole: boxes of the left column drift down slowly through one, and the
+ * other, a freeze band between the two columns, holds whatever is knocked into it.
  * @param worldId The ID of the Box2D world.
  * @param gameObjects A reference to the vector that will store all created GameObjects.
  * @param playerBodyId A reference to store the b2BodyId of the created player object.
+ * @param timeZones The level's time-dilation zones, filled by the map.
  * @return The index of the player GameObject in the gameObjects vector, or -1 if not created.
  */
 inline int loadMap1(b2WorldId worldId,
-                     std::vector<GameObject>& gameObjects,
-                     b2BodyId& playerBodyId) { 
+                     GameObjectList& gameObjects,
+                     b2BodyId& playerBodyId,
+                     TimeDilationZones& timeZones) { 
 
     playerBodyId = b2_nullBodyId;
     int playerIndex = -1;
@@ -50,7 +56,7 @@ inline int loadMap1(b2WorldId worldId,
             gameObjects.push_back(playerObj);
             playerIndex = static_cast<int>(gameObjects.size() - 1);
         } else {
-            std::cerr << "Failed to create player object in map1." << std::endl;
+            LOG_ERROR(LogCategory::Loading) << "Failed to create player object in map1.";
             playerIndex = -1; 
         }
     }
@@ -73,7 +79,7 @@ inline int loadMap1(b2WorldId worldId,
         if (leftGroundObj.finalize(worldId)) {
             gameObjects.push_back(leftGroundObj);
         } else {
-            std::cerr << "Failed to create left ground object in map1." << std::endl;
+            LOG_ERROR(LogCategory::Loading) << "Failed to create left ground object in map1.";
         }
     }
 
@@ -96,10 +102,17 @@ inline int loadMap1(b2WorldId worldId,
         if (rightGroundObj.finalize(worldId)) {
             gameObjects.push_back(rightGroundObj);
         } else {
-            std::cerr << "Failed to create right ground object in map1." << std::endl;
+            LOG_ERROR(LogCategory::Loading) << "Failed to create right ground object in map1.";
         }
     }
 
+    // Time zones over the hole (see spawnMap1Boxes). The freeze band stays out of both box
+    // columns: the rain never stops, so boxes frozen under it would pile up all session.
+    createTimeDilationZone(worldId, gameObjects, timeZones, pixelsToMeters(500), pixelsToMeters(250),
+                           pixelsToMeters(260), pixelsToMeters(300), 0.3f);
+    createTimeDilationZone(worldId, gameObjects, timeZones, pixelsToMeters(750), pixelsToMeters(-60),
+                           pixelsToMeters(260), pixelsToMeters(120), 0.0f);
+
     // Flag
     float flagX_m = pixelsToMeters(1700.0f);
     float flagY_m = pixelsToMeters(0.0f);
@@ -110,74 +123,62 @@ inline int loadMap1(b2WorldId worldId,
 }
 
 /**
- * @brief Updates the map1 spawning system. Call this every frame.
+ * @brief The falling box of map1, prepared once and shared by every spawn.
+ */
+inline const Prefab& map1BoxPrefab() {
+    static const Prefab prefab = [] {
+        GameObject boxObj;
+        float boxSizeM = pixelsToMeters(80);
+        boxObj.setSize(boxSizeM, boxSizeM);
+        boxObj.setDynamic(true);
+        boxObj.setColor(sf::Color::Red);
+        boxObj.setSpriteTexturePath("../assets/objects/box.png");
+        boxObj.setLinearDamping(0.1f);
+        boxObj.setDensity(0.5f);
+        boxObj.setFriction(0.7f);
+        boxObj.setRestitution(0.0f);
+        boxObj.setIsPlayerProperty(false);
+        boxObj.setCanJumpOnProperty(true);
+        boxObj.setCollidesWithPlayerProperty(true);
+        return Prefab(boxObj);
+    }();
+    return prefab;
+}
+
+/**
+ * @brief Drops one pair of boxes above map1's platforms (one per side of the hole).
  * @param worldId The ID of the Box2D world.
  * @param gameObjects A reference to the vector that stores all GameObjects.
- * @param timeFreeze A boolean indicating whether time is currently frozen.
  */
-inline void updateMap1(b2WorldId worldId, std::vector<GameObject>& gameObjects, bool timeFreeze) {
-    static auto lastSpawnTime = std::chrono::steady_clock::now();
-    auto currentTime = std::chrono::steady_clock::now();
-    auto timeSinceLastSpawn = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - lastSpawnTime);
-    
-    // Spawn boxes every 1000ms (1 second)
-    if (!timeFreeze && timeSinceLastSpawn.count() >= 1000) {
-        float boxSizeM = pixelsToMeters(80);
-        
-        // Spawn first box
-        {
-            GameObject boxObj;
-            float spawnX = pixelsToMeters(450 + (rand() % 100)); // Random X between 450-550 pixels
-            float spawnY = pixelsToMeters(800); // High above the platform
-            
-            boxObj.setPosition(spawnX, spawnY);
-            boxObj.setSize(boxSizeM, boxSizeM);
-            boxObj.setDynamic(true);
-            boxObj.setColor(sf::Color::Red);
-            boxObj.setSpriteTexturePath("../assets/objects/box.png");
-            boxObj.setLinearDamping(0.1f);  
-            boxObj.setDensity(0.5f);
-            boxObj.setFriction(0.7f);   
-            boxObj.setRestitution(0.0f);    
-            boxObj.setIsPlayerProperty(false);
-            boxObj.setCanJumpOnProperty(true);
-            boxObj.setCollidesWithPlayerProperty(true);
-
-            if (boxObj.finalize(worldId)) {
-                gameObjects.push_back(boxObj);
-            } else {
-                std::cerr << "Failed to create first falling box in map1." << std::endl;
-            }
-        }
-        
-        // Spawn second box 1000 pixels later
-        {
-            GameObject boxObj2;
-            float spawnX2 = pixelsToMeters(450 + (rand() % 100) + 500); // Random X between 1450-1550 pixels
-            float spawnY2 = pixelsToMeters(800); // High above the platform
-            
-            boxObj2.setPosition(spawnX2, spawnY2);
-            boxObj2.setSize(boxSizeM, boxSizeM);
-            boxObj2.setDynamic(true);
-            boxObj2.setColor(sf::Color::Red);
-            boxObj2.setSpriteTexturePath("../assets/objects/box.png");
-            boxObj2.setLinearDamping(0.1f);  
-            boxObj2.setDensity(0.5f);
-            boxObj2.setFriction(0.7f);   
-            boxObj2.setRestitution(0.0f);    
-            boxObj2.setIsPlayerProperty(false);
-            boxObj2.setCanJumpOnProperty(true);
-            boxObj2.setCollidesWithPlayerProperty(true);
-
-            if (boxObj2.finalize(worldId)) {
-                gameObjects.push_back(boxObj2);
-            } else {
-                std::cerr << "Failed to create second falling box in map1." << std::endl;
-            }
-        }
-        
-        lastSpawnTime = currentTime;
+inline void spawnMap1Boxes(b2WorldId worldId, GameObjectList& gameObjects) {
+    const Prefab& boxPrefab = map1BoxPrefab();
+    float spawnY = pixelsToMeters(800); // High above the platform
+
+    // First box
+    float spawnX = pixelsToMeters(450 + (rand() % 100)); // Random X between 450-550 pixels
+    if (B2_IS_NULL(boxPrefab.spawn(worldId, gameObjects, spawnX, spawnY))) {
+        LOG_ERROR(LogCategory::Loading) << "Failed to create first falling box in map1.";
     }
+
+    // Second box, 500 pixels further right
+    float spawnX2 = pixelsToMeters(450 + (rand() % 100) + 500); // Random X between 950-1050 pixels
+    if (B2_IS_NULL(boxPrefab.spawn(worldId, gameObjects, spawnX2, spawnY))) {
+        LOG_ERROR(LogCategory::Loading) << "Failed to create second falling box in map1.";
+    }
+}
+
+/**
+ * @brief Starts map1's box rain on the level's timers: a pair of boxes every
+ * MAP1_SPAWN_PERIOD_STEPS simulation steps, so it pauses while time is frozen or rewound.
+ * @param timers The level's gameplay timers, cleared with the level.
+ * @param worldId The ID of the Box2D world.
+ * @param gameObjects A reference to the vector that stores all GameObjects.
+ * @return The spawner's timer, to stop the rain early.
+ */
+inline TimerId startMap1Spawner(TimerWheel& timers, b2WorldId worldId, GameObjectList& gameObjects) {
+    return timers.scheduleRepeating(MAP1_SPAWN_PERIOD_STEPS, [worldId, &gameObjects]() {
+        spawnMap1Boxes(worldId, gameObjects);
+    });
 }
 
 #endif // MAP1_HPP
\ No newline at end of file
@@ -4,11 +4,11 @@
 #include <SFML/Graphics.hpp>
 #include <box2d/box2d.h>
 #include "../include/game_object.hpp" // Includes utils.hpp and constants.hpp
+#include "../include/logger.hpp"
 #include "../include/primitives/rope.hpp"      // For createSegmentedRope
 #include "../include/primitives/flag.hpp"      // For createFlag
 #include "../include/primitives/tremplin.hpp" // For createTremplin
 #include <vector>
-#include <iostream> // For std::cout, std::cerr
 #include <cmath>    // For b2Distance, M_PI / b2_pi
 
 /**
@@ -21,7 +21,7 @@
  * @return The index of the player GameObject in the gameObjects vector, or -1 if not created.
  */
 inline int loadMap2(b2WorldId worldId,
-                     std::vector<GameObject>& gameObjects,
+                     GameObjectList& gameObjects,
                      b2BodyId& playerBodyId) { 
 
     playerBodyId = b2_nullBodyId;
@@ -45,7 +45,7 @@ inline int loadMap2(b2WorldId worldId,
         if (groundObj.finalize(worldId)) {
             gameObjects.push_back(groundObj);
         } else {
-            std::cerr << "Failed to create ground object in map2." << std::endl;
+            LOG_ERROR(LogCategory::Loading) << "Failed to create ground object in map2.";
         }
     }
 
@@ -66,7 +66,7 @@ inline int loadMap2(b2WorldId worldId,
         if (wallObj.finalize(worldId)) {
             gameObjects.push_back(wallObj);
         } else {
-            std::cerr << "Failed to create wall object in map2." << std::endl;
+            LOG_ERROR(LogCategory::Loading) << "Failed to create wall object in map2.";
         }
     }
 
@@ -95,7 +95,7 @@ inline int loadMap2(b2WorldId worldId,
             gameObjects.push_back(playerObj);
             playerIndex = static_cast<int>(gameObjects.size() - 1);
         } else {
-            std::cerr << "Failed to create player object in map2." << std::endl;
+            LOG_ERROR(LogCategory::Loading) << "Failed to create player object in map2.";
             playerIndex = -1; 
         }
     }
@@ -122,7 +122,7 @@ inline int loadMap2(b2WorldId worldId,
         if (boxObj.finalize(worldId)) {
             gameObjects.push_back(boxObj);
         } else {
-            std::cerr << "Failed to create pushable box object in map2." << std::endl;
+            LOG_ERROR(LogCategory::Loading) << "Failed to create pushable box object in map2.";
         }
     }
 
@@ -159,7 +159,7 @@ inline int loadMap2(b2WorldId worldId,
                 b2Body_SetMassData(platformBodyId, massData);
             }
         } else {
-            std::cerr << "Failed to create hanging platform object in map2." << std::endl;
+            LOG_ERROR(LogCategory::Loading) << "Failed to create hanging platform object in map2.";
         }
     }
     // --- End Platform ---
@@ -4,10 +4,10 @@
 #include <SFML/Graphics.hpp>
 #include <box2d/box2d.h>
 #include "../include/game_object.hpp" // Includes utils.hpp and constants.hpp
+#include "../include/logger.hpp"
 #include "../include/primitives/rope.hpp"      // For createSegmentedRope
 #include "../include/primitives/flag.hpp"      // For createFlag
 #include <vector>
-#include <iostream> // For std::cout, std::cerr
 #include <cmath>    // For b2Distance, M_PI / b2_pi
 
 /**
@@ -20,7 +20,7 @@
  * @return The index of the player GameObject in the gameObjects vector, or -1 if not created.
  */
 inline int loadMap3(b2WorldId worldId,
-                     std::vector<GameObject>& gameObjects,
+                     GameObjectList& gameObjects,
                      b2BodyId& playerBodyId) { 
 
     playerBodyId = b2_nullBodyId;
@@ -44,7 +44,7 @@ inline int loadMap3(b2WorldId worldId,
         if (groundObj.finalize(worldId)) {
             gameObjects.push_back(groundObj);
         } else {
-            std::cerr << "Failed to create ground object in map1." << std::endl;
+            LOG_ERROR(LogCategory::Loading) << "Failed to create ground object in map1.";
         }
     }
     // Leftest Wall
@@ -65,7 +65,7 @@ inline int loadMap3(b2WorldId worldId,
         if (groundObj.finalize(worldId)) {
             gameObjects.push_back(groundObj);
         } else {
-            std::cerr << "Failed to create ground object in map1." << std::endl;
+            LOG_ERROR(LogCategory::Loading) << "Failed to create ground object in map1.";
         }
     }
         // Right Wall
@@ -86,7 +86,7 @@ inline int loadMap3(b2WorldId worldId,
         if (groundObj.finalize(worldId)) {
             gameObjects.push_back(groundObj);
         } else {
-            std::cerr << "Failed to create ground object in map1." << std::endl;
+            LOG_ERROR(LogCategory::Loading) << "Failed to create ground object in map1.";
         }
     }
 
@@ -111,7 +111,7 @@ inline int loadMap3(b2WorldId worldId,
         if (groundObj.finalize(worldId)) {
             gameObjects.push_back(groundObj);
         } else {
-            std::cerr << "Failed to create first ground object in map3." << std::endl;
+            LOG_ERROR(LogCategory::Loading) << "Failed to create first ground object in map3.";
         }
     }
 
@@ -135,7 +135,7 @@ inline int loadMap3(b2WorldId worldId,
         if (groundObj.finalize(worldId)) {
             gameObjects.push_back(groundObj);
         } else {
-            std::cerr << "Failed to create ground object in map1." << std::endl;
+            LOG_ERROR(LogCategory::Loading) << "Failed to create ground object in map1.";
         }
     }
 
@@ -157,7 +157,7 @@ inline int loadMap3(b2WorldId worldId,
         if (groundObj.finalize(worldId)) {
             gameObjects.push_back(groundObj);
         } else {
-            std::cerr << "Failed to create second ground object in map1." << std::endl;
+            LOG_ERROR(LogCategory::Loading) << "Failed to create second ground object in map1.";
         }
     }
 
@@ -186,7 +186,7 @@ inline int loadMap3(b2WorldId worldId,
             gameObjects.push_back(playerObj);
             playerIndex = static_cast<int>(gameObjects.size() - 1);
         } else {
-            std::cerr << "Failed to create player object in map1." << std::endl;
+            LOG_ERROR(LogCategory::Loading) << "Failed to create player object in map1.";
             playerIndex = -1; 
         }
     }
@@ -228,7 +228,7 @@ inline int loadMap3(b2WorldId worldId,
             
             b2CreateRevoluteJoint(worldId, &jointDef);
         } else {
-            std::cerr << "Failed to create balance object in map1." << std::endl;
+            LOG_ERROR(LogCategory::Loading) << "Failed to create balance object in map1.";
         }
     }
 
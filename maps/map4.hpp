@@ -4,14 +4,16 @@
 #include <SFML/Graphics.hpp>
 #include <box2d/box2d.h>
 #include "../include/game_object.hpp" // Includes utils.hpp and constants.hpp
+#include "../include/logger.hpp"
 #include "../include/primitives/rope.hpp"      // For createSegmentedRope
 #include "../include/primitives/flag.hpp"      // For createFlag
+#include "../include/primitives/anchor.hpp"    // For createAnchor
+#include "../include/level_streamer.hpp"       // For LevelStreamer
 #include <vector>
-#include <iostream> // For std::cout, std::cerr
 #include <cmath>    // For b2Distance, M_PI / b2_pi
 
 inline float createHangingPlatformWithRopes(b2WorldId worldId,
-                                            std::vector<GameObject>& gameObjects,
+                                            GameObjectList& gameObjects,
                                             float whereAmI,
                                             float gapBefore,
                                             float platformWidthPx,
@@ -19,9 +21,21 @@ inline float createHangingPlatformWithRopes(b2WorldId worldId,
                                             float anchorPointHeightPx,
                                             sf::Color platformColor = sf::Color(160, 82, 45));
 
+/**
+ * @brief Loads Map 4, a long level streamed in chunks.
+ * Only the player is created immediately; the ground, hanging platforms, stairs,
+ * balance and flag are registered as chunks on the streamer and instantiated when
+ * the player comes near them.
+ * @param worldId The ID of the Box2D world.
+ * @param gameObjects A reference to the vector that will store all created GameObjects.
+ * @param playerBodyId A reference to store the b2BodyId of the created player object.
+ * @param streamer The streamer receiving the level chunks.
+ * @return The index of the player GameObject in the gameObjects vector, or -1 if not created.
+ */
 inline int loadMap4(b2WorldId worldId,
-                    std::vector<GameObject>& gameObjects,
-                    b2BodyId& playerBodyId) 
+                    GameObjectList& gameObjects,
+                    b2BodyId& playerBodyId,
+                    LevelStreamer& streamer) 
 {
     playerBodyId = b2_nullBodyId;
     int playerIndex = -1;
@@ -36,7 +50,8 @@ inline int loadMap4(b2WorldId worldId,
     float whereAmI = 0.0f;
 
     // --- Ground ---
-    {
+    streamer.addChunk(pixelsToMeters(-groundWidth / 2.0f), pixelsToMeters(groundWidth / 2.0f),
+                      [=](b2WorldId worldId, GameObjectList& gameObjects) {
         GameObject groundObj;
         groundObj.setPosition(0.0f, pixelsToMeters(-groundHeight / 2.0f));
         groundObj.setSize(pixelsToMeters(groundWidth), pixelsToMeters(groundHeight));
@@ -49,11 +64,12 @@ inline int loadMap4(b2WorldId worldId,
         groundObj.setCollidesWithPlayerProperty(true);
         groundObj.finalize(worldId);
         gameObjects.push_back(groundObj);
-    }
+    });
     whereAmI += groundWidth / 2.0f;
 
     // --- Left Wall ---
-    {
+    streamer.addChunk(pixelsToMeters(-groundWidth / 2.0f - 200.0f), pixelsToMeters(-groundWidth / 2.0f),
+                      [=](b2WorldId worldId, GameObjectList& gameObjects) {
         GameObject leftWallObj;
         float wallWidth = 200.0f;
         float wallHeight = 2000.0f;
@@ -68,15 +84,20 @@ inline int loadMap4(b2WorldId worldId,
         leftWallObj.setCollidesWithPlayerProperty(true);
         leftWallObj.finalize(worldId);
         gameObjects.push_back(leftWallObj);
-    }
+    });
 
     // --- Hanging Platforms ---
-    whereAmI = createHangingPlatformWithRopes(worldId, gameObjects, whereAmI, firstGap, hangingPlatform_width, hangingPlatform_height, anchorPointHeight);
-    whereAmI = createHangingPlatformWithRopes(worldId, gameObjects, whereAmI, 400.0f, hangingPlatform_width, hangingPlatform_height, anchorPointHeight);
-    whereAmI = createHangingPlatformWithRopes(worldId, gameObjects, whereAmI, 500.0f, hangingPlatform_width, hangingPlatform_height, anchorPointHeight);
+    for (float gap : {firstGap, 400.0f, 500.0f}) {
+        streamer.addChunk(pixelsToMeters(whereAmI + gap), pixelsToMeters(whereAmI + gap + hangingPlatform_width),
+                          [=](b2WorldId worldId, GameObjectList& gameObjects) {
+            createHangingPlatformWithRopes(worldId, gameObjects, whereAmI, gap, hangingPlatform_width, hangingPlatform_height, anchorPointHeight);
+        });
+        whereAmI += gap + hangingPlatform_width; // Same advance as createHangingPlatformWithRopes
+    }
 
     // --- second ground ---
-    {
+    streamer.addChunk(pixelsToMeters(whereAmI + 500.0f), pixelsToMeters(whereAmI + groundWidth + 500.0f),
+                      [=](b2WorldId worldId, GameObjectList& gameObjects) {
         GameObject groundObj;
         groundObj.setPosition(pixelsToMeters(whereAmI + groundWidth / 2.0f + 500.0f), pixelsToMeters(-groundHeight / 2.0f));
         groundObj.setSize(pixelsToMeters(groundWidth), pixelsToMeters(groundHeight));
@@ -89,65 +110,69 @@ inline int loadMap4(b2WorldId worldId,
         groundObj.setCollidesWithPlayerProperty(true);
         groundObj.finalize(worldId);
         gameObjects.push_back(groundObj);
-    }
+    });
 
     whereAmI += groundWidth + 500.0f; // Advance whereAmI by ground width + gap
 
     // --- dynamic rectangle ---
-    {
-        GameObject dynamicRectObj;
-        float dynamicRectWidth = 695.0f;
-        float dynamicRectHeight = 25.0f;
-        dynamicRectObj.setPosition(pixelsToMeters(whereAmI - groundWidth / 2.0f), pixelsToMeters(0.0f));
-        dynamicRectObj.setSize(pixelsToMeters(dynamicRectWidth), pixelsToMeters(dynamicRectHeight));
-        dynamicRectObj.setDynamic(true);
-        dynamicRectObj.setColor(sf::Color(139, 69, 19));
-        dynamicRectObj.setLinearDamping(0.5f);
-        dynamicRectObj.setDensity(1.0f);
-        dynamicRectObj.setFriction(0.7f);
-        dynamicRectObj.setRestitution(0.0f);
-        dynamicRectObj.setIsPlayerProperty(false);
-        dynamicRectObj.setCanJumpOnProperty(true);
-        dynamicRectObj.setCollidesWithPlayerProperty(true);
-        if (dynamicRectObj.finalize(worldId)) {
-            gameObjects.push_back(dynamicRectObj);
+    streamer.addChunk(pixelsToMeters(whereAmI - groundWidth / 2.0f - 695.0f / 2.0f), pixelsToMeters(whereAmI + 710.0f),
+                      [=](b2WorldId worldId, GameObjectList& gameObjects) {
+        {
+            GameObject dynamicRectObj;
+            float dynamicRectWidth = 695.0f;
+            float dynamicRectHeight = 25.0f;
+            dynamicRectObj.setPosition(pixelsToMeters(whereAmI - groundWidth / 2.0f), pixelsToMeters(0.0f));
+            dynamicRectObj.setSize(pixelsToMeters(dynamicRectWidth), pixelsToMeters(dynamicRectHeight));
+            dynamicRectObj.setDynamic(true);
+            dynamicRectObj.setColor(sf::Color(139, 69, 19));
+            dynamicRectObj.setLinearDamping(0.5f);
+            dynamicRectObj.setDensity(1.0f);
+            dynamicRectObj.setFriction(0.7f);
+            dynamicRectObj.setRestitution(0.0f);
+            dynamicRectObj.setIsPlayerProperty(false);
+            dynamicRectObj.setCanJumpOnProperty(true);
+            dynamicRectObj.setCollidesWithPlayerProperty(true);
+            if (dynamicRectObj.finalize(worldId)) {
+                gameObjects.push_back(dynamicRectObj);
+            }
         }
-    }
 
-    // little cube blockers to prevent dynamic rect from falling
-    {
-        GameObject blockerLeftObj;
-        blockerLeftObj.setPosition(pixelsToMeters(whereAmI), pixelsToMeters(-40.0f));
-        blockerLeftObj.setSize(pixelsToMeters(20.0f), pixelsToMeters(20.0f));
-        blockerLeftObj.setDynamic(false);
-        blockerLeftObj.setColor(sf::Color(34, 139, 34));
-        blockerLeftObj.setFriction(0.7f);
-        blockerLeftObj.setRestitution(0.0f);
-        blockerLeftObj.setIsPlayerProperty(false);
-        blockerLeftObj.setCanJumpOnProperty(true);
-        blockerLeftObj.setCollidesWithPlayerProperty(true);
-        blockerLeftObj.finalize(worldId);
-        gameObjects.push_back(blockerLeftObj);
-    }
+        // little cube blockers to prevent dynamic rect from falling
+        {
+            GameObject blockerLeftObj;
+            blockerLeftObj.setPosition(pixelsToMeters(whereAmI), pixelsToMeters(-40.0f));
+            blockerLeftObj.setSize(pixelsToMeters(20.0f), pixelsToMeters(20.0f));
+            blockerLeftObj.setDynamic(false);
+            blockerLeftObj.setColor(sf::Color(34, 139, 34));
+            blockerLeftObj.setFriction(0.7f);
+            blockerLeftObj.setRestitution(0.0f);
+            blockerLeftObj.setIsPlayerProperty(false);
+            blockerLeftObj.setCanJumpOnProperty(true);
+            blockerLeftObj.setCollidesWithPlayerProperty(true);
+            blockerLeftObj.finalize(worldId);
+            gameObjects.push_back(blockerLeftObj);
+        }
 
-    // right blocker
-    {
-        GameObject blockerRightObj;
-        blockerRightObj.setPosition(pixelsToMeters(whereAmI + 700.0f), pixelsToMeters(-40.0f));
-        blockerRightObj.setSize(pixelsToMeters(20.0f), pixelsToMeters(20.0f));
-        blockerRightObj.setDynamic(false);
-        blockerRightObj.setColor(sf::Color(34, 139, 34));
-        blockerRightObj.setFriction(0.7f);
-        blockerRightObj.setRestitution(0.0f);
-        blockerRightObj.setIsPlayerProperty(false);
-        blockerRightObj.setCanJumpOnProperty(true);
-        blockerRightObj.setCollidesWithPlayerProperty(true);
-        blockerRightObj.finalize(worldId);
-        gameObjects.push_back(blockerRightObj);
-    }
+        // right blocker
+        {
+            GameObject blockerRightObj;
+            blockerRightObj.setPosition(pixelsToMeters(whereAmI + 700.0f), pixelsToMeters(-40.0f));
+            blockerRightObj.setSize(pixelsToMeters(20.0f), pixelsToMeters(20.0f));
+            blockerRightObj.setDynamic(false);
+            blockerRightObj.setColor(sf::Color(34, 139, 34));
+            blockerRightObj.setFriction(0.7f);
+            blockerRightObj.setRestitution(0.0f);
+            blockerRightObj.setIsPlayerProperty(false);
+            blockerRightObj.setCanJumpOnProperty(true);
+            blockerRightObj.setCollidesWithPlayerProperty(true);
+            blockerRightObj.finalize(worldId);
+            gameObjects.push_back(blockerRightObj);
+        }
+    });
 
     // --- third ground ---
-    {
+    streamer.addChunk(pixelsToMeters(whereAmI + 700.0f), pixelsToMeters(whereAmI + groundWidth + 700.0f),
+                      [=](b2WorldId worldId, GameObjectList& gameObjects) {
         GameObject groundObj;
         groundObj.setPosition(pixelsToMeters(whereAmI + groundWidth / 2.0f + 700.0f), pixelsToMeters(-groundHeight / 2.0f));
         groundObj.setSize(pixelsToMeters(groundWidth), pixelsToMeters(groundHeight));
@@ -160,99 +185,106 @@ inline int loadMap4(b2WorldId worldId,
         groundObj.setCollidesWithPlayerProperty(true);
         groundObj.finalize(worldId);
         gameObjects.push_back(groundObj);
-    }
+    });
 
     whereAmI += 700.0f;
 
     // small platform up
-    {
-        GameObject stair1Obj;
-        stair1Obj.setPosition(pixelsToMeters(whereAmI + 200.0f), pixelsToMeters(100.0f));
-        stair1Obj.setSize(pixelsToMeters(150.0f), pixelsToMeters(20.0f));
-        stair1Obj.setDynamic(false);
-        stair1Obj.setColor(sf::Color(139, 69, 19));
-        stair1Obj.setFriction(0.7f);
-        stair1Obj.setRestitution(0.0f);
-        stair1Obj.setIsPlayerProperty(false);
-        stair1Obj.setCanJumpOnProperty(true);
-        stair1Obj.setCollidesWithPlayerProperty(true);
-        stair1Obj.finalize(worldId);
-        gameObjects.push_back(stair1Obj);
-    }
+    streamer.addChunk(pixelsToMeters(whereAmI + 125.0f), pixelsToMeters(whereAmI + 675.0f),
+                      [=](b2WorldId worldId, GameObjectList& gameObjects) {
+        {
+            GameObject stair1Obj;
+            stair1Obj.setPosition(pixelsToMeters(whereAmI + 200.0f), pixelsToMeters(100.0f));
+            stair1Obj.setSize(pixelsToMeters(150.0f), pixelsToMeters(20.0f));
+            stair1Obj.setDynamic(false);
+            stair1Obj.setColor(sf::Color(139, 69, 19));
+            stair1Obj.setFriction(0.7f);
+            stair1Obj.setRestitution(0.0f);
+            stair1Obj.setIsPlayerProperty(false);
+            stair1Obj.setCanJumpOnProperty(true);
+            stair1Obj.setCollidesWithPlayerProperty(true);
+            stair1Obj.finalize(worldId);
+            gameObjects.push_back(stair1Obj);
+        }
 
-    // 2nd stair
-    {
-        GameObject stair2Obj;
-        stair2Obj.setPosition(pixelsToMeters(whereAmI + 400.0f), pixelsToMeters(200.0f));
-        stair2Obj.setSize(pixelsToMeters(150.0f), pixelsToMeters(20.0f));
-        stair2Obj.setDynamic(false);
-        stair2Obj.setColor(sf::Color(139, 69, 19));
-        stair2Obj.setFriction(0.7f);
-        stair2Obj.setRestitution(0.0f);
-        stair2Obj.setIsPlayerProperty(false);
-        stair2Obj.setCanJumpOnProperty(true);
-        stair2Obj.setCollidesWithPlayerProperty(true);
-        stair2Obj.finalize(worldId);
-        gameObjects.push_back(stair2Obj);
-    }
+        // 2nd stair
+        {
+            GameObject stair2Obj;
+            stair2Obj.setPosition(pixelsToMeters(whereAmI + 400.0f), pixelsToMeters(200.0f));
+            stair2Obj.setSize(pixelsToMeters(150.0f), pixelsToMeters(20.0f));
+            stair2Obj.setDynamic(false);
+            stair2Obj.setColor(sf::Color(139, 69, 19));
+            stair2Obj.setFriction(0.7f);
+            stair2Obj.setRestitution(0.0f);
+            stair2Obj.setIsPlayerProperty(false);
+            stair2Obj.setCanJumpOnProperty(true);
+            stair2Obj.setCollidesWithPlayerProperty(true);
+            stair2Obj.finalize(worldId);
+            gameObjects.push_back(stair2Obj);
+        }
 
-    // 3rd stair
-    {
-        GameObject stair3Obj;
-        stair3Obj.setPosition(pixelsToMeters(whereAmI + 600.0f), pixelsToMeters(300.0f));
-        stair3Obj.setSize(pixelsToMeters(150.0f), pixelsToMeters(20.0f));
-        stair3Obj.setDynamic(false);
-        stair3Obj.setColor(sf::Color(139, 69, 19));
-        stair3Obj.setFriction(0.7f);
-        stair3Obj.setRestitution(0.0f);
-        stair3Obj.setIsPlayerProperty(false);
-        stair3Obj.setCanJumpOnProperty(true);
-        stair3Obj.setCollidesWithPlayerProperty(true);
-        stair3Obj.finalize(worldId);
-        gameObjects.push_back(stair3Obj);
-    }
+        // 3rd stair
+        {
+            GameObject stair3Obj;
+            stair3Obj.setPosition(pixelsToMeters(whereAmI + 600.0f), pixelsToMeters(300.0f));
+            stair3Obj.setSize(pixelsToMeters(150.0f), pixelsToMeters(20.0f));
+            stair3Obj.setDynamic(false);
+            stair3Obj.setColor(sf::Color(139, 69, 19));
+            stair3Obj.setFriction(0.7f);
+            stair3Obj.setRestitution(0.0f);
+            stair3Obj.setIsPlayerProperty(false);
+            stair3Obj.setCanJumpOnProperty(true);
+            stair3Obj.setCollidesWithPlayerProperty(true);
+            stair3Obj.finalize(worldId);
+            gameObjects.push_back(stair3Obj);
+        }
+    });
 
     float finalPlatformWidth = 500.0f;
     // final platform
-    {
-        GameObject finalPlatformObj;
-        finalPlatformObj.setPosition(pixelsToMeters(whereAmI + 800.0f + finalPlatformWidth / 2.0f), pixelsToMeters(400.0f));
-        finalPlatformObj.setSize(pixelsToMeters(finalPlatformWidth), pixelsToMeters(20.0f));
-        finalPlatformObj.setDynamic(false);
-        finalPlatformObj.setColor(sf::Color(34, 139, 34));
-        finalPlatformObj.setFriction(0.7f);
-        finalPlatformObj.setRestitution(0.0f);
-        finalPlatformObj.setIsPlayerProperty(false);
-        finalPlatformObj.setCanJumpOnProperty(true);
-        finalPlatformObj.setCollidesWithPlayerProperty(true);
-        finalPlatformObj.finalize(worldId);
-        gameObjects.push_back(finalPlatformObj);
-    }
+    streamer.addChunk(pixelsToMeters(whereAmI + 800.0f), pixelsToMeters(whereAmI + 800.0f + finalPlatformWidth),
+                      [=](b2WorldId worldId, GameObjectList& gameObjects) {
+        {
+            GameObject finalPlatformObj;
+            finalPlatformObj.setPosition(pixelsToMeters(whereAmI + 800.0f + finalPlatformWidth / 2.0f), pixelsToMeters(400.0f));
+            finalPlatformObj.setSize(pixelsToMeters(finalPlatformWidth), pixelsToMeters(20.0f));
+            finalPlatformObj.setDynamic(false);
+            finalPlatformObj.setColor(sf::Color(34, 139, 34));
+            finalPlatformObj.setFriction(0.7f);
+            finalPlatformObj.setRestitution(0.0f);
+            finalPlatformObj.setIsPlayerProperty(false);
+            finalPlatformObj.setCanJumpOnProperty(true);
+            finalPlatformObj.setCollidesWithPlayerProperty(true);
+            finalPlatformObj.finalize(worldId);
+            gameObjects.push_back(finalPlatformObj);
+        }
 
-    // put dynamic squre on top of final platform
-    {
-        GameObject dynamicSquareObj;
-        dynamicSquareObj.setPosition(pixelsToMeters(whereAmI + 800.0f + finalPlatformWidth / 2.0f), pixelsToMeters(400.0f + 50.0f));
-        dynamicSquareObj.setSize(pixelsToMeters(50.0f), pixelsToMeters(50.0f));
-        dynamicSquareObj.setDynamic(true);
-        dynamicSquareObj.setColor(sf::Color::Blue);
-        dynamicSquareObj.setSpriteTexturePath("../assets/objects/box.png");
-        dynamicSquareObj.setLinearDamping(1.0f);
-        dynamicSquareObj.setDensity(50.0f);
-        dynamicSquareObj.setFriction(0.0f);
-        dynamicSquareObj.setRestitution(0.0f);
-        dynamicSquareObj.setIsPlayerProperty(false);
-        dynamicSquareObj.setCanJumpOnProperty(true);
-        dynamicSquareObj.setCollidesWithPlayerProperty(true);
-        if (dynamicSquareObj.finalize(worldId)) {
-            gameObjects.push_back(dynamicSquareObj);
+        // put dynamic squre on top of final platform
+        {
+            GameObject dynamicSquareObj;
+            dynamicSquareObj.setPosition(pixelsToMeters(whereAmI + 800.0f + finalPlatformWidth / 2.0f), pixelsToMeters(400.0f + 50.0f));
+            dynamicSquareObj.setSize(pixelsToMeters(50.0f), pixelsToMeters(50.0f));
+            dynamicSquareObj.setDynamic(true);
+            dynamicSquareObj.setColor(sf::Color::Blue);
+            dynamicSquareObj.setSpriteTexturePath("../assets/objects/box.png");
+            dynamicSquareObj.setLinearDamping(1.0f);
+            dynamicSquareObj.setDensity(50.0f);
+            dynamicSquareObj.setFriction(0.0f);
+            dynamicSquareObj.setRestitution(0.0f);
+            dynamicSquareObj.setIsPlayerProperty(false);
+            dynamicSquareObj.setCanJumpOnProperty(true);
+            dynamicSquareObj.setCollidesWithPlayerProperty(true);
+            if (dynamicSquareObj.finalize(worldId)) {
+                gameObjects.push_back(dynamicSquareObj);
+            }
         }
-    }
+    });
 
     whereAmI += 800.0f + finalPlatformWidth; // Advance whereAmI by final platform width
 
     // Balance
-    {
+    streamer.addChunk(pixelsToMeters(whereAmI + 50.0f), pixelsToMeters(whereAmI + 450.0f),
+                      [=](b2WorldId worldId, GameObjectList& gameObjects) {
         GameObject balanceObj;
         float balanceWidthM = 400.0f; // Width in meters
         float balanceHeightM = 20.0f; // Height in meters
@@ -287,15 +319,16 @@ inline int loadMap4(b2WorldId worldId,
             
             b2CreateRevoluteJoint(worldId, &jointDef);
         } else {
-            std::cerr << "Failed to create balance object in map1." << std::endl;
+            LOG_ERROR(LogCategory::Loading) << "Failed to create balance object in map1.";
         }
-    }
+    });
 
     whereAmI += -800.0f - finalPlatformWidth; // Reset whereAmI to the start of the final ground
     whereAmI += groundWidth; // Advance whereAmI by ground width
 
     // create final ground
-    {
+    streamer.addChunk(pixelsToMeters(whereAmI), pixelsToMeters(whereAmI + groundWidth / 3.0f),
+                      [=](b2WorldId worldId, GameObjectList& gameObjects) {
         GameObject finalGroundObj;
         finalGroundObj.setPosition(pixelsToMeters(whereAmI + groundWidth / 6.0f), pixelsToMeters(0.0f));
         finalGroundObj.setSize(pixelsToMeters(groundWidth / 3.0f), pixelsToMeters(400.0f));
@@ -308,7 +341,7 @@ inline int loadMap4(b2WorldId worldId,
         finalGroundObj.setCollidesWithPlayerProperty(true);
         finalGroundObj.finalize(worldId);
         gameObjects.push_back(finalGroundObj);
-    }
+    });
 
     // --- Create Flag ---
     float flagX_m = pixelsToMeters(whereAmI + groundWidth / 6.0f + 50.0f);
@@ -316,7 +349,10 @@ inline int loadMap4(b2WorldId worldId,
     float flagHeight_m_val = pixelsToMeters(120.0f);
     float flagY_m = pixelsToMeters(250.0f + flagHeight_m_val / 2.0f);
     
-    createFlag(worldId, gameObjects, flagX_m, flagY_m);
+    streamer.addChunk(flagX_m, flagX_m,
+                      [=](b2WorldId worldId, GameObjectList& gameObjects) {
+        createFlag(worldId, gameObjects, flagX_m, flagY_m);
+    });
     // --- End Flag Creation ---
 
     // --- Player ---
@@ -344,7 +380,7 @@ inline int loadMap4(b2WorldId worldId,
 }
 
 inline float createHangingPlatformWithRopes(b2WorldId worldId,
-                                            std::vector<GameObject>& gameObjects,
+                                            GameObjectList& gameObjects,
                                             float whereAmI,
                                             float gapBefore,
                                             float platformWidthPx,
@@ -390,42 +426,17 @@ inline float createHangingPlatformWithRopes(b2WorldId worldId,
                 b2Body_SetMassData(platformBodyId, massData);
             }
         } else {
-            std::cerr << "Failed to create hanging platform object." << std::endl;
+            LOG_ERROR(LogCategory::Loading) << "Failed to create hanging platform object.";
             return whereAmI + gapBefore + platformWidthPx; // Fail-safe advance
         }
     }
 
     // --- Anchors ---
-    b2BodyId leftAnchorBodyId = b2_nullBodyId;
-    b2BodyId rightAnchorBodyId = b2_nullBodyId;
     float leftAnchorX = whereAmI + gapBefore;
     float rightAnchorX = whereAmI + gapBefore + platformWidthPx;
 
-    // Left anchor
-    {
-        GameObject leftAnchorObj;
-        leftAnchorObj.setPosition(pixelsToMeters(leftAnchorX), pixelsToMeters(anchorPointHeightPx));
-        leftAnchorObj.setSize(pixelsToMeters(1), pixelsToMeters(1));
-        leftAnchorObj.setDynamic(false);
-        leftAnchorObj.setColor(sf::Color::Transparent);
-        if (leftAnchorObj.finalize(worldId)) {
-            gameObjects.push_back(leftAnchorObj);
-            leftAnchorBodyId = leftAnchorObj.bodyId;
-        }
-    }
-
-    // Right anchor
-    {
-        GameObject rightAnchorObj;
-        rightAnchorObj.setPosition(pixelsToMeters(rightAnchorX), pixelsToMeters(anchorPointHeightPx));
-        rightAnchorObj.setSize(pixelsToMeters(1), pixelsToMeters(1));
-        rightAnchorObj.setDynamic(false);
-        rightAnchorObj.setColor(sf::Color::Transparent);
-        if (rightAnchorObj.finalize(worldId)) {
-            gameObjects.push_back(rightAnchorObj);
-            rightAnchorBodyId = rightAnchorObj.bodyId;
-        }
-    }
+    b2BodyId leftAnchorBodyId = createAnchor(worldId, gameObjects, pixelsToMeters(leftAnchorX), pixelsToMeters(anchorPointHeightPx));
+    b2BodyId rightAnchorBodyId = createAnchor(worldId, gameObjects, pixelsToMeters(rightAnchorX), pixelsToMeters(anchorPointHeightPx));
 
     // --- Ropes ---
     if (!B2_IS_NULL(leftAnchorBodyId) && !B2_IS_NULL(platformBodyId)) {
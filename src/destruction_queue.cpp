@@ -0,0 +1,67 @@
+#include "destruction_queue.hpp"
+
+void DestructionQueue::destroyLater(GameObject& obj) {
+    if (obj.markedForDestruction_) return;
+    obj.markedForDestruction_ = true;
+    ++pending_;
+}
+
+void DestructionQueue::destroyFallen(GameObjectList& gameObjects, float killY_m) {
+    for (GameObject& obj : gameObjects) {
+        if (!obj.isDynamic_val_ || obj.isPlayer || !obj.isValid()) continue;
+        if (b2Body_GetPosition(obj.bodyId).y < killY_m) {
+            destroyLater(obj);
+        }
+    }
+}
+
+bool DestructionQueue::flush(GameObjectList& gameObjects) {
+    removed_.clear();
+    moved_.clear();
+    if (pending_ == 0) return false;
+    pending_ = 0;
+
+    // Destroy every marked body in one batch first: the shapes and joints go with them
+    for (GameObject& obj : gameObjects) {
+        if (obj.markedForDestruction_ && obj.isValid()) {
+            if (b2Body_IsValid(obj.bodyId)) {
+                b2DestroyBody(obj.bodyId);
+            }
+            obj.bodyId = b2_nullBodyId;
+            obj.shapeId = b2_nullShapeId;
+        }
+    }
+
+    // Swap-remove. Only objects from the tail are moved, each at most once, and a moved
+    // object is checked again at its new place.
+    int originalSize = static_cast<int>(gameObjects.size());
+    int origin = 0; // Index before the flush of the object now at i
+    for (int i = 0; i < static_cast<int>(gameObjects.size());) {
+        if (!gameObjects[i].markedForDestruction_) {
+            if (origin != i) moved_.push_back({origin, i});
+            origin = ++i;
+            continue;
+        }
+        removed_.push_back(origin);
+        int last = static_cast<int>(gameObjects.size()) - 1;
+        if (i != last) {
+            gameObjects[i] = gameObjects[last];
+            origin = originalSize - static_cast<int>(removed_.size()); // The tail was never moved
+        }
+        gameObjects.pop_back();
+    }
+
+    totalDestroyed_ += removed_.size();
+    return !removed_.empty();
+}
+
+int DestructionQueue::remapIndex(int index) const {
+    if (index < 0) return -1;
+    for (int removed : removed_) {
+        if (removed == index) return -1;
+    }
+    for (const Move& move : moved_) {
+        if (move.from == index) return move.to;
+    }
+    return index;
+}
@@ -0,0 +1,197 @@
+#include "event_dispatcher.hpp"
+#include <chrono>  // For per-handler timing
+#include <iomanip> // For std::setprecision
+#include <iostream>
+
+void EventDispatcher::on(GameEventType type, uint64_t categoryA, uint64_t categoryB, const std::string& name, Handler handler) {
+    std::size_t handlerIndex = handlers_.size();
+    handlers_.push_back(std::move(handler));
+    HandlerStats stats;
+    stats.name = name;
+    stats_.push_back(stats);
+
+    RouteTable& table = routes_[static_cast<std::size_t>(type)];
+    bool sensor = type == GameEventType::SensorBegin || type == GameEventType::SensorEnd;
+    // When the two masks share bits, a pair of slots is reached both ways: the handler runs once
+    auto addRoute = [handlerIndex](std::vector<Route>& routes, bool swapped) {
+        for (const Route& existing : routes) {
+            if (existing.handler == handlerIndex) return;
+        }
+        routes.push_back({handlerIndex, swapped});
+    };
+    for (int a = 0; a < CATEGORY_SLOTS; ++a) {
+        if ((categoryA & (uint64_t(1) << a)) == 0) continue;
+        for (int b = 0; b < CATEGORY_SLOTS; ++b) {
+            if ((categoryB & (uint64_t(1) << b)) == 0) continue;
+            addRoute(table[a][b], false);
+            if (!sensor && a != b) {
+                addRoute(table[b][a], true); // Contacts have no natural order
+            }
+        }
+    }
+}
+
+void EventDispatcher::dispatch(b2WorldId worldId, GameObjectList& gameObjects) {
+    reindexed_ = false;
+    if (gameObjects.size() != indexedCount_) {
+        indexShapes(gameObjects);
+        reindexed_ = true;
+    }
+
+    b2SensorEvents sensorEvents = b2World_GetSensorEvents(worldId);
+    for (int i = 0; i < sensorEvents.beginCount; ++i) {
+        GameEvent event {GameEventType::SensorBegin};
+        event.shapeA = sensorEvents.beginEvents[i].sensorShapeId;
+        event.shapeB = sensorEvents.beginEvents[i].visitorShapeId;
+        route(event, gameObjects);
+    }
+    for (int i = 0; i < sensorEvents.endCount; ++i) {
+        GameEvent event {GameEventType::SensorEnd};
+        event.shapeA = sensorEvents.endEvents[i].sensorShapeId;
+        event.shapeB = sensorEvents.endEvents[i].visitorShapeId;
+        route(event, gameObjects);
+    }
+
+    b2ContactEvents contactEvents = b2World_GetContactEvents(worldId);
+    for (int i = 0; i < contactEvents.beginCount; ++i) {
+        GameEvent event {GameEventType::ContactBegin};
+        event.shapeA = contactEvents.beginEvents[i].shapeIdA;
+        event.shapeB = contactEvents.beginEvents[i].shapeIdB;
+        route(event, gameObjects);
+    }
+    for (int i = 0; i < contactEvents.endCount; ++i) {
+        GameEvent event {GameEventType::ContactEnd};
+        event.shapeA = contactEvents.endEvents[i].shapeIdA;
+        event.shapeB = contactEvents.endEvents[i].shapeIdB;
+        route(event, gameObjects);
+    }
+    for (int i = 0; i < contactEvents.hitCount; ++i) {
+        const b2ContactHitEvent& hit = contactEvents.hitEvents[i];
+        GameEvent event {GameEventType::Hit};
+        event.shapeA = hit.shapeIdA;
+        event.shapeB = hit.shapeIdB;
+        event.point = hit.point;
+        event.normal = hit.normal;
+        event.approachSpeed = hit.approachSpeed;
+        route(event, gameObjects);
+    }
+}
+
+void EventDispatcher::printStats(std::ostream& out) const {
+    for (const HandlerStats& stats : stats_) {
+        if (stats.calls == 0) continue;
+        out << "Event handler '" << stats.name << "': " << stats.calls << " calls, "
+            << std::fixed << std::setprecision(3) << stats.totalMs << " ms total, "
+            << stats.maxMs << " ms max" << std::endl;
+    }
+}
+
+void EventDispatcher::clear() {
+    for (RouteTable& table : routes_) {
+        for (auto& row : table) {
+            for (auto& routes : row) {
+                routes.clear();
+            }
+        }
+    }
+    handlers_.clear();
+    stats_.clear();
+    shapes_.clear();
+    indexedCount_ = 0;
+}
+
+/**
+ * @brief Index of the lowest category bit, or -1 if it is outside the dispatch table.
+ */
+int EventDispatcher::slotOf(uint64_t categoryBits) {
+    for (int slot = 0; slot < CATEGORY_SLOTS; ++slot) {
+        if (categoryBits & (uint64_t(1) << slot)) return slot;
+    }
+    return -1;
+}
+
+/**
+ * @brief Rebuilds the shape -> GameObject index (main shapes and shape parts).
+ */
+void EventDispatcher::indexShapes(GameObjectList& gameObjects) {
+    shapes_.clear();
+    shapes_.reserve(gameObjects.size());
+    for (std::size_t i = 0; i < gameObjects.size(); ++i) {
+        const GameObject& obj = gameObjects[i];
+        if (!B2_IS_NULL(obj.shapeId)) {
+            shapes_[b2StoreShapeId(obj.shapeId)] = {i, slotOf(obj.categoryBits_)};
+        }
+        for (const GameObject::ShapePart& part : obj.shapeParts) {
+            if (!B2_IS_NULL(part.shapeId)) {
+                shapes_[b2StoreShapeId(part.shapeId)] = {i, slotOf(part.categoryBits)};
+            }
+        }
+    }
+    indexedCount_ = gameObjects.size();
+}
+
+/**
+ * @brief Finds the GameObject and category slot of a shape.
+ * Shapes without a GameObject (e.g. rope anchors) are classified by their Box2D filter.
+ * @return False if the shape cannot be classified (destroyed, or category out of range).
+ */
+bool EventDispatcher::resolve(b2ShapeId shapeId, GameObjectList& gameObjects, GameObject*& object, int& slot) {
+    object = nullptr;
+    if (B2_IS_NULL(shapeId)) return false;
+
+    uint64_t shapeKey = b2StoreShapeId(shapeId);
+    auto it = shapes_.find(shapeKey);
+    auto isCurrent = [&]() {
+        return it != shapes_.end() && it->second.objectIndex < gameObjects.size() &&
+               gameObjects[it->second.objectIndex].ownsShape(shapeId);
+    };
+    if (!isCurrent() && !reindexed_) {
+        indexShapes(gameObjects); // Objects were replaced or reordered since the last indexing
+        reindexed_ = true;
+        it = shapes_.find(shapeKey);
+    }
+    if (isCurrent()) {
+        object = &gameObjects[it->second.objectIndex];
+        slot = it->second.slot;
+        return slot >= 0;
+    }
+
+    if (!b2Shape_IsValid(shapeId)) return false;
+    slot = slotOf(b2Shape_GetFilter(shapeId).categoryBits);
+    return slot >= 0;
+}
+
+/**
+ * @brief Calls the handlers registered for the categories of the event's two shapes.
+ */
+void EventDispatcher::route(GameEvent& event, GameObjectList& gameObjects) {
+    GameObject* objectA;
+    GameObject* objectB;
+    int slotA, slotB;
+    if (!resolve(event.shapeA, gameObjects, objectA, slotA) || !resolve(event.shapeB, gameObjects, objectB, slotB)) {
+        return;
+    }
+
+    const std::vector<Route>& routes = routes_[static_cast<std::size_t>(event.type)][slotA][slotB];
+    if (routes.empty()) return;
+
+    b2ShapeId shapeA = event.shapeA;
+    b2ShapeId shapeB = event.shapeB;
+    b2Vec2 normal = event.normal;
+    for (const Route& entry : routes) {
+        event.objectA = entry.swapped ? objectB : objectA;
+        event.objectB = entry.swapped ? objectA : objectB;
+        event.shapeA = entry.swapped ? shapeB : shapeA;
+        event.shapeB = entry.swapped ? shapeA : shapeB;
+        event.normal = entry.swapped ? b2Vec2{-normal.x, -normal.y} : normal;
+
+        auto start = std::chrono::steady_clock::now();
+        handlers_[entry.handler](event);
+        std::chrono::duration<double, std::milli> spent = std::chrono::steady_clock::now() - start;
+
+        HandlerStats& stats = stats_[entry.handler];
+        ++stats.calls;
+        stats.totalMs += spent.count();
+        if (spent.count() > stats.maxMs) stats.maxMs = spent.count();
+    }
+}
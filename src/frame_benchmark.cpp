@@ -0,0 +1,272 @@
+#include "frame_benchmark.hpp"
+#include "game_object.hpp"
+#include "player.hpp"
+#include "level_arena.hpp"
+#include "level_streamer.hpp"
+#include "destruction_queue.hpp"
+#include "timer_wheel.hpp"
+#include "physics_lod.hpp"
+#include "render_stats.hpp"
+#include "scene_renderer.hpp"
+#include "task_system.hpp"
+#include "time_dilation.hpp"
+#include "trace.hpp"
+#include "../maps/map0.hpp"
+#include "../maps/map1.hpp"
+#include "../maps/map2.hpp"
+#include "../maps/map3.hpp"
+#include "../maps/map4.hpp"
+#include <algorithm> // For std::sort, std::min, std::max
+#include <chrono>
+#include <cstdlib>   // For setenv, srand
+#include <fstream>
+#include <iomanip>   // For std::setprecision
+#include <iostream>  // For error reporting
+#include <thread>    // For std::thread::hardware_concurrency
+#include <vector>
+
+namespace {
+
+const int FIRST_LEVEL = 0;
+const int LAST_LEVEL = 4;
+const int SUB_STEPS = 8;                 // Same as the game loop
+
+struct LevelReport {
+    int level {0};
+    int frames {0};
+    double meanMs {0.0};
+    double p50Ms {0.0};
+    double p99Ms {0.0};
+    double maxMs {0.0};
+    double drawCallsMean {0.0};
+    uint64_t drawCallsMax {0};
+    double verticesMean {0.0};
+    uint64_t verticesMax {0};
+};
+
+double percentile(const std::vector<double>& sortedMs, double fraction) {
+    if (sortedMs.empty()) return 0.0;
+    size_t index = static_cast<size_t>(fraction * static_cast<double>(sortedMs.size() - 1) + 0.5);
+    return sortedMs[std::min(index, sortedMs.size() - 1)];
+}
+
+int loadLevel(int level, b2WorldId worldId, GameObjectList& gameObjects, b2BodyId& playerBodyId, LevelStreamer& streamer,
+              TimeDilationZones& timeZones) {
+    switch (level) {
+        case 0: return loadMap0(worldId, gameObjects, playerBodyId);
+        case 1: return loadMap1(worldId, gameObjects, playerBodyId, timeZones);
+        case 2: return loadMap2(worldId, gameObjects, playerBodyId);
+        case 3: return loadMap3(worldId, gameObjects, playerBodyId);
+        default: return loadMap4(worldId, gameObjects, playerBodyId, streamer);
+    }
+}
+
+/**
+ * @brief Horizontal extent of the level in meters: every chunk of a streamed level,
+ * otherwise every body loaded.
+ */
+void levelExtent(const GameObjectList& gameObjects, const LevelStreamer& streamer, float& minX_m, float& maxX_m) {
+    if (streamer.extent(minX_m, maxX_m)) return;
+    minX_m = 0.0f;
+    maxX_m = 0.0f;
+    bool first = true;
+    for (const GameObject& obj : gameObjects) {
+        if (B2_IS_NULL(obj.bodyId)) continue;
+        b2AABB box = b2Body_ComputeAABB(obj.bodyId);
+        minX_m = first ? box.lowerBound.x : std::min(minX_m, box.lowerBound.x);
+        maxX_m = first ? box.upperBound.x : std::max(maxX_m, box.upperBound.x);
+        first = false;
+    }
+}
+
+int findPlayer(const GameObjectList& gameObjects, b2BodyId playerBodyId) {
+    for (size_t i = 0; i < gameObjects.size(); ++i) {
+        if (B2_ID_EQUALS(gameObjects[i].bodyId, playerBodyId)) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+LevelReport runLevel(int level, int frames, sf::RenderTexture& target, b2WorldDef& worldDef,
+                     SceneRenderer& sceneRenderer, StaticLayerCache& staticLayer) {
+    srand(42); // map1's box rain (TimerWheel, every MAP1_SPAWN_PERIOD_STEPS steps) places its boxes with rand()
+
+    b2WorldId worldId = b2CreateWorld(&worldDef);
+    LevelArena levelArena;
+    GameObjectList gameObjects{ArenaAllocator<GameObject>(&levelArena)};
+    b2BodyId playerBodyId = b2_nullBodyId;
+    LevelStreamer streamer;
+    DestructionQueue destruction;
+    TimerWheel timers;
+    TimeDilationZones timeZones;
+    PhysicsLod physicsLod;
+    std::vector<b2BodyId> lodBodies;
+
+    int playerIndex = loadLevel(level, worldId, gameObjects, playerBodyId, streamer, timeZones);
+    if (level == 1) {
+        startMap1Spawner(timers, worldId, gameObjects); // As in the game loop
+    }
+    b2Vec2 start = B2_IS_NULL(playerBodyId) ? b2Vec2{0.0f, 0.0f} : b2Body_GetPosition(playerBodyId);
+    if (!streamer.empty()) {
+        streamer.prime(worldId, gameObjects, start.x);
+        playerIndex = findPlayer(gameObjects, playerBodyId);
+    }
+    if (playerIndex != -1) {
+        loadPlayerAnimations(gameObjects[playerIndex]);
+    }
+
+    // The camera sweeps the level from edge to edge; a level narrower than the view stays centered
+    float minX_m = 0.0f, maxX_m = 0.0f;
+    levelExtent(gameObjects, streamer, minX_m, maxX_m);
+    float halfViewWidth_m = pixelsToMeters(WINDOW_WIDTH / 2.0f);
+    float pathStart_m = minX_m + halfViewWidth_m;
+    float pathEnd_m = std::max(pathStart_m, maxX_m - halfViewWidth_m);
+
+    sf::View view = target.getDefaultView();
+    SceneFrame sceneFrame;
+
+    std::vector<double> frameMs;
+    frameMs.reserve(frames);
+    LevelReport report;
+    report.level = level;
+    report.frames = frames;
+    double drawCallsTotal = 0.0;
+    double verticesTotal = 0.0;
+
+    for (int frame = 0; frame < frames; ++frame) {
+        TRACE_ZONE("Frame");
+        auto frameStart = std::chrono::steady_clock::now();
+        float t = frames > 1 ? static_cast<float>(frame) / static_cast<float>(frames - 1) : 0.0f;
+        b2Vec2 focus = {pathStart_m + (pathEnd_m - pathStart_m) * t, start.y};
+
+        lodBodies.clear();
+        for (const auto& obj : gameObjects) {
+            if (obj.isDynamic_val_ && !B2_IS_NULL(obj.bodyId)) {
+                lodBodies.push_back(obj.bodyId);
+            }
+        }
+        timeZones.update(worldId, playerBodyId, &physicsLod);
+        physicsLod.beforeStep(lodBodies, focus);
+        b2World_Step(worldId, UPDATE_DELTA, SUB_STEPS);
+        physicsLod.afterStep();
+        timers.advance();
+
+        destruction.destroyFallen(gameObjects, KILL_PLANE_Y_M);
+        if (destruction.flush(gameObjects)) {
+            playerIndex = destruction.remapIndex(playerIndex);
+            staticLayer.resync(gameObjects);
+        }
+        if (!streamer.empty() && streamer.update(worldId, gameObjects, focus.x)) {
+            playerIndex = findPlayer(gameObjects, playerBodyId);
+            staticLayer.resync(gameObjects);
+        }
+        if (playerIndex != -1) {
+            gameObjects[playerIndex].updatePlayerAnimation(UPDATE_DELTA);
+        }
+        for (auto& obj : gameObjects) {
+            if (obj.drawnAsQuad()) {
+                obj.applyPendingImpulsion();
+            } else if (!staticLayer.isCached(obj)) {
+                obj.updateShape();
+            }
+        }
+        staticLayer.sync(gameObjects);
+
+        view.setCenter(b2VecToSfVec(focus));
+        sceneFrame.view = view;
+        sceneFrame.showInstructions = (level == 1);
+        RenderStats::instance().beginFrame();
+        sceneRenderer.render(target, sceneFrame, gameObjects, playerIndex);
+        target.display();
+
+        frameMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count());
+        uint64_t drawCalls = RenderStats::instance().drawCalls();
+        uint64_t vertices = RenderStats::instance().vertices();
+        drawCallsTotal += static_cast<double>(drawCalls);
+        verticesTotal += static_cast<double>(vertices);
+        report.drawCallsMax = std::max(report.drawCallsMax, drawCalls);
+        report.verticesMax = std::max(report.verticesMax, vertices);
+    }
+
+    double totalMs = 0.0;
+    for (double ms : frameMs) totalMs += ms;
+    std::sort(frameMs.begin(), frameMs.end());
+    report.meanMs = frames > 0 ? totalMs / frames : 0.0;
+    report.p50Ms = percentile(frameMs, 0.50);
+    report.p99Ms = percentile(frameMs, 0.99);
+    report.maxMs = frameMs.empty() ? 0.0 : frameMs.back();
+    report.drawCallsMean = frames > 0 ? drawCallsTotal / frames : 0.0;
+    report.verticesMean = frames > 0 ? verticesTotal / frames : 0.0;
+
+    streamer.clear();
+    timeZones.clear();
+    staticLayer.clear();
+    physicsLod.clear();
+    gameObjects = GameObjectList(ArenaAllocator<GameObject>(&levelArena)); // Before the arena goes away
+    b2DestroyWorld(worldId);
+    return report;
+}
+
+bool writeReport(const std::string& path, const std::vector<LevelReport>& reports, int framesPerLevel) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Failed to open frame benchmark output: " << path << std::endl;
+        return false;
+    }
+    out << std::fixed << std::setprecision(3);
+    out << "{\n  \"benchmark\": \"frame_flythrough\",\n  \"frames_per_level\": " << framesPerLevel
+        << ",\n  \"resolution\": [" << WINDOW_WIDTH << ", " << WINDOW_HEIGHT << "],\n  \"levels\": [\n";
+    for (size_t i = 0; i < reports.size(); ++i) {
+        const LevelReport& r = reports[i];
+        out << "    {\"level\": " << r.level << ", \"frames\": " << r.frames
+            << ", \"cpu_frame_ms\": {\"mean\": " << r.meanMs << ", \"p50\": " << r.p50Ms
+            << ", \"p99\": " << r.p99Ms << ", \"max\": " << r.maxMs << "}"
+            << ", \"draw_calls\": {\"mean\": " << r.drawCallsMean << ", \"max\": " << r.drawCallsMax << "}"
+            << ", \"vertices\": {\"mean\": " << r.verticesMean << ", \"max\": " << r.verticesMax << "}}"
+            << (i + 1 < reports.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+} // namespace
+
+int runFrameBenchmark(const FrameBenchmarkOptions& options) {
+#ifdef __linux__
+    setenv("LIBGL_ALWAYS_SOFTWARE", "1", 0); // Mesa software rasterizer, unless the caller chose otherwise
+#endif
+
+    sf::RenderTexture target;
+    if (!target.resize({WINDOW_WIDTH, WINDOW_HEIGHT})) {
+        std::cerr << "Failed to create the offscreen render target." << std::endl;
+        return -1;
+    }
+    StaticLayerCache staticLayer;
+    FrozenSceneCache frozenScene; // Unused: time is never frozen during the flythrough
+    SceneRenderer sceneRenderer(staticLayer, frozenScene);
+    if (!sceneRenderer.loadAssets()) {
+        return -1;
+    }
+
+    b2WorldDef worldDef = b2DefaultWorldDef();
+    worldDef.gravity = {0.0f, -10.0f};
+    unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    TaskSystem physicsTasks(static_cast<int>(std::min(hardwareThreads, static_cast<unsigned int>(PHYSICS_WORKER_COUNT))));
+    physicsTasks.configure(worldDef);
+
+    std::vector<LevelReport> reports;
+    for (int level = FIRST_LEVEL; level <= LAST_LEVEL; ++level) {
+        LevelReport report = runLevel(level, std::max(1, options.framesPerLevel), target, worldDef, sceneRenderer, staticLayer);
+        std::cout << "Level " << level << ": " << std::fixed << std::setprecision(3)
+                  << report.p50Ms << " ms p50, " << report.p99Ms << " ms p99, "
+                  << report.drawCallsMean << " draw calls, " << report.verticesMean << " vertices per frame" << std::endl;
+        reports.push_back(report);
+    }
+
+    if (!writeReport(options.outPath, reports, options.framesPerLevel)) {
+        return -1;
+    }
+    std::cout << "Frame benchmark written to " << options.outPath << std::endl;
+    return 0;
+}
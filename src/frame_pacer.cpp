@@ -0,0 +1,69 @@
+#include "frame_pacer.hpp"
+#include "input_queue.hpp" // For the input clock
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+void LatencySamples::add(float ms) {
+    if (samples_.size() < LATENCY_SAMPLE_CAPACITY) {
+        samples_.push_back(ms);
+    } else {
+        samples_[next_] = ms;
+        next_ = (next_ + 1) % samples_.size();
+    }
+}
+
+void LatencySamples::clear() {
+    samples_.clear();
+    next_ = 0;
+}
+
+float LatencySamples::percentile(float fraction) const {
+    if (samples_.empty()) {
+        return 0.0f;
+    }
+    std::vector<float> sorted = samples_;
+    std::size_t rank = static_cast<std::size_t>(std::clamp(fraction, 0.0f, 1.0f) * static_cast<float>(sorted.size() - 1) + 0.5f);
+    std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(rank), sorted.end());
+    return sorted[rank];
+}
+
+FramePacer::FramePacer(bool lowLatency)
+    : lowLatency_(lowLatency),
+      periodNs_(static_cast<int64_t>(UPDATE_DELTA * 1e9f)),
+      frameCostNs_(periodNs_ / 2) {}
+
+FrameTiming FramePacer::latch() {
+    FrameTiming timing;
+    int64_t now = InputQueue::nowNs();
+    if (!lowLatency_) {
+        timing.latchNs = now;
+        return timing;
+    }
+
+    int64_t budget = frameCostNs_.load(std::memory_order_relaxed) + static_cast<int64_t>(LOW_LATENCY_MARGIN_MS * 1e6f);
+    nextDeadlineNs_ = nextDeadlineNs_ == 0 ? now + periodNs_ : nextDeadlineNs_ + periodNs_;
+    if (nextDeadlineNs_ - budget < now) {
+        // This deadline can no longer be met: aim for the first one that can
+        int64_t late = now + budget - nextDeadlineNs_;
+        nextDeadlineNs_ += (late + periodNs_ - 1) / periodNs_ * periodNs_;
+    }
+    int64_t latchNs = nextDeadlineNs_ - budget;
+    if (latchNs > now) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(latchNs - now));
+    }
+    timing.latchNs = InputQueue::nowNs();
+    timing.deadlineNs = nextDeadlineNs_;
+    return timing;
+}
+
+void FramePacer::presented(const FrameTiming& timing, int64_t presentNs) {
+    int64_t cost = std::min(presentNs - timing.latchNs, periodNs_); // Latching earlier than a period ahead gains nothing
+    int64_t estimate = frameCostNs_.load(std::memory_order_relaxed);
+    // A slower frame is followed at once, faster ones pull the estimate down by 1/16th
+    estimate = cost > estimate ? cost : estimate + (cost - estimate) / 16;
+    frameCostNs_.store(estimate, std::memory_order_relaxed);
+    if (timing.deadlineNs != 0 && presentNs > timing.deadlineNs) {
+        missed_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,76 @@
+#include "frozen_scene_cache.hpp"
+#include "render_stats.hpp"
+#include "logger.hpp"
+#include <cmath>    // For std::ceil, std::floor
+
+void FrozenSceneCache::draw(sf::RenderTarget& target, const sf::View& view, const DrawWorldFn& drawWorld) {
+    std::optional<sf::Sprite> frozenWorld = snapshot(view, drawWorld);
+    if (!frozenWorld) {
+        // No offscreen texture available: fall back to drawing the world directly.
+        drawWorld(target, view);
+        return;
+    }
+    countedDraw(target, *frozenWorld);
+}
+
+std::optional<sf::Sprite> FrozenSceneCache::snapshot(const sf::View& view, const DrawWorldFn& drawWorld) {
+    if (!valid_ || !covers(view)) {
+        render(view, drawWorld);
+    }
+    if (!valid_) {
+        return std::nullopt;
+    }
+    sf::Sprite frozenWorld(texture_->getTexture());
+    frozenWorld.setPosition(cachedArea_.position);
+    frozenWorld.setScale(sf::Vector2f(1.0f / resolutionScale_, 1.0f / resolutionScale_));
+    return frozenWorld;
+}
+
+void FrozenSceneCache::setResolutionScale(float scale) {
+    if (scale != resolutionScale_) {
+        resolutionScale_ = scale;
+        valid_ = false;
+    }
+}
+
+/**
+ * @brief True if the whole view lies inside the cached area.
+ */
+bool FrozenSceneCache::covers(const sf::View& view) const {
+    sf::Vector2f topLeft = view.getCenter() - view.getSize() / 2.0f;
+    sf::Vector2f bottomRight = topLeft + view.getSize();
+    sf::Vector2f cachedBottomRight = cachedArea_.position + cachedArea_.size;
+    return topLeft.x >= cachedArea_.position.x && topLeft.y >= cachedArea_.position.y &&
+           bottomRight.x <= cachedBottomRight.x && bottomRight.y <= cachedBottomRight.y;
+}
+
+/**
+ * @brief Renders the world around the view into the offscreen texture.
+ */
+void FrozenSceneCache::render(const sf::View& view, const DrawWorldFn& drawWorld) {
+    sf::Vector2f margin = view.getSize() * FREEZE_CACHE_MARGIN;
+    sf::Vector2f areaSize(std::ceil(view.getSize().x + 2.0f * margin.x), std::ceil(view.getSize().y + 2.0f * margin.y));
+    sf::Vector2u textureSize(static_cast<unsigned int>(std::ceil(areaSize.x * resolutionScale_)),
+                             static_cast<unsigned int>(std::ceil(areaSize.y * resolutionScale_)));
+
+    if (!texture_ || texture_->getSize() != textureSize) {
+        texture_ = std::make_unique<sf::RenderTexture>();
+        if (!texture_->resize(textureSize)) {
+            LOG_ERROR(LogCategory::Render) << "Failed to allocate the frozen scene texture.";
+            texture_.reset();
+            valid_ = false;
+            return;
+        }
+    }
+
+    // Snap the cached area to whole pixels so the snapshot lines up with the live scene.
+    sf::Vector2f topLeft = view.getCenter() - view.getSize() / 2.0f - margin;
+    cachedArea_ = sf::FloatRect(sf::Vector2f(std::floor(topLeft.x), std::floor(topLeft.y)), areaSize);
+
+    sf::View cacheView(cachedArea_);
+    texture_->setView(cacheView);
+    texture_->clear(sf::Color::Transparent);
+    drawWorld(*texture_, cacheView);
+    texture_->display();
+    valid_ = true;
+}
@@ -1,5 +1,7 @@
 #include "game_object.hpp" // Includes SFML, Box2D, utils.hpp, constants.hpp
-#include <iostream> // For error reporting
+#include "texture_cache.hpp"
+#include "render_stats.hpp"
+#include "logger.hpp"
 #include <cmath> // For M_PI / b2_pi
 
 /**
@@ -14,29 +16,6 @@ GameObject::GameObject() : bodyId(b2_nullBodyId), shapeId(b2_nullShapeId), hasVi
     // Example: x_m_ = 0.0f; y_m_ = 0.0f; width_m_ = 1.0f; etc.
 }
 
-GameObject::GameObject(const GameObject& other)
-    : x_m_(other.x_m_), y_m_(other.y_m_), width_m_(other.width_m_), height_m_(other.height_m_),
-      isDynamic_val_(other.isDynamic_val_), fixedRotation_val_(other.fixedRotation_val_),
-      linearDamping_val_(other.linearDamping_val_), density_val_(other.density_val_),
-      friction_val_(other.friction_val_), restitution_val_(other.restitution_val_),
-      isPlayer_prop_(other.isPlayer_prop_), canJumpOn_prop_(other.canJumpOn_prop_),
-      collidesWithPlayer_prop_(other.collidesWithPlayer_prop_), isFlag_prop_(other.isFlag_prop_),
-      isTremplin_prop_(other.isTremplin_prop_), isSensor_prop_(other.isSensor_prop_),
-      enableSensorEvents_prop_(other.enableSensorEvents_prop_), categoryBits_(other.categoryBits_),
-      maskBits_(other.maskBits_), pendingImpulsion(other.pendingImpulsion),
-      bodyId(other.bodyId), shapeId(other.shapeId), sfShape(other.sfShape),
-      color_val_(other.color_val_), hasVisual(other.hasVisual), canJumpOn(other.canJumpOn),
-      isFlag_(other.isFlag_), isTremplin(other.isTremplin), sprite(other.sprite),
-      isPlayer(other.isPlayer), animations(other.animations),
-      animationFrameDurations(other.animationFrameDurations), genericTexture_(other.genericTexture_),
-      spriteTexturePath_prop_(other.spriteTexturePath_prop_), playerShapeInfo(other.playerShapeInfo),
-      currentAnimationName(other.currentAnimationName), currentFrame(other.currentFrame),
-      animationTimer(other.animationTimer), spriteFlipped(other.spriteFlipped) {
-    
-    // After copying, re-link the sprite's texture pointer to the new object's texture.
-    ensureCorrectSpriteTextureLink();
-}
-
 // --- Property Setters ---
 void GameObject::setPosition(float x, float y) {
     x_m_ = x;
@@ -102,6 +81,10 @@ void GameObject::setPendingImpulsion(b2Vec2 impulse) {
     pendingImpulsion = impulse;
 }
 
+void GameObject::addShapePart(const ShapePart& part) {
+    shapeParts.push_back(part);
+}
+
 void GameObject::setIsPlayerProperty(bool isPlayerProp) {
     isPlayer_prop_ = isPlayerProp;
     // This might also influence default collision filter bits if called before finalize
@@ -223,74 +206,122 @@ void GameObject::setEnableSensorEventsProperty(bool enableSensorEventsProp) {
 // --- Finalization ---
 bool GameObject::finalize(b2WorldId worldId) {
     if (!B2_IS_NULL(bodyId)) {
-        std::cerr << "GameObject already finalized or has a body." << std::endl;
+        LOG_ERROR(LogCategory::Physics) << "GameObject already finalized or has a body.";
         return false; // Already finalized
     }
 
-    // Setup SFML Shape
-    sfShape.setSize(sf::Vector2f(metersToPixels(width_m_), metersToPixels(height_m_)));
-    sfShape.setFillColor(color_val_);
-    sfShape.setOrigin(sf::Vector2f(metersToPixels(width_m_) / 2.0f, metersToPixels(height_m_) / 2.0f));
-    sfShape.setPosition(b2VecToSfVec({x_m_, y_m_})); // Initial position
-    hasVisual = true;
+    prepareVisual();
 
     // Create Box2D Body
-    b2BodyDef bodyDef = b2DefaultBodyDef();
-    bodyDef.type = isDynamic_val_ ? b2_dynamicBody : b2_staticBody;
-    bodyDef.position = {x_m_, y_m_};
-    if (isDynamic_val_) {
-        bodyDef.fixedRotation = fixedRotation_val_;
-        bodyDef.linearDamping = linearDamping_val_;
-    }
+    b2BodyDef bodyDef = makeBodyDef();
     bodyId = b2CreateBody(worldId, &bodyDef);
     if (B2_IS_NULL(bodyId)) {
-        std::cerr << "Error creating Box2D body for GameObject!" << std::endl;
+        LOG_ERROR(LogCategory::Physics) << "Error creating Box2D body for GameObject!";
         hasVisual = false;
         return false;
     }
 
     // Create Box2D Shape
     b2Polygon box = b2MakeBox(width_m_ / 2.0f, height_m_ / 2.0f);
-    b2ShapeDef shapeDef = b2DefaultShapeDef();
-    shapeDef.density = density_val_; // density_val_ should be 0 for static if isDynamic_val_ is false
-    shapeDef.material.friction = friction_val_;
-    shapeDef.material.restitution = restitution_val_;
-    shapeDef.isSensor = isSensor_prop_; // Use the property here
-    shapeDef.enableSensorEvents = enableSensorEvents_prop_; // Use the property here
-
-    // Setup collision filtering based on properties
-    shapeDef.filter.categoryBits = categoryBits_;
-    shapeDef.filter.maskBits = maskBits_;
-    shapeDef.filter.groupIndex = 0; // Default group index
-
+    b2ShapeDef shapeDef = makeShapeDef();
     shapeId = b2CreatePolygonShape(bodyId, &shapeDef, &box);
     if (B2_IS_NULL(shapeId)) {
-        std::cerr << "Error creating Box2D shape for GameObject!" << std::endl;
+        LOG_ERROR(LogCategory::Physics) << "Error creating Box2D shape for GameObject!";
         b2DestroyBody(bodyId); // Clean up
         bodyId = b2_nullBodyId;
         hasVisual = false;
         return false;
     }
 
+    // Extra shapes of composite objects, on the same body
+    for (ShapePart& part : shapeParts) {
+        b2Polygon partBox = makePartBox(part);
+        b2ShapeDef partDef = makeShapeDef(part);
+        part.shapeId = b2CreatePolygonShape(bodyId, &partDef, &partBox);
+        if (B2_IS_NULL(part.shapeId)) {
+            LOG_ERROR(LogCategory::Physics) << "Error creating Box2D shape part for GameObject!";
+            b2DestroyBody(bodyId); // Destroys the shapes already created
+            bodyId = b2_nullBodyId;
+            shapeId = b2_nullShapeId;
+            for (ShapePart& created : shapeParts) created.shapeId = b2_nullShapeId;
+            hasVisual = false;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void GameObject::prepareVisual() {
+    // Setup SFML Shape
+    sfShape.setSize(sf::Vector2f(metersToPixels(width_m_), metersToPixels(height_m_)));
+    sfShape.setFillColor(color_val_);
+    sfShape.setOrigin(sf::Vector2f(metersToPixels(width_m_) / 2.0f, metersToPixels(height_m_) / 2.0f));
+    sfShape.setPosition(b2VecToSfVec({x_m_, y_m_})); // Initial position
+    hasVisual = true;
+
     // Set internal gameplay flags
     this->isPlayer = isPlayer_prop_;
     this->canJumpOn = canJumpOn_prop_;
     this->isFlag_ = isFlag_prop_;
     this->isTremplin = isTremplin_prop_;
 
-    // Load generic sprite if path is provided and not a player object
+    // Bind generic sprite if path is provided and not a player object.
+    // The texture is shared through the cache, so it is only read from disk once.
     if (!isPlayer && !spriteTexturePath_prop_.empty()) {
-        bool loadSuccess = genericTexture_.loadFromFile(spriteTexturePath_prop_);
-        if (loadSuccess) {
-            sprite.emplace(genericTexture_); // Construct the sprite with the loaded texture
-            sf::Vector2u textureSize = genericTexture_.getSize();
+        genericTexture_ = TextureCache::instance().get(spriteTexturePath_prop_);
+        if (genericTexture_) {
+            sprite.emplace(*genericTexture_); // Construct the sprite with the shared texture
+            sf::Vector2u textureSize = genericTexture_->getSize();
             sprite->setOrigin(sf::Vector2f(static_cast<float>(textureSize.x) / 2.f, static_cast<float>(textureSize.y) / 2.f));
-        } else {
-            std::cerr << "Failed to load generic texture from path: " << spriteTexturePath_prop_ << std::endl;
+        } else if (TextureCache::instance().loadingEnabled()) {
+            LOG_ERROR(LogCategory::Assets) << "Failed to load generic texture from path: " << spriteTexturePath_prop_;
         }
     }
+}
 
-    return true;
+b2BodyDef GameObject::makeBodyDef() const {
+    b2BodyDef bodyDef = b2DefaultBodyDef();
+    bodyDef.type = isDynamic_val_ ? b2_dynamicBody : b2_staticBody;
+    bodyDef.position = {x_m_, y_m_};
+    if (isDynamic_val_) {
+        bodyDef.fixedRotation = fixedRotation_val_;
+        bodyDef.linearDamping = linearDamping_val_;
+    }
+    return bodyDef;
+}
+
+b2ShapeDef GameObject::makeShapeDef() const {
+    b2ShapeDef shapeDef = b2DefaultShapeDef();
+    shapeDef.density = density_val_; // density_val_ should be 0 for static if isDynamic_val_ is false
+    shapeDef.material.friction = friction_val_;
+    shapeDef.material.restitution = restitution_val_;
+    shapeDef.isSensor = isSensor_prop_; // Use the property here
+    shapeDef.enableSensorEvents = enableSensorEvents_prop_; // Use the property here
+    shapeDef.enableHitEvents = isDynamic_val_ && !isPlayer_prop_; // Impacts of boxes and debris throw particles
+
+    // Setup collision filtering based on properties
+    shapeDef.filter.categoryBits = categoryBits_;
+    shapeDef.filter.maskBits = maskBits_;
+    shapeDef.filter.groupIndex = 0; // Default group index
+    return shapeDef;
+}
+
+b2ShapeDef GameObject::makeShapeDef(const ShapePart& part) const {
+    b2ShapeDef partDef = b2DefaultShapeDef();
+    partDef.density = isDynamic_val_ ? part.density : 0.0f;
+    partDef.material.friction = part.friction;
+    partDef.material.restitution = part.restitution;
+    partDef.isSensor = part.isSensor;
+    partDef.enableSensorEvents = part.enableSensorEvents;
+    partDef.filter.categoryBits = part.categoryBits;
+    partDef.filter.maskBits = part.maskBits;
+    partDef.filter.groupIndex = 0;
+    return partDef;
+}
+
+b2Polygon GameObject::makePartBox(const ShapePart& part) {
+    return b2MakeOffsetBox(part.width_m / 2.0f, part.height_m / 2.0f, part.offset, b2Rot_identity);
 }
 
 /**
@@ -301,13 +332,13 @@ bool GameObject::finalize(b2WorldId worldId) {
  */
 void GameObject::loadPlayerAnimation(const std::string& name, const std::vector<std::string>& framePaths, float frameDuration) {
     if (!isPlayer) return;
-    std::vector<sf::Texture> textures;
+    std::vector<const sf::Texture*> textures;
     for (const std::string& path : framePaths) {
-        sf::Texture tex;
-        if (tex.loadFromFile(path)) {
+        const sf::Texture* tex = TextureCache::instance().get(path);
+        if (tex) {
             textures.push_back(tex);
         } else {
-            std::cerr << "Failed to load texture: " << path << " for animation: " << name << std::endl;
+            LOG_ERROR(LogCategory::Assets) << "Failed to load texture: " << path << " for animation: " << name;
         }
     }
     if (!textures.empty()) {
@@ -331,7 +362,7 @@ void GameObject::setPlayerAnimation(const std::string& name, bool flipped) {
         animationTimer = 0.0f;
 
         if (!animations[currentAnimationName].empty()) {
-            sf::Texture& tex = animations[currentAnimationName][currentFrame];
+            const sf::Texture& tex = *animations[currentAnimationName][currentFrame];
             if (!sprite) { // If sprite is not yet constructed
                 sprite.emplace(tex); // Construct it with the texture
             } else {
@@ -358,9 +389,9 @@ void GameObject::updatePlayerAnimation(float dt) {
 
     const auto& animFrames = animations[currentAnimationName];
     if (animFrames.size() <= 1) { // Single frame animation or no frames
-        if (!animFrames.empty() && (&sprite->getTexture() != &animFrames[0])) {
-             sprite->setTexture(animFrames[0]); // Ensure correct texture is set
-             sf::Vector2u textureSize = animFrames[0].getSize();
+        if (!animFrames.empty() && (&sprite->getTexture() != animFrames[0])) {
+             sprite->setTexture(*animFrames[0]); // Ensure correct texture is set
+             sf::Vector2u textureSize = animFrames[0]->getSize();
              sprite->setOrigin(sf::Vector2f(static_cast<float>(textureSize.x) / 2.f, static_cast<float>(textureSize.y) / 2.f));
         }
         return;
@@ -372,8 +403,8 @@ void GameObject::updatePlayerAnimation(float dt) {
     if (animationTimer >= frameDuration) {
         animationTimer -= frameDuration;
         currentFrame = (currentFrame + 1) % animFrames.size();
-        sprite->setTexture(animFrames[currentFrame]);
-        sf::Vector2u textureSize = animFrames[currentFrame].getSize();
+        sprite->setTexture(*animFrames[currentFrame]);
+        sf::Vector2u textureSize = animFrames[currentFrame]->getSize();
         sprite->setOrigin(sf::Vector2f(static_cast<float>(textureSize.x) / 2.f, static_cast<float>(textureSize.y) / 2.f));
     }
 }
@@ -390,9 +421,9 @@ void GameObject::updateTremplinAnimation(float dt) {
 
     const auto& animFrames = animations[currentAnimationName];
     if (animFrames.size() <= 1) { // Single frame animation or no frames
-        if (!animFrames.empty() && (&sprite->getTexture() != &animFrames[0])) {
-             sprite->setTexture(animFrames[0]); // Ensure correct texture is set
-             sf::Vector2u textureSize = animFrames[0].getSize();
+        if (!animFrames.empty() && (&sprite->getTexture() != animFrames[0])) {
+             sprite->setTexture(*animFrames[0]); // Ensure correct texture is set
+             sf::Vector2u textureSize = animFrames[0]->getSize();
              sprite->setOrigin(sf::Vector2f(static_cast<float>(textureSize.x) / 2.f, static_cast<float>(textureSize.y) / 2.f));
         }
         return;
@@ -404,8 +435,8 @@ void GameObject::updateTremplinAnimation(float dt) {
     if (animationTimer >= frameDuration) {
         animationTimer -= frameDuration;
         currentFrame = (currentFrame + 1) % animFrames.size();
-        sprite->setTexture(animFrames[currentFrame]);
-        sf::Vector2u textureSize = animFrames[currentFrame].getSize();
+        sprite->setTexture(*animFrames[currentFrame]);
+        sf::Vector2u textureSize = animFrames[currentFrame]->getSize();
         sprite->setOrigin(sf::Vector2f(static_cast<float>(textureSize.x) / 2.f, static_cast<float>(textureSize.y) / 2.f));
     }
 }
@@ -419,10 +450,7 @@ void GameObject::updateTremplinAnimation(float dt) {
 void GameObject::updateShape() {
     if (B2_IS_NULL(bodyId)) return;
 
-    if (isDynamic_val_) {
-        b2Body_ApplyLinearImpulseToCenter(bodyId, pendingImpulsion, true);
-        setPendingImpulsion(b2Vec2{pendingImpulsion.x/1.1f, pendingImpulsion.y/1.1f});
-    };
+    applyPendingImpulsion();
 
     b2Transform transform = b2Body_GetTransform(bodyId);
     sf::Vector2f sfmlPos = b2VecToSfVec(transform.p);
@@ -458,20 +486,60 @@ void GameObject::updateShape() {
 }
 
 /**
- * @brief Draws the GameObject's SFML shape or sprite to the given render window.
- * @param window The SFML render window to draw on.
+ * @brief Applies the pending impulsion to a dynamic body and decays it.
  */
-void GameObject::draw(sf::RenderWindow& window) const {
+void GameObject::applyPendingImpulsion() {
+    if (B2_IS_NULL(bodyId) || !isDynamic_val_) return;
+    b2Body_ApplyLinearImpulseToCenter(bodyId, pendingImpulsion, true);
+    setPendingImpulsion(b2Vec2{pendingImpulsion.x/1.1f, pendingImpulsion.y/1.1f});
+}
 
-    if (isPlayer && sprite.has_value() && sprite->getTexture().getSize() != sf::Vector2u(0,0)) {
-        window.draw(*sprite);
-    } else if (!isPlayer && sprite.has_value() && sprite->getTexture().getSize() != sf::Vector2u(0,0)) { // Draw generic sprite
-        window.draw(*sprite);
-    } else if (hasVisual && !B2_IS_NULL(bodyId)) {
-        window.draw(sfShape);
+bool GameObject::drawnAsQuad() const {
+    return isDynamic_val_ && !isPlayer && hasVisual && !B2_IS_NULL(bodyId) && visibleSprite() == nullptr;
+}
+
+/**
+ * @brief Draws the GameObject's SFML shape or sprite to the given render target.
+ * @param target The SFML render target (window or render texture) to draw on.
+ */
+void GameObject::draw(sf::RenderTarget& target) const {
+    if (const sf::Sprite* visible = visibleSprite()) {
+        countedDraw(target, *visible);
+    } else if (const sf::RectangleShape* shape = visibleShape()) {
+        countedDraw(target, *shape);
+    }
+}
+
+const sf::Sprite* GameObject::visibleSprite() const {
+    // Player animation frame, or generic sprite of any other object
+    if (sprite.has_value() && sprite->getTexture().getSize() != sf::Vector2u(0,0)) {
+        return &*sprite;
+    }
+    return nullptr;
+}
+
+const sf::RectangleShape* GameObject::visibleShape() const {
+    if (visibleSprite() == nullptr && hasVisual && !B2_IS_NULL(bodyId)) {
+        return &sfShape;
+    }
+    return nullptr;
+}
+
+
+bool GameObject::ownsShape(b2ShapeId shape) const {
+    if (B2_ID_EQUALS(shapeId, shape)) return true;
+    for (const ShapePart& part : shapeParts) {
+        if (B2_ID_EQUALS(part.shapeId, shape)) return true;
     }
+    return false;
 }
 
+bool GameObject::canJumpOnShape(b2ShapeId shape) const {
+    for (const ShapePart& part : shapeParts) {
+        if (B2_ID_EQUALS(part.shapeId, shape)) return part.canJumpOn;
+    }
+    return canJumpOn;
+}
 
 /**
  * @brief Checks if the GameObject has a valid Box2D body.
@@ -480,42 +548,3 @@ void GameObject::draw(sf::RenderWindow& window) const {
 bool GameObject::isValid() const {
     return !B2_IS_NULL(bodyId);
 }
-
-void GameObject::ensureCorrectSpriteTextureLink() {
-    if (sprite.has_value()) {
-        if (!isPlayer && !spriteTexturePath_prop_.empty()) {
-            // For generic sprites, re-link to genericTexture_
-            if (genericTexture_.getSize().x > 0 && genericTexture_.getSize().y > 0) {
-                sprite->setTexture(genericTexture_, true); // true to reset texture rect
-                
-                // Set proper origin
-                sf::Vector2u textureSize = genericTexture_.getSize();
-                sprite->setOrigin(sf::Vector2f(static_cast<float>(textureSize.x) / 2.f, static_cast<float>(textureSize.y) / 2.f));
-                
-                // Scale will be handled in updateShape()
-            } else {
-                sprite.reset(); // Cannot use the sprite if its intended texture is bad.
-            }
-        } else if (isPlayer && !currentAnimationName.empty() && animations.count(currentAnimationName)) {
-            // For player sprites, re-link to the texture in the animations map
-            const auto& animFrames = animations[currentAnimationName];
-            if (currentFrame >= 0 && static_cast<size_t>(currentFrame) < animFrames.size()) {
-                if (animFrames[currentFrame].getSize().x > 0 && animFrames[currentFrame].getSize().y > 0) {
-                    sprite->setTexture(animFrames[currentFrame], true);
-                    
-                    // Set proper origin
-                    sf::Vector2u textureSize = animFrames[currentFrame].getSize();
-                    sprite->setOrigin(sf::Vector2f(static_cast<float>(textureSize.x) / 2.f, static_cast<float>(textureSize.y) / 2.f));
-                    
-                    // Scale will be handled in updateShape()
-                } else {
-                    std::cerr << "Invalid texture for current frame in animation: " << currentAnimationName << std::endl;
-                    sprite.reset();
-                }
-            } else {
-                std::cerr << "Current frame index out of bounds for animation: " << currentAnimationName << std::endl;
-                sprite.reset();
-            }
-        }
-    }
-}
@@ -0,0 +1,138 @@
+#include "input_queue.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+const std::chrono::steady_clock::time_point inputOrigin = std::chrono::steady_clock::now();
+
+/**
+ * @brief Action a key is bound to, or Count if it is not bound.
+ */
+InputAction bindingOf(sf::Keyboard::Key key) {
+    switch (key) {
+        case sf::Keyboard::Key::Left:
+        case sf::Keyboard::Key::Q:         return InputAction::MoveLeft;
+        case sf::Keyboard::Key::Right:
+        case sf::Keyboard::Key::D:         return InputAction::MoveRight;
+        case sf::Keyboard::Key::Space:
+        case sf::Keyboard::Key::Up:
+        case sf::Keyboard::Key::Z:         return InputAction::Jump;
+        case sf::Keyboard::Key::F:         return InputAction::TimeFreeze;
+        case sf::Keyboard::Key::Backspace: return InputAction::Rewind;
+        case sf::Keyboard::Key::R:         return InputAction::Reset;
+        case sf::Keyboard::Key::F1:        return InputAction::DebugShapes;
+        case sf::Keyboard::Key::F2:        return InputAction::DebugBounds;
+        case sf::Keyboard::Key::F3:        return InputAction::DebugJoints;
+        case sf::Keyboard::Key::F4:        return InputAction::DebugContacts;
+        default:                           return InputAction::Count;
+    }
+}
+
+} // namespace
+
+InputQueue::InputQueue() : ring_(INPUT_QUEUE_CAPACITY) {}
+
+int64_t InputQueue::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - inputOrigin).count();
+}
+
+bool InputQueue::push(const sf::Event& event) {
+    int64_t timeNs = nowNs();
+    if (event.is<sf::Event::FocusLost>()) {
+        // Releases are not reported to an unfocused window
+        bool pushed = true;
+        for (std::size_t i = 0; i < keysPerAction_.size(); ++i) {
+            if (keysPerAction_[i] > 0) {
+                keysPerAction_[i] = 0;
+                pushed = pushEdge(static_cast<InputAction>(i), false, timeNs) && pushed;
+            }
+        }
+        keysDown_.reset();
+        return pushed;
+    }
+
+    sf::Keyboard::Key key = sf::Keyboard::Key::Unknown;
+    bool pressed = false;
+    if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+        key = keyPressed->code;
+        pressed = true;
+    } else if (const auto* keyReleased = event.getIf<sf::Event::KeyReleased>()) {
+        key = keyReleased->code;
+    }
+    InputAction action = bindingOf(key);
+    if (action == InputAction::Count) {
+        return true;
+    }
+
+    std::size_t keyIndex = static_cast<std::size_t>(key);
+    if (keysDown_.test(keyIndex) == pressed) {
+        return true; // Auto-repeat, or a release whose press happened before the focus came back
+    }
+    keysDown_.set(keyIndex, pressed);
+    int& count = keysPerAction_[static_cast<std::size_t>(action)];
+    count += pressed ? 1 : -1;
+    // Only the first key down and the last key up of an action are edges
+    if (pressed ? count == 1 : count == 0) {
+        return pushEdge(action, pressed, timeNs);
+    }
+    return true;
+}
+
+bool InputQueue::pushEdge(InputAction action, bool pressed, int64_t timeNs) {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) >= ring_.size()) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    ring_[head % ring_.size()] = {timeNs, action, pressed};
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+InputStep InputQueue::resolve(int64_t stepTimeNs) {
+    InputStep step;
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    uint64_t head = head_.load(std::memory_order_acquire);
+    for (; tail < head; ++tail) {
+        const InputEvent& event = ring_[tail % ring_.size()];
+        if (event.timeNs > stepTimeNs) {
+            break; // Belongs to the next step
+        }
+        uint32_t bit = InputStep::bit(event.action);
+        if (event.pressed) {
+            held_ |= bit;
+            step.pressed |= bit;
+            if (step.firstPressNs < 0) {
+                step.firstPressNs = event.timeNs;
+            }
+            float ageMs = static_cast<float>(stepTimeNs - event.timeNs) * 1e-6f;
+            step.pressAge[static_cast<std::size_t>(event.action)] = ageMs * 1e-3f;
+            ++latencyCount_;
+            latencySumMs_ += ageMs;
+            latencyMaxMs_ = std::max(latencyMaxMs_, ageMs);
+        } else {
+            held_ &= ~bit;
+            step.released |= bit;
+        }
+    }
+    tail_.store(tail, std::memory_order_release);
+    step.held = held_;
+    return step;
+}
+
+InputLatencyStats InputQueue::latencyStats() const {
+    InputLatencyStats stats;
+    stats.presses = latencyCount_;
+    if (latencyCount_ > 0) {
+        stats.averageMs = static_cast<float>(latencySumMs_ / static_cast<double>(latencyCount_));
+    }
+    stats.maxMs = latencyMaxMs_;
+    return stats;
+}
+
+void InputQueue::resetLatencyStats() {
+    latencyCount_ = 0;
+    latencySumMs_ = 0.0;
+    latencyMaxMs_ = 0.0f;
+}
@@ -0,0 +1,71 @@
+#include "level_arena.hpp"
+#include "memory_tracker.hpp"
+#include <algorithm> // For std::max
+#include <cstdint>
+#include <new>
+
+LevelArena::LevelArena(std::size_t blockSize) : blockSize_(blockSize) {}
+
+LevelArena::~LevelArena() {
+    for (const Block& block : blocks_) {
+        MemoryTracker::instance().recordFree(MemorySubsystem::LevelArena, block.size);
+        ::operator delete(block.data);
+    }
+}
+
+void* LevelArena::allocate(std::size_t bytes, std::size_t alignment) {
+    // Look for room in the current block, then in the following (already reserved) ones
+    while (current_ < blocks_.size()) {
+        Block& block = blocks_[current_];
+        std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.data);
+        std::uintptr_t start = (base + offset_ + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+        if (start + bytes <= base + block.size) {
+            offset_ = static_cast<std::size_t>(start - base) + bytes;
+            last_ = reinterpret_cast<void*>(start);
+            usedBytes_ += bytes;
+            peakBytes_ = std::max(peakBytes_, usedBytes_);
+            ++allocationCount_;
+            return last_;
+        }
+        ++current_;
+        offset_ = 0;
+    }
+    addBlock(bytes + alignment);
+    return allocate(bytes, alignment);
+}
+
+void LevelArena::deallocate(void* ptr, std::size_t bytes) {
+    // Vectors free their old buffer right after growing, so only a buffer that was
+    // allocated last (and never followed by another allocation) can be rolled back.
+    if (ptr != nullptr && ptr == last_) {
+        offset_ -= bytes;
+        usedBytes_ -= bytes;
+        last_ = nullptr;
+    }
+}
+
+void LevelArena::reset() {
+    // Keep the first block for the next level, return the others to the heap
+    for (std::size_t i = 1; i < blocks_.size(); ++i) {
+        MemoryTracker::instance().recordFree(MemorySubsystem::LevelArena, blocks_[i].size);
+        ::operator delete(blocks_[i].data);
+    }
+    if (blocks_.size() > 1) {
+        blocks_.resize(1);
+    }
+    current_ = 0;
+    offset_ = 0;
+    last_ = nullptr;
+    usedBytes_ = 0;
+    allocationCount_ = 0;
+}
+
+void LevelArena::addBlock(std::size_t minSize) {
+    Block block;
+    block.size = std::max(blockSize_, minSize);
+    block.data = static_cast<char*>(::operator new(block.size));
+    MemoryTracker::instance().recordAllocation(MemorySubsystem::LevelArena, block.size);
+    blocks_.push_back(block);
+    current_ = blocks_.size() - 1;
+    offset_ = 0;
+}
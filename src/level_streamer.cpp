@@ -0,0 +1,184 @@
+#include "level_streamer.hpp"
+#include <algorithm>     // For std::sort, std::remove_if
+#include <chrono>        // For the activation budget
+#include <unordered_map>
+#include <unordered_set>
+
+void LevelStreamer::addChunk(float minX_m, float maxX_m, ChunkBuilder builder) {
+    Chunk chunk;
+    chunk.minX_m = std::min(minX_m, maxX_m);
+    chunk.maxX_m = std::max(minX_m, maxX_m);
+    chunk.builder = std::move(builder);
+    chunks_.push_back(std::move(chunk));
+}
+
+bool LevelStreamer::prime(b2WorldId worldId, GameObjectList& gameObjects, float focusX_m) {
+    return activateInRange(worldId, gameObjects, focusX_m, false);
+}
+
+bool LevelStreamer::update(b2WorldId worldId, GameObjectList& gameObjects, float focusX_m) {
+    bool changed = false;
+
+    // Deactivation is cheap compared to activation, so it is never deferred.
+    for (Chunk& chunk : chunks_) {
+        if (chunk.active && distanceTo(chunk, focusX_m) > STREAMING_UNLOAD_RADIUS_M) {
+            deactivate(chunk, gameObjects);
+            changed = true;
+        }
+    }
+
+    if (activateInRange(worldId, gameObjects, focusX_m, true)) {
+        changed = true;
+    }
+    return changed;
+}
+
+void LevelStreamer::clear() {
+    chunks_.clear();
+}
+
+std::size_t LevelStreamer::activeChunkCount() const {
+    return static_cast<std::size_t>(std::count_if(chunks_.begin(), chunks_.end(),
+                                                   [](const Chunk& chunk) { return chunk.active; }));
+}
+
+bool LevelStreamer::extent(float& minX_m, float& maxX_m) const {
+    if (chunks_.empty()) return false;
+    minX_m = chunks_.front().minX_m;
+    maxX_m = chunks_.front().maxX_m;
+    for (const Chunk& chunk : chunks_) {
+        minX_m = std::min(minX_m, chunk.minX_m);
+        maxX_m = std::max(maxX_m, chunk.maxX_m);
+    }
+    return true;
+}
+
+/**
+ * @brief Horizontal distance from the focus point to the chunk extent (0 if inside).
+ */
+float LevelStreamer::distanceTo(const Chunk& chunk, float focusX_m) const {
+    if (focusX_m < chunk.minX_m) return chunk.minX_m - focusX_m;
+    if (focusX_m > chunk.maxX_m) return focusX_m - chunk.maxX_m;
+    return 0.0f;
+}
+
+/**
+ * @brief Activates inactive chunks within the load radius, nearest first.
+ * When budgeted, stops once STREAMING_BUDGET_MS is spent (but always activates at least one).
+ */
+bool LevelStreamer::activateInRange(b2WorldId worldId, GameObjectList& gameObjects, float focusX_m, bool budgeted) {
+    std::vector<std::size_t> pending;
+    for (std::size_t i = 0; i < chunks_.size(); ++i) {
+        if (!chunks_[i].active && distanceTo(chunks_[i], focusX_m) <= STREAMING_LOAD_RADIUS_M) {
+            pending.push_back(i);
+        }
+    }
+    if (pending.empty()) return false;
+
+    std::sort(pending.begin(), pending.end(), [&](std::size_t a, std::size_t b) {
+        return distanceTo(chunks_[a], focusX_m) < distanceTo(chunks_[b], focusX_m);
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t index : pending) {
+        activate(worldId, chunks_[index], gameObjects);
+        if (budgeted) {
+            std::chrono::duration<float, std::milli> spent = std::chrono::steady_clock::now() - start;
+            if (spent.count() >= STREAMING_BUDGET_MS) break; // Continue next frame
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Runs the chunk builder and restores the state saved at the last deactivation.
+ */
+void LevelStreamer::activate(b2WorldId worldId, Chunk& chunk, GameObjectList& gameObjects) {
+    std::size_t firstNew = gameObjects.size();
+    chunk.builder(worldId, gameObjects);
+    chunk.active = true;
+
+    std::vector<GameObject*> created;
+    for (std::size_t i = firstNew; i < gameObjects.size(); ++i) {
+        if (gameObjects[i].isValid()) {
+            created.push_back(&gameObjects[i]);
+        }
+    }
+
+    bool restore = !chunk.bodies.empty() && chunk.bodies.size() == created.size() && chunk.saved.size() == created.size();
+    chunk.bodies.clear();
+    for (std::size_t i = 0; i < created.size(); ++i) {
+        GameObject& obj = *created[i];
+        chunk.bodies.push_back(b2StoreBodyId(obj.bodyId));
+        if (restore && obj.isDynamic_val_ && chunk.saved[i].valid) {
+            const SavedBodyState& state = chunk.saved[i];
+            b2Body_SetTransform(obj.bodyId, state.position, state.rotation);
+            b2Body_SetLinearVelocity(obj.bodyId, state.linearVelocity);
+            b2Body_SetAngularVelocity(obj.bodyId, state.angularVelocity);
+        }
+    }
+}
+
+/**
+ * @brief Saves dynamic state, destroys the chunk's bodies and removes its GameObjects.
+ * Bodies created by the builder without a GameObject (e.g. joint anchors) are found
+ * through the chunk's joints and destroyed as well.
+ */
+void LevelStreamer::deactivate(Chunk& chunk, GameObjectList& gameObjects) {
+    std::unordered_map<uint64_t, std::size_t> ordinals;
+    for (std::size_t i = 0; i < chunk.bodies.size(); ++i) {
+        ordinals[chunk.bodies[i]] = i;
+    }
+
+    std::unordered_set<uint64_t> owned; // Bodies belonging to any GameObject
+    owned.reserve(gameObjects.size());
+    for (const GameObject& obj : gameObjects) {
+        if (obj.isValid()) owned.insert(b2StoreBodyId(obj.bodyId));
+    }
+
+    chunk.saved.assign(chunk.bodies.size(), SavedBodyState{});
+    std::vector<b2BodyId> orphans;
+    std::vector<b2JointId> joints;
+    for (const GameObject& obj : gameObjects) {
+        if (!obj.isValid()) continue;
+        auto it = ordinals.find(b2StoreBodyId(obj.bodyId));
+        if (it == ordinals.end()) continue;
+
+        SavedBodyState& state = chunk.saved[it->second];
+        b2Transform transform = b2Body_GetTransform(obj.bodyId);
+        state.position = transform.p;
+        state.rotation = transform.q;
+        state.linearVelocity = b2Body_GetLinearVelocity(obj.bodyId);
+        state.angularVelocity = b2Body_GetAngularVelocity(obj.bodyId);
+        state.valid = true;
+
+        joints.resize(static_cast<std::size_t>(b2Body_GetJointCount(obj.bodyId)));
+        int jointCount = b2Body_GetJoints(obj.bodyId, joints.data(), static_cast<int>(joints.size()));
+        for (int j = 0; j < jointCount; ++j) {
+            for (b2BodyId other : {b2Joint_GetBodyA(joints[j]), b2Joint_GetBodyB(joints[j])}) {
+                uint64_t otherKey = b2StoreBodyId(other);
+                if (owned.count(otherKey) == 0) {
+                    owned.insert(otherKey); // Only collect each orphan once
+                    orphans.push_back(other);
+                }
+            }
+        }
+    }
+
+    for (b2BodyId orphan : orphans) {
+        b2DestroyBody(orphan);
+    }
+    for (uint64_t bodyKey : chunk.bodies) {
+        b2BodyId bodyId = b2LoadBodyId(bodyKey);
+        if (b2Body_IsValid(bodyId)) {
+            b2DestroyBody(bodyId); // Also destroys the body's shapes and joints
+        }
+    }
+
+    gameObjects.erase(std::remove_if(gameObjects.begin(), gameObjects.end(),
+                                     [&](const GameObject& obj) {
+                                         return obj.isValid() && ordinals.count(b2StoreBodyId(obj.bodyId)) != 0;
+                                     }),
+                      gameObjects.end());
+    chunk.active = false;
+}
@@ -0,0 +1,285 @@
+#include "logger.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+const std::chrono::steady_clock::time_point logOrigin = std::chrono::steady_clock::now();
+
+int64_t logNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - logOrigin).count();
+}
+
+const char* levelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug:   return "DEBUG";
+        case LogLevel::Info:    return "INFO";
+        case LogLevel::Warning: return "WARN";
+        case LogLevel::Error:   return "ERROR";
+    }
+    return "?";
+}
+
+const char* categoryName(LogCategory category) {
+    switch (category) {
+        case LogCategory::General:  return "general";
+        case LogCategory::Loading:  return "loading";
+        case LogCategory::Gameplay: return "gameplay";
+        case LogCategory::Physics:  return "physics";
+        case LogCategory::Render:   return "render";
+        case LogCategory::Assets:   return "assets";
+        case LogCategory::Memory:   return "memory";
+        case LogCategory::Count:    break;
+    }
+    return "?";
+}
+
+} // namespace
+
+/**
+ * @brief Ring of one thread. Owned by the registry so it survives the thread.
+ */
+struct Logger::ThreadBuffer {
+    std::vector<LogRecord> records;
+    std::atomic<uint64_t> head {0};    // Records ever published; written by the owner thread
+    std::atomic<uint64_t> tail {0};    // Records ever written out; written by the drain thread
+    std::atomic<uint64_t> dropped {0}; // Messages that found the ring full
+    bool building {false};             // Owner thread: a LogLine holds the slot at head
+    uint64_t drainHead {0};            // Drain thread: head seen by the current drain
+    uint64_t reportedDropped {0};      // Drain thread
+    int threadId {0};
+};
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger() {
+    thread_ = std::thread(&Logger::run, this);
+}
+
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    thread_.join(); // The last drain writes everything still buffered
+    if (ownsSink_) {
+        std::fclose(sink_);
+    }
+}
+
+void Logger::setMinLevel(LogLevel level) {
+    minLevel_.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+void Logger::setCategoryEnabled(LogCategory category, bool enabled) {
+    uint32_t bit = 1u << static_cast<unsigned>(category);
+    if (enabled) {
+        categoryMask_.fetch_or(bit, std::memory_order_relaxed);
+    } else {
+        categoryMask_.fetch_and(~bit, std::memory_order_relaxed);
+    }
+}
+
+bool Logger::openFile(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        LOG_ERROR(LogCategory::General) << "Failed to open log file: " << path;
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(sinkMutex_);
+    if (ownsSink_) {
+        std::fclose(sink_);
+    }
+    sink_ = file;
+    ownsSink_ = true;
+    return true;
+}
+
+void Logger::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    uint64_t target = ++flushRequests_;
+    wake_.notify_one();
+    drained_.wait(lock, [&] { return flushesDone_ >= target; });
+}
+
+uint64_t Logger::droppedCount() const {
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    uint64_t dropped = 0;
+    for (const auto& buffer : registry_) {
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+Logger::ThreadBuffer& Logger::threadBuffer() {
+    thread_local std::shared_ptr<ThreadBuffer> local;
+    if (!local) {
+        local = std::make_shared<ThreadBuffer>();
+        local->records.resize(LOG_RING_CAPACITY);
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        local->threadId = static_cast<int>(registry_.size()) + 1;
+        registry_.push_back(local);
+    }
+    return *local;
+}
+
+LogRecord* Logger::reserve() {
+    ThreadBuffer& buffer = threadBuffer();
+    uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    if (buffer.building || head - buffer.tail.load(std::memory_order_acquire) >= buffer.records.size()) {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    buffer.building = true;
+    return &buffer.records[head % buffer.records.size()];
+}
+
+void Logger::publish() {
+    ThreadBuffer& buffer = threadBuffer();
+    buffer.head.store(buffer.head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    buffer.building = false;
+}
+
+void Logger::run() {
+    TRACE_THREAD_NAME("Logger");
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait_for(lock, std::chrono::milliseconds(LOG_DRAIN_INTERVAL_MS),
+                       [this] { return stopping_ || flushRequests_ != flushesDone_; });
+        uint64_t requests = flushRequests_;
+        bool stopping = stopping_;
+        lock.unlock();
+        drain();
+        lock.lock();
+        flushesDone_ = requests;
+        drained_.notify_all();
+        if (stopping) {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Writes out every published record, oldest first across threads, then frees their slots.
+ */
+void Logger::drain() {
+    TRACE_ZONE("Log drain");
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        buffers = registry_;
+    }
+
+    pending_.clear();
+    for (const auto& buffer : buffers) {
+        buffer->drainHead = buffer->head.load(std::memory_order_acquire);
+        for (uint64_t i = buffer->tail.load(std::memory_order_relaxed); i < buffer->drainHead; ++i) {
+            pending_.push_back(&buffer->records[i % buffer->records.size()]);
+        }
+    }
+    std::stable_sort(pending_.begin(), pending_.end(),
+                     [](const LogRecord* a, const LogRecord* b) { return a->timeNs < b->timeNs; });
+
+    out_.clear();
+    char prefix[64];
+    for (const LogRecord* record : pending_) {
+        int length = std::snprintf(prefix, sizeof(prefix), "[%9.3f] %-5s %-8s ",
+                                   static_cast<double>(record->timeNs) * 1e-9, levelName(record->level),
+                                   categoryName(record->category));
+        out_.append(prefix, static_cast<std::size_t>(std::max(0, length)));
+        out_.append(record->text, record->length);
+        out_.push_back('\n');
+    }
+    for (const auto& buffer : buffers) {
+        uint64_t dropped = buffer->dropped.load(std::memory_order_relaxed);
+        if (dropped != buffer->reportedDropped) {
+            int length = std::snprintf(prefix, sizeof(prefix), "[%9.3f] WARN  general  ",
+                                       static_cast<double>(logNowNs()) * 1e-9);
+            out_.append(prefix, static_cast<std::size_t>(std::max(0, length)));
+            out_ += std::to_string(dropped - buffer->reportedDropped) + " log messages dropped on thread " +
+                    std::to_string(buffer->threadId) + "\n";
+            buffer->reportedDropped = dropped;
+        }
+    }
+
+    if (!out_.empty()) {
+        std::lock_guard<std::mutex> lock(sinkMutex_);
+        std::fwrite(out_.data(), 1, out_.size(), sink_);
+        std::fflush(sink_);
+    }
+    for (const auto& buffer : buffers) {
+        buffer->tail.store(buffer->drainHead, std::memory_order_release);
+    }
+}
+
+LogLine::LogLine(LogLevel level, LogCategory category, uint32_t suppressed)
+    : record_(Logger::instance().reserve()), suppressed_(suppressed) {
+    if (record_ != nullptr) {
+        record_->timeNs = logNowNs();
+        record_->level = level;
+        record_->category = category;
+        record_->length = 0;
+    }
+}
+
+LogLine::~LogLine() {
+    if (record_ == nullptr) {
+        return;
+    }
+    if (suppressed_ > 0) {
+        *this << " (" << suppressed_ << " similar messages suppressed)";
+    }
+    Logger::instance().publish();
+}
+
+LogLine& LogLine::operator<<(const char* text) {
+    append(text, text != nullptr ? std::strlen(text) : 0);
+    return *this;
+}
+
+void LogLine::append(const char* text, std::size_t length) {
+    if (record_ == nullptr) {
+        return;
+    }
+    std::size_t room = LOG_MESSAGE_BYTES - record_->length;
+    std::size_t count = std::min(length, room);
+    std::memcpy(record_->text + record_->length, text, count);
+    record_->length = static_cast<uint16_t>(record_->length + count);
+}
+
+LogLine& LogLine::appendSigned(long long value) {
+    char digits[24];
+    int length = std::snprintf(digits, sizeof(digits), "%lld", value);
+    append(digits, static_cast<std::size_t>(std::max(0, length)));
+    return *this;
+}
+
+LogLine& LogLine::appendUnsigned(unsigned long long value) {
+    char digits[24];
+    int length = std::snprintf(digits, sizeof(digits), "%llu", value);
+    append(digits, static_cast<std::size_t>(std::max(0, length)));
+    return *this;
+}
+
+LogLine& LogLine::appendFloat(double value) {
+    char digits[32];
+    int length = std::snprintf(digits, sizeof(digits), "%g", value);
+    append(digits, static_cast<std::size_t>(std::max(0, length)));
+    return *this;
+}
+
+bool LogRateLimiter::allow() {
+    int64_t now = logNowNs();
+    int64_t next = nextAllowedNs_.load(std::memory_order_relaxed);
+    if (now >= next && nextAllowedNs_.compare_exchange_strong(next, now + periodNs_, std::memory_order_relaxed)) {
+        return true;
+    }
+    suppressed_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
@@ -0,0 +1,101 @@
+#include "memory_tracker.hpp"
+#include <cstdlib>  // For std::exit
+#include <iostream>
+#include <new>      // For aligned operator new
+
+namespace {
+
+const char* subsystemName(MemorySubsystem subsystem) {
+    switch (subsystem) {
+        case MemorySubsystem::Box2D: return "Box2D";
+        case MemorySubsystem::LevelArena: return "Level arena";
+        case MemorySubsystem::TimeRewind: return "Time rewind";
+        default: return "?";
+    }
+}
+
+// Box2D's free callback does not pass the size, so each block starts with a header
+// whose last two words hold the payload size and the header size. The header is a
+// whole number of alignment units so the payload stays aligned.
+void* box2dAlloc(unsigned int size, int alignment) {
+    std::size_t headerSize = static_cast<std::size_t>(alignment);
+    while (headerSize < 2 * sizeof(std::size_t)) {
+        headerSize *= 2;
+    }
+    void* block = ::operator new(headerSize + size, std::align_val_t(headerSize), std::nothrow);
+    if (block == nullptr) {
+        std::cerr << "Box2D allocation of " << size << " bytes failed." << std::endl;
+        std::exit(EXIT_FAILURE); // Box2D cannot recover from a failed allocation
+    }
+    char* payload = static_cast<char*>(block) + headerSize;
+    std::size_t* fields = reinterpret_cast<std::size_t*>(payload) - 2;
+    fields[0] = size;
+    fields[1] = headerSize;
+    MemoryTracker::instance().recordAllocation(MemorySubsystem::Box2D, size);
+    return payload;
+}
+
+void box2dFree(void* mem) {
+    if (mem == nullptr) return;
+    std::size_t* fields = static_cast<std::size_t*>(mem) - 2;
+    std::size_t size = fields[0];
+    std::size_t headerSize = fields[1];
+    MemoryTracker::instance().recordFree(MemorySubsystem::Box2D, size);
+    ::operator delete(static_cast<char*>(mem) - headerSize, std::align_val_t(headerSize));
+}
+
+} // namespace
+
+MemoryTracker& MemoryTracker::instance() {
+    static MemoryTracker tracker;
+    return tracker;
+}
+
+void MemoryTracker::installBox2DAllocator() {
+    instance(); // Construct the tracker before Box2D can call into it
+    b2SetAllocator(box2dAlloc, box2dFree);
+}
+
+void MemoryTracker::recordAllocation(MemorySubsystem subsystem, std::size_t bytes) {
+    Counters& counters = counters_[static_cast<std::size_t>(subsystem)];
+    int64_t now = counters.bytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed) + static_cast<int64_t>(bytes);
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    int64_t peak = counters.peakBytes.load(std::memory_order_relaxed);
+    while (now > peak && !counters.peakBytes.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+    }
+}
+
+void MemoryTracker::recordFree(MemorySubsystem subsystem, std::size_t bytes) {
+    Counters& counters = counters_[static_cast<std::size_t>(subsystem)];
+    counters.bytes.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+    counters.frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+MemoryTracker::Stats MemoryTracker::stats(MemorySubsystem subsystem) const {
+    const Counters& counters = counters_[static_cast<std::size_t>(subsystem)];
+    Stats stats;
+    stats.bytes = counters.bytes.load(std::memory_order_relaxed);
+    stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+    stats.allocations = counters.allocations.load(std::memory_order_relaxed);
+    stats.frees = counters.frees.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void MemoryTracker::resetPeak(MemorySubsystem subsystem) {
+    Counters& counters = counters_[static_cast<std::size_t>(subsystem)];
+    counters.peakBytes.store(counters.bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void MemoryTracker::report(std::ostream& out, b2WorldId worldId) const {
+    for (std::size_t i = 0; i < counters_.size(); ++i) {
+        MemorySubsystem subsystem = static_cast<MemorySubsystem>(i);
+        Stats current = stats(subsystem);
+        out << "Memory [" << subsystemName(subsystem) << "]: " << current.bytes << " bytes, peak "
+            << current.peakBytes << " bytes, " << current.allocations << " allocations, "
+            << current.frees << " frees" << std::endl;
+    }
+    if (!B2_IS_NULL(worldId) && b2World_IsValid(worldId)) {
+        b2World_DumpMemoryStats(worldId);
+        out << "Box2D world breakdown written to box2d_memory.txt" << std::endl;
+    }
+}
@@ -0,0 +1,211 @@
+#include "particle_system.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTICLE_SYSTEM_SSE2 1
+#endif
+
+namespace {
+
+const unsigned int GLOW_TEXTURE_SIZE = 16;
+
+inline std::size_t poolIndex(ParticlePool pool) {
+    return static_cast<std::size_t>(pool);
+}
+
+} // namespace
+
+ParticleSystem::ParticleSystem(std::size_t capacity) : capacity_(capacity), cap_(capacity) {
+    for (Pool& pool : pools_) {
+        pool.positionX.resize(capacity);
+        pool.positionY.resize(capacity);
+        pool.velocityX.resize(capacity);
+        pool.velocityY.resize(capacity);
+        pool.age.resize(capacity);
+        pool.lifetime.resize(capacity);
+        pool.halfSize.resize(capacity);
+        pool.color.resize(capacity);
+    }
+    Pool& dust = pools_[poolIndex(ParticlePool::Dust)];
+    dust.gravity = -6.0f;
+    dust.drag = 1.5f;
+    dust.pausedWithWorld = true;
+    Pool& glow = pools_[poolIndex(ParticlePool::Glow)];
+    glow.gravity = 0.0f;
+    glow.drag = 3.0f;
+
+    // Pool, count, spread, speed, lifetime and half size (min, max), color
+    emitters_[static_cast<std::size_t>(ParticleEffect::FreezeBurst)] =
+        {ParticlePool::Glow, 48, B2_PI, 3.0f, 6.0f, 0.5f, 0.9f, 0.08f, 0.16f, sf::Color(150, 200, 255, 220)};
+    emitters_[static_cast<std::size_t>(ParticleEffect::Landing)] =
+        {ParticlePool::Dust, 10, 1.2f, 0.8f, 2.0f, 0.25f, 0.45f, 0.03f, 0.06f, sf::Color(190, 180, 160, 200)};
+    emitters_[static_cast<std::size_t>(ParticleEffect::TremplinBounce)] =
+        {ParticlePool::Dust, 16, 0.5f, 3.0f, 5.0f, 0.3f, 0.6f, 0.03f, 0.05f, sf::Color(255, 220, 80, 230)};
+    emitters_[static_cast<std::size_t>(ParticleEffect::Impact)] =
+        {ParticlePool::Dust, 8, 1.3f, 1.0f, 2.5f, 0.25f, 0.5f, 0.03f, 0.07f, sf::Color(170, 130, 90, 220)};
+}
+
+bool ParticleSystem::loadTextures() {
+    // White disc fading out towards its edge
+    sf::Image image(sf::Vector2u(GLOW_TEXTURE_SIZE, GLOW_TEXTURE_SIZE), sf::Color::Transparent);
+    const float radius = GLOW_TEXTURE_SIZE / 2.0f;
+    for (unsigned int y = 0; y < GLOW_TEXTURE_SIZE; ++y) {
+        for (unsigned int x = 0; x < GLOW_TEXTURE_SIZE; ++x) {
+            float dx = (x + 0.5f - radius) / radius;
+            float dy = (y + 0.5f - radius) / radius;
+            float falloff = std::max(0.0f, 1.0f - std::sqrt(dx * dx + dy * dy));
+            image.setPixel({x, y}, sf::Color(255, 255, 255, static_cast<std::uint8_t>(255.0f * falloff * falloff)));
+        }
+    }
+    Pool& glow = pools_[poolIndex(ParticlePool::Glow)];
+    if (!glowTexture_.loadFromImage(image)) {
+        glow.texture = nullptr;
+        return false;
+    }
+    glowTexture_.setSmooth(true);
+    glow.texture = &glowTexture_;
+    return true;
+}
+
+void ParticleSystem::emit(ParticleEffect effect, b2Vec2 position, b2Vec2 direction, float strength) {
+    const Emitter& emitter = emitters_[static_cast<std::size_t>(effect)];
+    Pool& pool = pools_[poolIndex(emitter.pool)];
+    std::size_t wanted = static_cast<std::size_t>(std::max(0.0f, std::round(emitter.count * strength)));
+    std::size_t limit = std::min(capacity_, cap_);
+    std::size_t room = limit > pool.count ? limit - pool.count : 0;
+    std::size_t emitted = std::min(wanted, room);
+    dropped_ += wanted - emitted;
+
+    float baseAngle = (direction.x != 0.0f || direction.y != 0.0f) ? std::atan2(direction.y, direction.x) : 0.0f;
+    for (std::size_t n = 0; n < emitted; ++n) {
+        std::size_t i = pool.count++;
+        float angle = baseAngle + (2.0f * random01() - 1.0f) * emitter.spread;
+        float speed = strength * (emitter.speedMin + (emitter.speedMax - emitter.speedMin) * random01());
+        pool.positionX[i] = position.x;
+        pool.positionY[i] = position.y;
+        pool.velocityX[i] = speed * std::cos(angle);
+        pool.velocityY[i] = speed * std::sin(angle);
+        pool.age[i] = 0.0f;
+        pool.lifetime[i] = emitter.lifeMin + (emitter.lifeMax - emitter.lifeMin) * random01();
+        pool.halfSize[i] = emitter.sizeMin + (emitter.sizeMax - emitter.sizeMin) * random01();
+        pool.color[i] = emitter.color;
+    }
+}
+
+void ParticleSystem::update(float dt, bool worldPaused) {
+    for (Pool& pool : pools_) {
+        if (pool.count == 0 || (worldPaused && pool.pausedWithWorld)) {
+            continue;
+        }
+        integrate(pool, dt);
+        removeDead(pool);
+    }
+}
+
+void ParticleSystem::integrate(Pool& pool, float dt) {
+    const float damping = std::max(0.0f, 1.0f - pool.drag * dt);
+    const float gravityStep = pool.gravity * dt;
+    float* x = pool.positionX.data();
+    float* y = pool.positionY.data();
+    float* vx = pool.velocityX.data();
+    float* vy = pool.velocityY.data();
+    float* age = pool.age.data();
+    std::size_t i = 0;
+
+#ifdef PARTICLE_SYSTEM_SSE2
+    const __m128 damping4 = _mm_set1_ps(damping);
+    const __m128 gravity4 = _mm_set1_ps(gravityStep);
+    const __m128 dt4 = _mm_set1_ps(dt);
+    for (; i + 4 <= pool.count; i += 4) {
+        __m128 velocityX = _mm_mul_ps(_mm_loadu_ps(vx + i), damping4);
+        __m128 velocityY = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vy + i), damping4), gravity4);
+        _mm_storeu_ps(vx + i, velocityX);
+        _mm_storeu_ps(vy + i, velocityY);
+        _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(velocityX, dt4)));
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(velocityY, dt4)));
+        _mm_storeu_ps(age + i, _mm_add_ps(_mm_loadu_ps(age + i), dt4));
+    }
+#endif
+
+    for (; i < pool.count; ++i) {
+        vx[i] *= damping;
+        vy[i] = vy[i] * damping + gravityStep;
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        age[i] += dt;
+    }
+}
+
+void ParticleSystem::removeDead(Pool& pool) {
+    std::size_t i = 0;
+    while (i < pool.count) {
+        if (pool.age[i] < pool.lifetime[i]) {
+            ++i;
+            continue;
+        }
+        // The last live particle takes the slot, and is checked in turn
+        std::size_t last = --pool.count;
+        pool.positionX[i] = pool.positionX[last];
+        pool.positionY[i] = pool.positionY[last];
+        pool.velocityX[i] = pool.velocityX[last];
+        pool.velocityY[i] = pool.velocityY[last];
+        pool.age[i] = pool.age[last];
+        pool.lifetime[i] = pool.lifetime[last];
+        pool.halfSize[i] = pool.halfSize[last];
+        pool.color[i] = pool.color[last];
+    }
+}
+
+void ParticleSystem::writeBatches(std::vector<ParticleBatch>& batches) const {
+    const float scale = PIXELS_PER_METER;
+    const float height = static_cast<float>(WINDOW_HEIGHT);
+    batches.resize(pools_.size());
+    for (std::size_t p = 0; p < pools_.size(); ++p) {
+        const Pool& pool = pools_[p];
+        ParticleBatch& batch = batches[p];
+        batch.texture = pool.texture;
+        batch.vertices.resize(pool.count * PARTICLE_VERTICES_PER_QUAD);
+        sf::Vector2f textureSize = pool.texture ? sf::Vector2f(pool.texture->getSize()) : sf::Vector2f(0.0f, 0.0f);
+        sf::Vertex* out = batch.vertices.data();
+        for (std::size_t i = 0; i < pool.count; ++i, out += PARTICLE_VERTICES_PER_QUAD) {
+            float px = pool.positionX[i] * scale;
+            float py = height - pool.positionY[i] * scale;
+            float h = pool.halfSize[i] * scale;
+            sf::Color color = pool.color[i];
+            color.a = static_cast<std::uint8_t>(color.a * (1.0f - std::min(pool.age[i] / pool.lifetime[i], 1.0f)));
+            // Two triangles: top-left, top-right, bottom-right and top-left, bottom-right, bottom-left
+            out[0] = {{px - h, py - h}, color, {0.0f, 0.0f}};
+            out[1] = {{px + h, py - h}, color, {textureSize.x, 0.0f}};
+            out[2] = {{px + h, py + h}, color, textureSize};
+            out[3] = out[0];
+            out[4] = out[2];
+            out[5] = {{px - h, py + h}, color, {0.0f, textureSize.y}};
+        }
+    }
+}
+
+void ParticleSystem::clear() {
+    for (Pool& pool : pools_) {
+        pool.count = 0;
+    }
+}
+
+std::size_t ParticleSystem::liveCount() const {
+    std::size_t count = 0;
+    for (const Pool& pool : pools_) {
+        count += pool.count;
+    }
+    return count;
+}
+
+/**
+ * @brief Uniform in [0, 1), from a xorshift32 generator.
+ */
+float ParticleSystem::random01() {
+    randomState_ ^= randomState_ << 13;
+    randomState_ ^= randomState_ >> 17;
+    randomState_ ^= randomState_ << 5;
+    return static_cast<float>(randomState_ >> 8) * (1.0f / 16777216.0f);
+}
@@ -0,0 +1,190 @@
+#include "physics_debug_draw.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const float TRANSFORM_AXIS_LENGTH = 0.3f; // Meters
+
+inline sf::Color toColor(b2HexColor color) {
+    uint32_t rgb = static_cast<uint32_t>(color);
+    return sf::Color(static_cast<std::uint8_t>(rgb >> 16), static_cast<std::uint8_t>(rgb >> 8), static_cast<std::uint8_t>(rgb));
+}
+
+// Direction d turned by the angle whose cosine and sine are r.x and r.y
+inline b2Vec2 turn(b2Vec2 d, b2Vec2 r) {
+    return {d.x * r.x - d.y * r.y, d.x * r.y + d.y * r.x};
+}
+
+} // namespace
+
+PhysicsDebugDraw::PhysicsDebugDraw() : draw_(b2DefaultDebugDraw()) {
+    static_assert(DEBUG_DRAW_CIRCLE_SEGMENTS % 2 == 0, "Capsule ends are half circles of the table");
+    for (int i = 0; i < DEBUG_DRAW_CIRCLE_SEGMENTS; ++i) {
+        float angle = 2.0f * B2_PI * static_cast<float>(i) / static_cast<float>(DEBUG_DRAW_CIRCLE_SEGMENTS);
+        circle_[i] = {std::cos(angle), std::sin(angle)};
+    }
+    outline_.reserve(DEBUG_DRAW_CIRCLE_SEGMENTS + 2);
+
+    draw_.DrawPolygonFcn = drawPolygon;
+    draw_.DrawSolidPolygonFcn = drawSolidPolygon;
+    draw_.DrawCircleFcn = drawCircle;
+    draw_.DrawSolidCircleFcn = drawSolidCircle;
+    draw_.DrawSolidCapsuleFcn = drawSolidCapsule;
+    draw_.DrawSegmentFcn = drawSegment;
+    draw_.DrawTransformFcn = drawTransform;
+    draw_.DrawPointFcn = drawPoint;
+    draw_.context = this;
+}
+
+void PhysicsDebugDraw::setEnabled(DebugDrawCategory category, bool enabled) {
+    if (enabled) {
+        enabled_ |= bit(category);
+    } else {
+        enabled_ &= ~bit(category);
+    }
+}
+
+bool PhysicsDebugDraw::toggle(DebugDrawCategory category) {
+    enabled_ ^= bit(category);
+    return enabled(category);
+}
+
+void PhysicsDebugDraw::capture(b2WorldId worldId, const sf::View& view, PhysicsDebugBatch& batch) {
+    batch.clear();
+    if (!anyEnabled()) {
+        return;
+    }
+    draw_.drawShapes = enabled(DebugDrawCategory::Shapes);
+    draw_.drawBounds = enabled(DebugDrawCategory::Bounds);
+    draw_.drawJoints = enabled(DebugDrawCategory::Joints);
+    draw_.drawContacts = enabled(DebugDrawCategory::Contacts);
+    draw_.drawContactNormals = draw_.drawContacts;
+
+    // Only the shapes whose bounds overlap the view are visited
+    sf::Vector2f halfSize = view.getSize() / 2.0f;
+    b2Vec2 a = sfVecToB2Vec(view.getCenter() - halfSize);
+    b2Vec2 b = sfVecToB2Vec(view.getCenter() + halfSize);
+    draw_.drawingBounds = {b2Min(a, b), b2Max(a, b)};
+    draw_.useDrawingBounds = true;
+
+    batch_ = &batch;
+    b2World_Draw(worldId, &draw_);
+    batch_ = nullptr;
+}
+
+void PhysicsDebugDraw::drawPolygon(const b2Vec2* vertices, int vertexCount, b2HexColor color, void* context) {
+    static_cast<PhysicsDebugDraw*>(context)->appendPolygon(vertices, vertexCount, color, false);
+}
+
+void PhysicsDebugDraw::drawSolidPolygon(b2Transform transform, const b2Vec2* vertices, int vertexCount, float radius,
+                                        b2HexColor color, void* context) {
+    (void)radius; // Rounded corners are not drawn
+    auto* self = static_cast<PhysicsDebugDraw*>(context);
+    b2Vec2 world[B2_MAX_POLYGON_VERTICES];
+    int count = std::min(vertexCount, B2_MAX_POLYGON_VERTICES);
+    for (int i = 0; i < count; ++i) {
+        world[i] = b2TransformPoint(transform, vertices[i]);
+    }
+    self->appendPolygon(world, count, color, true);
+}
+
+void PhysicsDebugDraw::drawCircle(b2Vec2 center, float radius, b2HexColor color, void* context) {
+    static_cast<PhysicsDebugDraw*>(context)->appendCircle(center, {1.0f, 0.0f}, radius, color, false);
+}
+
+void PhysicsDebugDraw::drawSolidCircle(b2Transform transform, float radius, b2HexColor color, void* context) {
+    static_cast<PhysicsDebugDraw*>(context)->appendCircle(transform.p, {transform.q.c, transform.q.s}, radius, color, true);
+}
+
+void PhysicsDebugDraw::drawSolidCapsule(b2Vec2 p1, b2Vec2 p2, float radius, b2HexColor color, void* context) {
+    auto* self = static_cast<PhysicsDebugDraw*>(context);
+    b2Vec2 axis = b2Normalize(b2Sub(p2, p1));
+    b2Vec2 normal = b2LeftPerp(axis);
+    // Counter-clockwise: around p2 from -normal to normal, then around p1 back to -normal
+    self->outline_.clear();
+    const int halfSegments = DEBUG_DRAW_CIRCLE_SEGMENTS / 2;
+    for (int i = 0; i <= halfSegments; ++i) {
+        self->outline_.push_back(b2MulAdd(p2, radius, turn(b2Neg(normal), self->circle_[i % DEBUG_DRAW_CIRCLE_SEGMENTS])));
+    }
+    for (int i = 0; i <= halfSegments; ++i) {
+        self->outline_.push_back(b2MulAdd(p1, radius, turn(normal, self->circle_[i % DEBUG_DRAW_CIRCLE_SEGMENTS])));
+    }
+    self->appendPolygon(self->outline_.data(), static_cast<int>(self->outline_.size()), color, true);
+}
+
+void PhysicsDebugDraw::drawSegment(b2Vec2 p1, b2Vec2 p2, b2HexColor color, void* context) {
+    static_cast<PhysicsDebugDraw*>(context)->appendLine(b2VecToSfVec(p1), b2VecToSfVec(p2), toColor(color));
+}
+
+void PhysicsDebugDraw::drawTransform(b2Transform transform, void* context) {
+    auto* self = static_cast<PhysicsDebugDraw*>(context);
+    sf::Vector2f origin = b2VecToSfVec(transform.p);
+    b2Vec2 xAxis = b2MulAdd(transform.p, TRANSFORM_AXIS_LENGTH, b2Rot_GetXAxis(transform.q));
+    b2Vec2 yAxis = b2MulAdd(transform.p, TRANSFORM_AXIS_LENGTH, b2Rot_GetYAxis(transform.q));
+    self->appendLine(origin, b2VecToSfVec(xAxis), sf::Color::Red);
+    self->appendLine(origin, b2VecToSfVec(yAxis), sf::Color::Green);
+}
+
+void PhysicsDebugDraw::drawPoint(b2Vec2 p, float size, b2HexColor color, void* context) {
+    // Box2D gives the size in screen pixels
+    sf::VertexArray& points = static_cast<PhysicsDebugDraw*>(context)->batch_->points;
+    sf::Vector2f center = b2VecToSfVec(p);
+    float half = size / 2.0f;
+    sf::Color c = toColor(color);
+    sf::Vector2f topLeft(center.x - half, center.y - half);
+    sf::Vector2f topRight(center.x + half, center.y - half);
+    sf::Vector2f bottomRight(center.x + half, center.y + half);
+    sf::Vector2f bottomLeft(center.x - half, center.y + half);
+    points.append({topLeft, c});
+    points.append({topRight, c});
+    points.append({bottomRight, c});
+    points.append({topLeft, c});
+    points.append({bottomRight, c});
+    points.append({bottomLeft, c});
+}
+
+/**
+ * @brief Outline of a convex polygon and, if solid, its interior as a triangle fan.
+ */
+void PhysicsDebugDraw::appendPolygon(const b2Vec2* vertices, int vertexCount, b2HexColor color, bool solid) {
+    if (vertexCount < 2) {
+        return;
+    }
+    sf::Color lineColor = toColor(color);
+    sf::Color fillColor(lineColor.r, lineColor.g, lineColor.b, DEBUG_DRAW_FILL_ALPHA);
+    sf::VertexArray& fills = batch_->fills;
+    sf::Vector2f first = b2VecToSfVec(vertices[0]);
+    sf::Vector2f previous = first;
+    for (int i = 1; i < vertexCount; ++i) {
+        sf::Vector2f current = b2VecToSfVec(vertices[i]);
+        appendLine(previous, current, lineColor);
+        if (solid && i >= 2) {
+            fills.append({first, fillColor});
+            fills.append({previous, fillColor});
+            fills.append({current, fillColor});
+        }
+        previous = current;
+    }
+    appendLine(previous, first, lineColor);
+}
+
+/**
+ * @brief A circle from the direction table, starting at axis. Solid circles also show their rotation.
+ */
+void PhysicsDebugDraw::appendCircle(b2Vec2 center, b2Vec2 axis, float radius, b2HexColor color, bool solid) {
+    outline_.clear();
+    for (const b2Vec2& direction : circle_) {
+        outline_.push_back(b2MulAdd(center, radius, turn(axis, direction)));
+    }
+    appendPolygon(outline_.data(), static_cast<int>(outline_.size()), color, solid);
+    if (solid) {
+        appendLine(b2VecToSfVec(center), b2VecToSfVec(outline_[0]), toColor(color));
+    }
+}
+
+void PhysicsDebugDraw::appendLine(sf::Vector2f a, sf::Vector2f b, sf::Color color) {
+    batch_->lines.append({a, color});
+    batch_->lines.append({b, color});
+}
@@ -0,0 +1,268 @@
+#include "physics_lod.hpp"
+#include <algorithm> // For std::count_if, std::find
+#include <numeric>   // For std::iota
+
+void PhysicsLod::beforeStep(const std::vector<b2BodyId>& bodies, b2Vec2 focus_m) {
+    ++frame_;
+
+    // A managed body that is awake was destroyed or woken by Box2D itself (e.g. hit by an
+    // awake body): it leaves LOD control until the next rebuild.
+    std::vector<uint64_t> released;
+    for (const auto& entry : managed_) {
+        if (!b2Body_IsValid(entry.second.bodyId) || b2Body_IsAwake(entry.second.bodyId)) {
+            released.push_back(entry.first);
+        }
+    }
+    for (uint64_t bodyKey : released) {
+        release(bodyKey);
+    }
+
+    if (--framesUntilRebuild_ <= 0) {
+        rebuildRegions(bodies, focus_m);
+        framesUntilRebuild_ = PHYSICS_LOD_REBUILD_FRAMES;
+    }
+
+    // Wake the reduced-rate regions whose turn it is, with enough velocity to cover the skipped frames
+    int slot = static_cast<int>(frame_ % static_cast<uint64_t>(PHYSICS_LOD_REDUCED_RATE));
+    for (std::size_t i = 0; i < regions_.size(); ++i) {
+        if (regions_[i].tier != Tier::Reduced || regions_[i].phase != slot) continue;
+        for (uint64_t bodyKey : regions_[i].bodies) {
+            if (managed_.count(bodyKey) != 0) {
+                wake(bodyKey, static_cast<float>(PHYSICS_LOD_REDUCED_RATE));
+            }
+        }
+        stepping_.push_back(i);
+    }
+}
+
+void PhysicsLod::afterStep() {
+    const float rate = static_cast<float>(PHYSICS_LOD_REDUCED_RATE);
+    for (std::size_t index : stepping_) {
+        const Region& region = regions_[index];
+        for (uint64_t bodyKey : region.bodies) {
+            auto it = managed_.find(bodyKey);
+            if (it == managed_.end()) continue;
+            ManagedBody& body = it->second;
+            if (!b2Body_IsValid(body.bodyId)) continue;
+
+            // Bring the body back to real-time units and its own parameters
+            b2Vec2 velocity = b2Body_GetLinearVelocity(body.bodyId);
+            body.linearVelocity = {velocity.x / rate, velocity.y / rate};
+            body.angularVelocity = b2Body_GetAngularVelocity(body.bodyId) / rate;
+            b2Body_SetLinearVelocity(body.bodyId, body.linearVelocity);
+            b2Body_SetAngularVelocity(body.bodyId, body.angularVelocity);
+            b2Body_SetGravityScale(body.bodyId, body.gravityScale);
+            b2Body_SetLinearDamping(body.bodyId, body.linearDamping);
+            b2Body_SetAngularDamping(body.bodyId, body.angularDamping);
+        }
+        putToSleep(region); // On failure the region is released at the next beforeStep
+    }
+    stepping_.clear();
+}
+
+void PhysicsLod::wakeAll() {
+    std::vector<uint64_t> keys;
+    keys.reserve(managed_.size());
+    for (const auto& entry : managed_) {
+        keys.push_back(entry.first);
+    }
+    for (uint64_t bodyKey : keys) {
+        release(bodyKey);
+    }
+    // Exclusions outlive the freeze: the zones still hold their bodies
+    regions_.clear();
+    managed_.clear();
+    stepping_.clear();
+    framesUntilRebuild_ = 0;
+}
+
+void PhysicsLod::exclude(b2BodyId bodyId) {
+    uint64_t bodyKey = b2StoreBodyId(bodyId);
+    excluded_.insert(bodyKey);
+    for (Region& region : regions_) {
+        if (std::find(region.bodies.begin(), region.bodies.end(), bodyKey) == region.bodies.end()) continue;
+        // The island is simulated together: all of it runs at full rate until the next rebuild
+        for (uint64_t regionBodyKey : region.bodies) {
+            release(regionBodyKey);
+        }
+        region.tier = Tier::Full;
+    }
+    release(bodyKey);
+}
+
+void PhysicsLod::include(b2BodyId bodyId) {
+    excluded_.erase(b2StoreBodyId(bodyId));
+}
+
+void PhysicsLod::clear() {
+    regions_.clear();
+    managed_.clear();
+    stepping_.clear();
+    excluded_.clear();
+    framesUntilRebuild_ = 0;
+}
+
+std::size_t PhysicsLod::regionCount(Tier tier) const {
+    return static_cast<std::size_t>(std::count_if(regions_.begin(), regions_.end(),
+                                                   [tier](const Region& region) { return region.tier == tier; }));
+}
+
+/**
+ * @brief Groups the bodies into regions and moves each region to the tier matching its distance.
+ * Bodies linked by a joint or a touching contact always share a region, since Box2D
+ * can only put whole islands to sleep.
+ */
+void PhysicsLod::rebuildRegions(const std::vector<b2BodyId>& bodies, b2Vec2 focus_m) {
+    std::unordered_map<uint64_t, int> indexOf;
+    std::vector<b2BodyId> ids;
+    indexOf.reserve(bodies.size());
+    ids.reserve(bodies.size());
+    for (b2BodyId bodyId : bodies) {
+        if (B2_IS_NULL(bodyId) || !b2Body_IsValid(bodyId)) continue;
+        if (b2Body_GetType(bodyId) != b2_dynamicBody || !b2Body_IsEnabled(bodyId)) continue;
+        if (indexOf.emplace(b2StoreBodyId(bodyId), static_cast<int>(ids.size())).second) {
+            ids.push_back(bodyId);
+        }
+    }
+
+    // Union-find over joints and touching contacts
+    std::vector<int> parent(ids.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](int i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+    auto unite = [&](int i, b2BodyId other) {
+        auto it = indexOf.find(b2StoreBodyId(other));
+        if (it != indexOf.end()) {
+            parent[find(i)] = find(it->second);
+        }
+    };
+
+    std::vector<b2JointId> joints;
+    std::vector<b2ContactData> contacts;
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        int index = static_cast<int>(i);
+        joints.resize(static_cast<std::size_t>(b2Body_GetJointCount(ids[i])));
+        int jointCount = b2Body_GetJoints(ids[i], joints.data(), static_cast<int>(joints.size()));
+        for (int j = 0; j < jointCount; ++j) {
+            unite(index, b2Joint_GetBodyA(joints[j]));
+            unite(index, b2Joint_GetBodyB(joints[j]));
+        }
+        contacts.resize(static_cast<std::size_t>(b2Body_GetContactCapacity(ids[i])));
+        int contactCount = b2Body_GetContactData(ids[i], contacts.data(), static_cast<int>(contacts.size()));
+        for (int c = 0; c < contactCount; ++c) {
+            unite(index, b2Shape_GetBody(contacts[c].shapeIdA));
+            unite(index, b2Shape_GetBody(contacts[c].shapeIdB));
+        }
+    }
+
+    // Build the regions and their distance to the focus point
+    regions_.clear();
+    std::vector<float> distances;
+    std::unordered_map<int, std::size_t> regionOfRoot;
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        int root = find(static_cast<int>(i));
+        auto inserted = regionOfRoot.emplace(root, regions_.size());
+        if (inserted.second) {
+            regions_.emplace_back();
+            distances.push_back(b2Distance(b2Body_GetPosition(ids[i]), focus_m));
+        }
+        std::size_t regionIndex = inserted.first->second;
+        regions_[regionIndex].bodies.push_back(b2StoreBodyId(ids[i]));
+        distances[regionIndex] = std::min(distances[regionIndex], b2Distance(b2Body_GetPosition(ids[i]), focus_m));
+    }
+
+    for (std::size_t r = 0; r < regions_.size(); ++r) {
+        Region& region = regions_[r];
+        region.phase = static_cast<int>(r % static_cast<std::size_t>(PHYSICS_LOD_REDUCED_RATE));
+        if (distances[r] <= PHYSICS_LOD_FULL_RADIUS_M || hasExcluded(region)) {
+            region.tier = Tier::Full;
+        } else if (distances[r] <= PHYSICS_LOD_REDUCED_RADIUS_M) {
+            region.tier = Tier::Reduced;
+        } else {
+            region.tier = Tier::Dormant;
+        }
+
+        if (region.tier == Tier::Full) {
+            for (uint64_t bodyKey : region.bodies) {
+                if (managed_.count(bodyKey) != 0) release(bodyKey);
+            }
+            continue;
+        }
+
+        bool allManaged = true;
+        for (uint64_t bodyKey : region.bodies) {
+            if (managed_.count(bodyKey) != 0) continue;
+            allManaged = false;
+            b2BodyId bodyId = b2LoadBodyId(bodyKey);
+            ManagedBody body;
+            body.bodyId = bodyId;
+            body.linearVelocity = b2Body_GetLinearVelocity(bodyId);
+            body.angularVelocity = b2Body_GetAngularVelocity(bodyId);
+            body.gravityScale = b2Body_GetGravityScale(bodyId);
+            body.linearDamping = b2Body_GetLinearDamping(bodyId);
+            body.angularDamping = b2Body_GetAngularDamping(bodyId);
+            managed_.emplace(bodyKey, body);
+        }
+        if (!allManaged && !putToSleep(region)) {
+            // Box2D refused (e.g. pending island split): keep simulating it at full rate for now
+            for (uint64_t bodyKey : region.bodies) {
+                release(bodyKey);
+            }
+            region.tier = Tier::Full;
+        }
+    }
+}
+
+bool PhysicsLod::hasExcluded(const Region& region) const {
+    if (excluded_.empty()) return false;
+    for (uint64_t bodyKey : region.bodies) {
+        if (excluded_.count(bodyKey) != 0) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Puts the island of a region to sleep.
+ * @return True if the region is asleep afterwards.
+ */
+bool PhysicsLod::putToSleep(const Region& region) {
+    for (uint64_t bodyKey : region.bodies) {
+        b2BodyId bodyId = b2LoadBodyId(bodyKey);
+        if (!b2Body_IsValid(bodyId)) continue;
+        b2Body_SetAwake(bodyId, false); // Sleeps the whole island
+        return !b2Body_IsAwake(bodyId);
+    }
+    return false;
+}
+
+/**
+ * @brief Wakes a managed body and restores its saved state, scaled for a catch-up step.
+ * Velocities are multiplied by the scale, gravity by its square (so one step of dt covers
+ * scale * dt of motion) and damping by the scale.
+ */
+void PhysicsLod::wake(uint64_t bodyKey, float velocityScale) {
+    const ManagedBody& body = managed_.at(bodyKey);
+    if (!b2Body_IsValid(body.bodyId)) return;
+
+    b2Body_SetAwake(body.bodyId, true); // Box2D clears the velocities of woken bodies
+    b2Body_SetLinearVelocity(body.bodyId, {body.linearVelocity.x * velocityScale, body.linearVelocity.y * velocityScale});
+    b2Body_SetAngularVelocity(body.bodyId, body.angularVelocity * velocityScale);
+    b2Body_SetGravityScale(body.bodyId, body.gravityScale * velocityScale * velocityScale);
+    b2Body_SetLinearDamping(body.bodyId, body.linearDamping * velocityScale);
+    b2Body_SetAngularDamping(body.bodyId, body.angularDamping * velocityScale);
+}
+
+/**
+ * @brief Wakes a managed body at its normal rate and stops managing it.
+ */
+void PhysicsLod::release(uint64_t bodyKey) {
+    auto it = managed_.find(bodyKey);
+    if (it == managed_.end()) return;
+    wake(bodyKey, 1.0f);
+    managed_.erase(it);
+}
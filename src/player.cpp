@@ -2,9 +2,9 @@
 #include "../include/utils.hpp"
 #include "../include/constants.hpp"
 #include "../include/game_object.hpp" // Required for GameObject class properties
+#include "../include/logger.hpp"
 #include <cmath> // For std::abs, std::max, std::sqrt
 #include <algorithm> // For std::min, std::max
-#include <iostream>
 #include <SFML/Audio.hpp> // For sf::Music
 
 // Sound management
@@ -17,12 +17,12 @@ bool soundsInitialized = false;
 void initializeSounds() {
     if (!soundsInitialized) {
         if (!jumpSoundBuffer.loadFromFile("../assets/audio/jumpsound.wav")) {
-            std::cerr << "Failed to load jump sound!" << std::endl;
+            LOG_ERROR(LogCategory::Assets) << "Failed to load jump sound!";
             return;
         }
         
         if (!runningSoundBuffer.loadFromFile("../assets/audio/runningsound.wav")) {
-            std::cerr << "Failed to load running sound!" << std::endl;
+            LOG_ERROR(LogCategory::Assets) << "Failed to load running sound!";
             return;
         }
         
@@ -39,6 +39,42 @@ void initializeSounds() {
     }
 }
 
+void loadPlayerAnimations(GameObject& playerGameObject) {
+    std::string basePath = "../assets/sprite/character/Poses/";
+
+    playerGameObject.loadPlayerAnimation("idle", {basePath + "female_idle.png"}, 0.1f);
+    playerGameObject.loadPlayerAnimation("walk", {basePath + "female_walk1.png", basePath + "female_walk2.png"}, 0.15f);
+    playerGameObject.loadPlayerAnimation("jump", {basePath + "female_jump.png"}, 0.1f);
+    playerGameObject.loadPlayerAnimation("fall", {basePath + "female_fall.png"}, 0.1f);
+
+    playerGameObject.setPlayerAnimation("idle", false); // Initial state: idle, facing right
+}
+
+// --- Jump & Gravity Parameters ---
+static const float PLAYER_JUMP_HEIGHT = 5.0f;
+static const float PLAYER_TIME_TO_JUMP_APEX = 0.6f;
+
+// Gravity Modification
+static const float PLAYER_FALL_GRAVITY_FACTOR = 5.0f;
+static const float PLAYER_JUMP_CUT_GRAVITY_FACTOR = 2.5f;
+
+// Derived Jump & Gravity Values
+static const float WORLD_GRAVITY_MAGNITUDE = 10.0f;
+static const float PLAYER_EFFECTIVE_GRAVITY_MAGNITUDE = (2.0f * PLAYER_JUMP_HEIGHT) / (PLAYER_TIME_TO_JUMP_APEX * PLAYER_TIME_TO_JUMP_APEX);
+static const float PLAYER_INITIAL_JUMP_VELOCITY = PLAYER_EFFECTIVE_GRAVITY_MAGNITUDE * PLAYER_TIME_TO_JUMP_APEX;
+static const float PLAYER_BASE_GRAVITY_SCALE = PLAYER_EFFECTIVE_GRAVITY_MAGNITUDE / WORLD_GRAVITY_MAGNITUDE;
+
+float playerJumpVelocity() {
+    return PLAYER_INITIAL_JUMP_VELOCITY;
+}
+
+float playerAirGravityScale(float verticalVelocity) {
+    if (verticalVelocity < -0.01f) {
+        return PLAYER_BASE_GRAVITY_SCALE * PLAYER_FALL_GRAVITY_FACTOR;
+    }
+    return PLAYER_BASE_GRAVITY_SCALE;
+}
+
 // Helper function to get the sign of a number
 inline float sign(float val) {
     if (val > 0.0f) return 1.0f;
@@ -46,11 +82,12 @@ inline float sign(float val) {
     return 0.0f;
 }
 
-void movePlayer(b2WorldId worldId, b2BodyId playerBodyId, GameObject& playerGameObject,
-                const std::vector<GameObject>& allGameObjects,
-                bool jumpKeyHeld, bool leftKeyHeld, bool rightKeyHeld, float dt) {
+bool movePlayer(b2WorldId worldId, b2BodyId playerBodyId, GameObject& playerGameObject,
+                const GameObjectList& allGameObjects,
+                bool jumpKeyHeld, bool jumpKeyPressed, float jumpPressAge,
+                bool leftKeyHeld, bool rightKeyHeld, float dt) {
 
-    if (B2_IS_NULL(playerBodyId)) return;
+    if (B2_IS_NULL(playerBodyId)) return false;
     // --- Player Physics Parameters ---
     // Horizontal Movement
     static const float PLAYER_MAX_SPEED = 20.0f;
@@ -59,20 +96,7 @@ void movePlayer(b2WorldId worldId, b2BodyId playerBodyId, GameObject& playerGame
     static const float PLAYER_GROUND_DECELERATION = 100.0f;
     static const float PLAYER_TURN_SPEED_FACTOR = 1.5f;
 
-    // Jump
-    static const float PLAYER_JUMP_HEIGHT = 5.0f;
-    static const float PLAYER_TIME_TO_JUMP_APEX = 0.6f;
-
-
-    // Gravity Modification
-    static const float PLAYER_FALL_GRAVITY_FACTOR = 5.0f;
-    static const float PLAYER_JUMP_CUT_GRAVITY_FACTOR = 2.5f;
-
-    // Derived Jump & Gravity Values
-    static const float WORLD_GRAVITY_MAGNITUDE = 10.0f;
-    static const float PLAYER_EFFECTIVE_GRAVITY_MAGNITUDE = (2.0f * PLAYER_JUMP_HEIGHT) / (PLAYER_TIME_TO_JUMP_APEX * PLAYER_TIME_TO_JUMP_APEX);
-    static const float PLAYER_INITIAL_JUMP_VELOCITY = PLAYER_EFFECTIVE_GRAVITY_MAGNITUDE * PLAYER_TIME_TO_JUMP_APEX;
-    static const float PLAYER_BASE_GRAVITY_SCALE = PLAYER_EFFECTIVE_GRAVITY_MAGNITUDE / WORLD_GRAVITY_MAGNITUDE;
+    // Jump and gravity parameters are at file scope (shared with the jump arc prediction)
     static const float PLAYER_COYOTE_TIME = 0.0f;
     static const float PLAYER_JUMP_BUFFER_TIME = 0.1f;
 
@@ -83,12 +107,11 @@ void movePlayer(b2WorldId worldId, b2BodyId playerBodyId, GameObject& playerGame
     static bool isJumping = false;
     static float coyoteTimer = PLAYER_COYOTE_TIME;
     static float jumpBufferTimer = PLAYER_JUMP_BUFFER_TIME;
-    static bool previousJumpKeyHeld = false;
     b2Vec2 playerVel=b2Body_GetLinearVelocity(playerBodyId);
 
     // --- Input Processing ---
-    bool jumpKeyJustPressed = jumpKeyHeld && !previousJumpKeyHeld;
-    previousJumpKeyHeld = jumpKeyHeld;
+    // The press edge comes from the input queue, so taps shorter than a step are not lost
+    bool jumpKeyJustPressed = jumpKeyPressed;
 
     // --- Facing Direction ---
     // Read current flip state from GameObject, if it's already flipped, it means it's facing left.
@@ -112,13 +135,16 @@ void movePlayer(b2WorldId worldId, b2BodyId playerBodyId, GameObject& playerGame
                 b2BodyId bodyA = b2Shape_GetBody(contactData[i].shapeIdA);
                 b2BodyId bodyB = b2Shape_GetBody(contactData[i].shapeIdB);
                 b2BodyId otherBodyId = b2_nullBodyId;
+                b2ShapeId otherShapeId = b2_nullShapeId;
                 float supportingNormalY = 0.0f;
 
                 if (B2_ID_EQUALS(bodyA, playerBodyId)) {
                     otherBodyId = bodyB;
+                    otherShapeId = contactData[i].shapeIdB;
                     supportingNormalY = -contactData[i].manifold.normal.y;
                 } else if (B2_ID_EQUALS(bodyB, playerBodyId)) {
                     otherBodyId = bodyA;
+                    otherShapeId = contactData[i].shapeIdA;
                     supportingNormalY = contactData[i].manifold.normal.y;
                 } else {
                     continue;
@@ -127,7 +153,8 @@ void movePlayer(b2WorldId worldId, b2BodyId playerBodyId, GameObject& playerGame
                 // Check if the other body is a GameObject that can be jumped on
                 for(const auto& gameObject : allGameObjects) { // Use allGameObjects for ground check
                     if (B2_ID_EQUALS(otherBodyId, gameObject.bodyId)) {
-                        if (gameObject.canJumpOn && supportingNormalY > 0.7f) { // Check if contact normal is mostly upward
+                        // Composite objects may only be jumped on from some of their shapes
+                        if (gameObject.canJumpOnShape(otherShapeId) && supportingNormalY > 0.7f) { // Check if contact normal is mostly upward
                             isGrounded = true;
                         }
                         break;
@@ -147,7 +174,8 @@ void movePlayer(b2WorldId worldId, b2BodyId playerBodyId, GameObject& playerGame
 
     // Update Jump Buffer
     if (jumpKeyJustPressed) {
-        jumpBufferTimer = PLAYER_JUMP_BUFFER_TIME;
+        // The press is already jumpPressAge old when the step runs
+        jumpBufferTimer = std::max(0.0f, PLAYER_JUMP_BUFFER_TIME - jumpPressAge);
     } else {
         jumpBufferTimer = std::max(0.0f, jumpBufferTimer - dt);
     }
@@ -264,4 +292,5 @@ void movePlayer(b2WorldId worldId, b2BodyId playerBodyId, GameObject& playerGame
         }
     }
 
+    return justLanded;
 }
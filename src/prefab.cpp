@@ -0,0 +1,52 @@
+#include "prefab.hpp"
+#include "logger.hpp"
+
+Prefab::Prefab(const GameObject& archetype) : archetype_(archetype) {
+    archetype_.bodyId = b2_nullBodyId;
+    archetype_.shapeId = b2_nullShapeId;
+    archetype_.prepareVisual();
+
+    bodyDef_ = archetype_.makeBodyDef();
+    shapeDef_ = archetype_.makeShapeDef();
+    box_ = b2MakeBox(archetype_.width_m_ / 2.0f, archetype_.height_m_ / 2.0f);
+
+    partDefs_.reserve(archetype_.shapeParts.size());
+    partBoxes_.reserve(archetype_.shapeParts.size());
+    for (GameObject::ShapePart& part : archetype_.shapeParts) {
+        part.shapeId = b2_nullShapeId;
+        partDefs_.push_back(archetype_.makeShapeDef(part));
+        partBoxes_.push_back(GameObject::makePartBox(part));
+    }
+}
+
+b2BodyId Prefab::spawn(b2WorldId worldId, GameObjectList& gameObjects, float x_m, float y_m) const {
+    b2BodyDef bodyDef = bodyDef_;
+    bodyDef.position = {x_m, y_m};
+    b2BodyId bodyId = b2CreateBody(worldId, &bodyDef);
+    if (B2_IS_NULL(bodyId)) {
+        LOG_ERROR(LogCategory::Loading) << "Error creating Box2D body for prefab instance!";
+        return b2_nullBodyId;
+    }
+
+    // Copy straight into the vector: the instance is never copied a second time
+    gameObjects.push_back(archetype_);
+    GameObject& instance = gameObjects.back();
+    instance.bodyId = bodyId;
+    instance.x_m_ = x_m;
+    instance.y_m_ = y_m;
+    instance.sfShape.setPosition(b2VecToSfVec({x_m, y_m}));
+
+    instance.shapeId = b2CreatePolygonShape(bodyId, &shapeDef_, &box_);
+    bool created = !B2_IS_NULL(instance.shapeId);
+    for (std::size_t i = 0; created && i < partDefs_.size(); ++i) {
+        instance.shapeParts[i].shapeId = b2CreatePolygonShape(bodyId, &partDefs_[i], &partBoxes_[i]);
+        created = !B2_IS_NULL(instance.shapeParts[i].shapeId);
+    }
+    if (!created) {
+        LOG_ERROR(LogCategory::Loading) << "Error creating Box2D shape for prefab instance!";
+        b2DestroyBody(bodyId);
+        gameObjects.pop_back();
+        return b2_nullBodyId;
+    }
+    return bodyId;
+}
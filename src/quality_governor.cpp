@@ -0,0 +1,112 @@
+#include "quality_governor.hpp"
+#include "logger.hpp"
+#include <algorithm>
+
+namespace {
+
+template <typename T>
+void logDecision(bool lowered, const char* knob, T from, T to, float p90Ms) {
+    LOG_INFO(LogCategory::Render) << (lowered ? "Quality lowered: " : "Quality raised: ") << knob << ' ' << from
+                                  << " -> " << to << " (frame p90 " << p90Ms << " ms, budget "
+                                  << QUALITY_FRAME_BUDGET_MS << " ms)";
+}
+
+const char* onOff(bool value) {
+    return value ? "on" : "off";
+}
+
+} // namespace
+
+bool QualityGovernor::addFrame(float simulationMs, float drawMs, bool debugOverlaysShown) {
+    window_.add(std::max(simulationMs, drawMs));
+    debugOverlaysShown_ = debugOverlaysShown;
+    if (++framesInWindow_ < QUALITY_WINDOW_FRAMES) {
+        return false;
+    }
+    float p90Ms = window_.percentile(0.9f);
+    window_.clear();
+    framesInWindow_ = 0;
+    if (settling_) {
+        settling_ = false;
+        return false;
+    }
+
+    bool changed = false;
+    cheapWindows_ = p90Ms < QUALITY_FRAME_BUDGET_MS * QUALITY_UPGRADE_RATIO ? cheapWindows_ + 1 : 0;
+    if (p90Ms > QUALITY_FRAME_BUDGET_MS) {
+        changed = lower(p90Ms);
+    } else if (cheapWindows_ >= QUALITY_UPGRADE_WINDOWS) {
+        changed = raise(p90Ms);
+    }
+    if (changed) {
+        cheapWindows_ = 0;
+        settling_ = true;
+        ++changes_;
+    }
+    return changed;
+}
+
+void QualityGovernor::restoreDebugOverlays() {
+    if (!settings_.debugOverlays) {
+        settings_.debugOverlays = true;
+        LOG_INFO(LogCategory::Render) << "Quality: debug overlays back on (switched on by the user)";
+    }
+}
+
+/**
+ * @brief Lowers the first knob that is not at its floor by one notch.
+ */
+bool QualityGovernor::lower(float p90Ms) {
+    QualitySettings& s = settings_;
+    if (s.debugOverlays && debugOverlaysShown_) {
+        s.debugOverlays = false;
+        logDecision(true, "debug overlays", onOff(true), onOff(false), p90Ms);
+    } else if (s.particleCap > QUALITY_MIN_PARTICLES) {
+        int cap = std::max(QUALITY_MIN_PARTICLES, s.particleCap / 2);
+        logDecision(true, "particle cap", s.particleCap, cap, p90Ms);
+        s.particleCap = cap;
+    } else if (s.parallaxLayers > 0) {
+        logDecision(true, "parallax layers", s.parallaxLayers, s.parallaxLayers - 1, p90Ms);
+        --s.parallaxLayers;
+    } else if (s.offscreenScale > QUALITY_MIN_OFFSCREEN_SCALE) {
+        float scale = std::max(QUALITY_MIN_OFFSCREEN_SCALE, s.offscreenScale - 0.25f);
+        logDecision(true, "offscreen resolution", s.offscreenScale, scale, p90Ms);
+        s.offscreenScale = scale;
+    } else if (s.physicsSubSteps > QUALITY_MIN_SUBSTEPS) {
+        int subSteps = std::max(QUALITY_MIN_SUBSTEPS, s.physicsSubSteps - 2);
+        logDecision(true, "physics sub-steps", s.physicsSubSteps, subSteps, p90Ms);
+        s.physicsSubSteps = subSteps;
+    } else {
+        return false; // Everything is at its floor
+    }
+    return true;
+}
+
+/**
+ * @brief Raises the last knob lowered by one notch (reverse order of lower()).
+ */
+bool QualityGovernor::raise(float p90Ms) {
+    QualitySettings& s = settings_;
+    if (s.physicsSubSteps < QUALITY_MAX_SUBSTEPS) {
+        int subSteps = std::min(QUALITY_MAX_SUBSTEPS, s.physicsSubSteps + 2);
+        logDecision(false, "physics sub-steps", s.physicsSubSteps, subSteps, p90Ms);
+        s.physicsSubSteps = subSteps;
+    } else if (s.offscreenScale < 1.0f) {
+        float scale = std::min(1.0f, s.offscreenScale + 0.25f);
+        logDecision(false, "offscreen resolution", s.offscreenScale, scale, p90Ms);
+        s.offscreenScale = scale;
+    } else if (s.parallaxLayers < 2) {
+        logDecision(false, "parallax layers", s.parallaxLayers, s.parallaxLayers + 1, p90Ms);
+        ++s.parallaxLayers;
+    } else if (s.particleCap < QUALITY_MAX_PARTICLES) {
+        int cap = std::min(QUALITY_MAX_PARTICLES, s.particleCap * 2);
+        logDecision(false, "particle cap", s.particleCap, cap, p90Ms);
+        s.particleCap = cap;
+    } else if (!s.debugOverlays) {
+        s.debugOverlays = true;
+        logDecision(false, "debug overlays", onOff(false), onOff(true), p90Ms);
+    } else {
+        return false; // Already at the best quality
+    }
+    return true;
+}
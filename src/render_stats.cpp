@@ -0,0 +1,40 @@
+#include "render_stats.hpp"
+
+RenderStats& RenderStats::instance() {
+    static RenderStats stats;
+    return stats;
+}
+
+void countedDraw(sf::RenderTarget& target, const sf::Shape& shape, const sf::RenderStates& states) {
+    std::size_t points = shape.getPointCount();
+    std::size_t vertexCount = points + 2; // Fan: center, every point, first point again
+    if (shape.getOutlineThickness() != 0.0f) {
+        RenderStats::instance().recordDraw(vertexCount);
+        vertexCount = (points + 1) * 2; // The outline is a second draw call
+    }
+    RenderStats::instance().recordDraw(vertexCount);
+    target.draw(shape, states);
+}
+
+void countedDraw(sf::RenderTarget& target, const sf::Sprite& sprite, const sf::RenderStates& states) {
+    RenderStats::instance().recordDraw(4);
+    target.draw(sprite, states);
+}
+
+void countedDraw(sf::RenderTarget& target, const sf::Text& text, const sf::RenderStates& states) {
+    RenderStats::instance().recordDraw(text.getString().getSize() * 6); // Two triangles per glyph
+    target.draw(text, states);
+}
+
+void countedDraw(sf::RenderTarget& target, const sf::Vertex* vertices, std::size_t vertexCount, sf::PrimitiveType type,
+                 const sf::RenderStates& states) {
+    if (vertexCount == 0) return;
+    RenderStats::instance().recordDraw(vertexCount);
+    target.draw(vertices, vertexCount, type, states);
+}
+
+void countedDraw(sf::RenderTarget& target, const sf::VertexArray& vertices, const sf::RenderStates& states) {
+    if (vertices.getVertexCount() == 0) return;
+    RenderStats::instance().recordDraw(vertices.getVertexCount());
+    target.draw(vertices, states);
+}
@@ -0,0 +1,101 @@
+#include "render_thread.hpp"
+#include "trace.hpp"
+#include "logger.hpp"
+#include "input_queue.hpp" // For the input clock
+
+RenderThread::RenderThread(sf::RenderWindow& window, SceneRenderer& renderer, FramePacer* pacer)
+    : window_(window), renderer_(renderer), pacer_(pacer) {
+    // A context can only be active on one thread: release it before the render thread takes it
+    if (!window_.setActive(false)) {
+        LOG_ERROR(LogCategory::Render) << "Failed to release the window context for the render thread.";
+    }
+    thread_ = std::thread(&RenderThread::run, this);
+}
+
+RenderThread::~RenderThread() {
+    stop();
+}
+
+void RenderThread::waitUntilDrawn() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    drawn_.wait(lock, [this] { return pendingFront_ == -1 || stopping_; });
+}
+
+void RenderThread::submit() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) return;
+        pendingFront_ = back_;
+        back_ = 1 - back_;
+    }
+    wake_.notify_one();
+}
+
+void RenderThread::stop() {
+    if (!thread_.joinable()) return;
+    waitUntilDrawn();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+    if (!window_.setActive(true)) {
+        LOG_ERROR(LogCategory::Render) << "Failed to reactivate the window context.";
+    }
+}
+
+LatencySamples RenderThread::takeInputToPhoton() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    LatencySamples samples;
+    std::swap(samples, inputToPhoton_);
+    return samples;
+}
+
+void RenderThread::run() {
+    TRACE_THREAD_NAME("Render");
+    if (!window_.setActive(true)) {
+        LOG_ERROR(LogCategory::Render) << "Failed to activate the window context on the render thread.";
+    }
+
+    while (true) {
+        int front;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stopping_ || pendingFront_ != -1; });
+            if (stopping_) break;
+            front = pendingFront_;
+        }
+
+        // Read before the snapshot is handed back to the simulation thread
+        FrameTiming timing = snapshots_[front].timing;
+        int64_t drawStartNs = InputQueue::nowNs();
+        {
+            TRACE_ZONE("Draw");
+            renderer_.draw(window_, snapshots_[front]);
+        }
+        lastDrawNs_.store(InputQueue::nowNs() - drawStartNs, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pendingFront_ = -1;
+        }
+        drawn_.notify_all();
+
+        {
+            TRACE_ZONE("window.display");
+            window_.display();
+        }
+        int64_t presentNs = InputQueue::nowNs();
+        if (pacer_ != nullptr) {
+            pacer_->presented(timing, presentNs);
+        }
+        if (timing.inputNs >= 0) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            inputToPhoton_.add(static_cast<float>(presentNs - timing.inputNs) * 1e-6f);
+        }
+    }
+
+    if (!window_.setActive(false)) {
+        LOG_ERROR(LogCategory::Render) << "Failed to release the window context on the render thread.";
+    }
+}
@@ -0,0 +1,133 @@
+#include "scene_compositor.hpp"
+#include "render_stats.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <string>
+
+namespace {
+
+// The layers used to be view-sized texture rects stretched over shapes five views wide
+const float LAYER_MAGNIFICATION = 5.0f;
+
+const sf::Color SKY_COLOR(135, 206, 235);
+
+/**
+ * @brief Fragment shader of the background pass, with one block per layer.
+ * gl_TexCoord[0] is the fragment's position in view pixels.
+ */
+std::string backgroundShaderSource() {
+    std::string source =
+        "uniform vec4 sky;\n"
+        "uniform vec4 tint;\n"
+        "uniform float fade;\n"
+        "uniform int layerCount;\n"
+        "uniform float magnification;\n";
+    for (int i = 0; i < PARALLAX_MAX_LAYERS; ++i) {
+        std::string n = std::to_string(i);
+        source += "uniform sampler2D layer" + n + ";\nuniform vec2 offset" + n + ";\nuniform vec2 size" + n + ";\n";
+    }
+    source +=
+        "void main() {\n"
+        "    vec2 p = gl_TexCoord[0].xy / magnification;\n"
+        "    vec3 color = sky.rgb;\n";
+    for (int i = 0; i < PARALLAX_MAX_LAYERS; ++i) {
+        std::string n = std::to_string(i);
+        source += "    if (layerCount > " + n + ") {\n"
+                  "        vec4 c = texture2D(layer" + n + ", (offset" + n + " + p) / size" + n + ");\n"
+                  "        color = mix(color, c.rgb, c.a);\n"
+                  "    }\n";
+    }
+    source +=
+        "    color = mix(color, tint.rgb, tint.a);\n"
+        "    gl_FragColor = vec4(color * (1.0 - fade), 1.0);\n"
+        "}\n";
+    return source;
+}
+
+const char* TEXTURED_GRADE_SOURCE =
+    "uniform sampler2D texture;\n"
+    "uniform vec4 tint;\n"
+    "uniform float fade;\n"
+    "void main() {\n"
+    "    vec4 c = gl_Color * texture2D(texture, gl_TexCoord[0].xy);\n"
+    "    gl_FragColor = vec4(mix(c.rgb, tint.rgb, tint.a) * (1.0 - fade), c.a);\n"
+    "}\n";
+
+const char* COLOR_GRADE_SOURCE =
+    "uniform vec4 tint;\n"
+    "uniform float fade;\n"
+    "void main() {\n"
+    "    vec4 c = gl_Color;\n"
+    "    gl_FragColor = vec4(mix(c.rgb, tint.rgb, tint.a) * (1.0 - fade), c.a);\n"
+    "}\n";
+
+} // namespace
+
+bool SceneCompositor::load() {
+    available_ = false;
+    if (!sf::Shader::isAvailable()) {
+        LOG_WARNING(LogCategory::Render) << "Shaders are not available: drawing the background and overlays without the compositor.";
+        return false;
+    }
+    if (!backgroundShader_.loadFromMemory(backgroundShaderSource(), sf::Shader::Type::Fragment) ||
+        !texturedShader_.loadFromMemory(TEXTURED_GRADE_SOURCE, sf::Shader::Type::Fragment) ||
+        !colorShader_.loadFromMemory(COLOR_GRADE_SOURCE, sf::Shader::Type::Fragment)) {
+        LOG_ERROR(LogCategory::Render) << "Failed to compile the compositor shaders.";
+        return false;
+    }
+    backgroundShader_.setUniform("sky", sf::Glsl::Vec4(SKY_COLOR));
+    backgroundShader_.setUniform("magnification", LAYER_MAGNIFICATION);
+    texturedShader_.setUniform("texture", sf::Shader::CurrentTexture);
+    texturedStates_.shader = &texturedShader_;
+    colorStates_.shader = &colorShader_;
+    setGrade(sf::Color::Transparent, 0.0f);
+    available_ = true;
+    return true;
+}
+
+void SceneCompositor::setLayers(const std::array<Layer, PARALLAX_MAX_LAYERS>& layers, int layerCount) {
+    layers_ = layers;
+    layerCount_ = std::clamp(layerCount, 0, PARALLAX_MAX_LAYERS);
+    for (int i = 0; i < layerCount_; ++i) {
+        std::string n = std::to_string(i);
+        backgroundShader_.setUniform("layer" + n, *layers_[i].texture);
+        backgroundShader_.setUniform("size" + n, sf::Glsl::Vec2(layers_[i].texture->getSize()));
+    }
+}
+
+void SceneCompositor::drawBackground(sf::RenderTarget& target, const sf::View& view, float cloudDriftOffset, int layerCount) {
+    // Texture pixel under the view's top-left corner, minus what the shader adds per view pixel
+    for (int i = 0; i < layerCount_; ++i) {
+        const Layer& layer = layers_[i];
+        sf::Vector2f offset = view.getCenter() * layer.parallaxFactor + view.getSize() / (2.0f * LAYER_MAGNIFICATION);
+        offset.x += cloudDriftOffset * layer.driftFactor;
+        backgroundShader_.setUniform("offset" + std::to_string(i), sf::Glsl::Vec2(offset));
+    }
+    backgroundShader_.setUniform("layerCount", std::min(layerCount, layerCount_));
+    backgroundShader_.setUniform("tint", tint_);
+    backgroundShader_.setUniform("fade", fade_);
+
+    // One quad over the whole target; its texture coordinates are view pixels
+    target.setView(target.getDefaultView());
+    sf::Vector2f targetSize(target.getSize());
+    sf::Vector2f viewSize = view.getSize();
+    const sf::Vertex quad[4] = {
+        {{0.0f, 0.0f}, sf::Color::White, {0.0f, 0.0f}},
+        {{targetSize.x, 0.0f}, sf::Color::White, {viewSize.x, 0.0f}},
+        {{0.0f, targetSize.y}, sf::Color::White, {0.0f, viewSize.y}},
+        {{targetSize.x, targetSize.y}, sf::Color::White, {viewSize.x, viewSize.y}},
+    };
+    sf::RenderStates states;
+    states.shader = &backgroundShader_;
+    states.blendMode = sf::BlendNone; // Covers the whole target: no clear needed
+    countedDraw(target, quad, 4, sf::PrimitiveType::TriangleStrip, states);
+}
+
+void SceneCompositor::setGrade(sf::Color tint, float fade) {
+    tint_ = sf::Glsl::Vec4(tint);
+    fade_ = fade;
+    texturedShader_.setUniform("tint", tint_);
+    texturedShader_.setUniform("fade", fade_);
+    colorShader_.setUniform("tint", tint_);
+    colorShader_.setUniform("fade", fade_);
+}
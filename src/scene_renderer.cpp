@@ -0,0 +1,278 @@
+#include "scene_renderer.hpp"
+#include "render_stats.hpp"
+#include "logger.hpp"
+#include <cstdint>
+#include <type_traits>
+
+namespace {
+
+const float BACKGROUND_PARALLAX_FACTOR = 0.1f;
+const float CLOUD_PARALLAX_FACTOR = 0.2f;
+const sf::Color FREEZE_TINT(100, 150, 255); // Light blue
+
+} // namespace
+
+SceneRenderer::SceneRenderer(StaticLayerCache& staticLayer, FrozenSceneCache& frozenScene)
+    : staticLayer_(staticLayer),
+      frozenScene_(frozenScene),
+      timeFreezeOverlay_(sf::Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT)),
+      transitionOverlay_(sf::Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT)),
+      instructionText_(font_, "Press F to freeze time, hold Backspace to rewind, R to restart", 24) {
+}
+
+bool SceneRenderer::loadAssets() {
+    // --- Load Font for UI Text ---
+    if (!font_.openFromFile("../assets/fonts/ARIAL.TTF")) {
+        // Try alternative font paths if the first fails
+        if (!font_.openFromFile("/System/Library/Fonts/Arial.ttf") &&
+            !font_.openFromFile("/usr/share/fonts/truetype/liberation/LiberationSans-Regular.ttf") &&
+            !font_.openFromFile("C:/Windows/Fonts/arial.ttf")) {
+            LOG_WARNING(LogCategory::Assets) << "Could not load font. Text will not display properly.";
+        }
+    }
+    instructionText_.setFont(font_);
+    instructionText_.setFillColor(sf::Color::White);
+    instructionText_.setStyle(sf::Text::Bold);
+    // Position at bottom center of screen
+    sf::FloatRect textBounds = instructionText_.getLocalBounds();
+    instructionText_.setPosition(sf::Vector2f(WINDOW_WIDTH / 2.0f - textBounds.size.x / 2.0f, WINDOW_HEIGHT - 100.0f));
+
+    // --- Load Background Map ---
+    if (!backgroundTexture_.loadFromFile("../assets/objects/background.png")) {
+        LOG_ERROR(LogCategory::Assets) << "Failed to load background texture!";
+        return false;
+    }
+    backgroundTexture_.setRepeated(true);
+    backgroundShape_.setTexture(&backgroundTexture_);
+
+    if (!cloudTexture_.loadFromFile("../assets/objects/cloud.png")) {
+        LOG_ERROR(LogCategory::Assets) << "Failed to load cloud texture!";
+        return false;
+    }
+    cloudTexture_.setRepeated(true);
+    cloudShape_.setTexture(&cloudTexture_);
+
+    // Without shaders the textured rectangles and overlays above are used instead
+    if (compositor_.load()) {
+        compositor_.setLayers({{{&backgroundTexture_, BACKGROUND_PARALLAX_FACTOR, 0.0f},
+                                {&cloudTexture_, CLOUD_PARALLAX_FACTOR, 1.0f}}}, 2);
+    }
+    return true;
+}
+
+void SceneRenderer::capture(SceneSnapshot& snapshot, const SceneFrame& frame, const GameObjectList& gameObjects, int playerIndex) {
+    snapshot.clear();
+    snapshot.frame = frame;
+
+    std::optional<sf::Sprite> frozenWorld;
+    if (frame.worldFrozen) {
+        frozenWorld = frozenScene_.snapshot(frame.view, [&](sf::RenderTarget& snapshotTarget, const sf::View& snapshotView) {
+            drawWorld(snapshotTarget, snapshotView, gameObjects, playerIndex);
+        });
+    }
+    if (frozenWorld) {
+        snapshot.layer.push_back(*frozenWorld);
+    } else {
+        // Static scenery from the tile cache, then every other object except the player
+        staticLayer_.collectVisibleTiles(frame.view, gameObjects, snapshot.layer);
+        batchQuads(gameObjects, snapshot.quads);
+        for (size_t i = 0; i < gameObjects.size(); ++i) {
+            if (static_cast<int>(i) == playerIndex || staticLayer_.isCached(gameObjects[i])) continue;
+            if (gameObjects[i].drawnAsQuad()) continue;
+            if (const sf::Sprite* sprite = gameObjects[i].visibleSprite()) {
+                snapshot.addWorld(*sprite);
+            } else if (const sf::RectangleShape* shape = gameObjects[i].visibleShape()) {
+                snapshot.addWorld(*shape);
+            }
+        }
+    }
+
+    if (playerIndex != -1) {
+        if (const sf::Sprite* sprite = gameObjects[playerIndex].visibleSprite()) {
+            snapshot.player = *sprite;
+        } else if (const sf::RectangleShape* shape = gameObjects[playerIndex].visibleShape()) {
+            snapshot.player = *shape;
+        }
+    }
+}
+
+void SceneRenderer::draw(sf::RenderTarget& target, const SceneSnapshot& snapshot) {
+    if (compositor_.available()) {
+        drawComposited(target, snapshot);
+        return;
+    }
+    const SceneFrame& frame = snapshot.frame;
+    auto drawItem = [&target](const SceneDrawable& item) {
+        std::visit([&target](const auto& drawable) { countedDraw(target, drawable); }, item);
+    };
+
+    drawParallax(target, frame);
+
+    target.setView(frame.view);
+    // Draw all game objects except the player (drawn last, above the overlay)
+    for (const sf::Sprite& layerSprite : snapshot.layer) {
+        countedDraw(target, layerSprite);
+    }
+    countedDraw(target, snapshot.quads.data(), snapshot.quads.size(), sf::PrimitiveType::Triangles);
+    for (size_t i = 0; i < snapshot.worldCount; ++i) {
+        drawItem(snapshot.world[i]);
+    }
+    for (const ParticleBatch& batch : snapshot.particles) {
+        sf::RenderStates states;
+        states.texture = batch.texture;
+        countedDraw(target, batch.vertices.data(), batch.vertices.size(), sf::PrimitiveType::Triangles, states);
+    }
+    target.setView(target.getDefaultView());
+
+    if (frame.timeFreezeOverlayAlpha > 0.0f) {
+        timeFreezeOverlay_.setFillColor(sf::Color(FREEZE_TINT.r, FREEZE_TINT.g, FREEZE_TINT.b, static_cast<std::uint8_t>(frame.timeFreezeOverlayAlpha)));
+        countedDraw(target, timeFreezeOverlay_);
+    }
+
+    if (frame.showInstructions) {
+        countedDraw(target, instructionText_);
+    }
+
+    target.setView(frame.view);
+    countedDraw(target, snapshot.trajectories.data(), snapshot.trajectories.size(), sf::PrimitiveType::Lines);
+    if (snapshot.player) {
+        drawItem(*snapshot.player);
+    }
+    countedDraw(target, snapshot.physicsDebug.fills);
+    countedDraw(target, snapshot.physicsDebug.lines);
+    countedDraw(target, snapshot.physicsDebug.points);
+    target.setView(target.getDefaultView());
+
+    if (frame.transitionAlpha > 0.0f) {
+        transitionOverlay_.setFillColor(sf::Color(0, 0, 0, static_cast<std::uint8_t>(frame.transitionAlpha)));
+        countedDraw(target, transitionOverlay_);
+    }
+}
+
+/**
+ * @brief Same frame as the overlay path of draw(), with the background in one pass and the
+ * tint and fade applied by the compositor's shaders.
+ */
+void SceneRenderer::drawComposited(sf::RenderTarget& target, const SceneSnapshot& snapshot) {
+    const SceneFrame& frame = snapshot.frame;
+    auto drawItem = [this, &target](const SceneDrawable& item) {
+        std::visit([this, &target](const auto& drawable) {
+            constexpr bool textured = std::is_same_v<std::decay_t<decltype(drawable)>, sf::Sprite>;
+            countedDraw(target, drawable, compositor_.states(textured));
+        }, item);
+    };
+    float fade = frame.transitionAlpha / 255.0f;
+
+    // The world is under the freeze tint
+    compositor_.setGrade(sf::Color(FREEZE_TINT.r, FREEZE_TINT.g, FREEZE_TINT.b, static_cast<std::uint8_t>(frame.timeFreezeOverlayAlpha)), fade);
+    compositor_.drawBackground(target, frame.view, frame.cloudDriftOffset, frame.parallaxLayers);
+    target.setView(frame.view);
+    for (const sf::Sprite& layerSprite : snapshot.layer) {
+        countedDraw(target, layerSprite, compositor_.states(true));
+    }
+    countedDraw(target, snapshot.quads.data(), snapshot.quads.size(), sf::PrimitiveType::Triangles, compositor_.states(false));
+    for (size_t i = 0; i < snapshot.worldCount; ++i) {
+        drawItem(snapshot.world[i]);
+    }
+    for (const ParticleBatch& batch : snapshot.particles) {
+        sf::RenderStates states = compositor_.states(batch.texture != nullptr);
+        states.texture = batch.texture;
+        countedDraw(target, batch.vertices.data(), batch.vertices.size(), sf::PrimitiveType::Triangles, states);
+    }
+
+    // The HUD, trajectories, player and physics debug view are above it, everything is under the fade
+    compositor_.setGrade(sf::Color::Transparent, fade);
+    if (frame.showInstructions) {
+        target.setView(target.getDefaultView());
+        countedDraw(target, instructionText_, compositor_.states(true));
+    }
+    target.setView(frame.view);
+    countedDraw(target, snapshot.trajectories.data(), snapshot.trajectories.size(), sf::PrimitiveType::Lines, compositor_.states(false));
+    if (snapshot.player) {
+        drawItem(*snapshot.player);
+    }
+    countedDraw(target, snapshot.physicsDebug.fills, compositor_.states(false));
+    countedDraw(target, snapshot.physicsDebug.lines, compositor_.states(false));
+    countedDraw(target, snapshot.physicsDebug.points, compositor_.states(false));
+    target.setView(target.getDefaultView());
+}
+
+void SceneRenderer::render(sf::RenderTarget& target, const SceneFrame& frame, const GameObjectList& gameObjects, int playerIndex) {
+    capture(scratch_, frame, gameObjects, playerIndex);
+    draw(target, scratch_);
+}
+
+/**
+ * @brief Scrolls the background and cloud layers slower than the camera.
+ */
+void SceneRenderer::drawParallax(sf::RenderTarget& target, const SceneFrame& frame) {
+    const float backgroundParallaxFactor = BACKGROUND_PARALLAX_FACTOR;
+    const float cloudParallaxFactor = CLOUD_PARALLAX_FACTOR;
+    const sf::View& view = frame.view;
+    sf::Vector2f viewTopLeft = view.getCenter() - view.getSize();
+
+    backgroundShape_.setPosition(viewTopLeft);
+    backgroundShape_.setSize(view.getSize() * 5.0f);
+    sf::Rect<int> bgTextureRect(
+        sf::Vector2i(
+            static_cast<int>(view.getCenter().x * backgroundParallaxFactor),
+            static_cast<int>(view.getCenter().y * backgroundParallaxFactor)
+        ),
+        sf::Vector2i(
+            static_cast<int>(view.getSize().x),
+            static_cast<int>(view.getSize().y)
+        )
+    );
+    backgroundShape_.setTextureRect(bgTextureRect);
+
+    cloudShape_.setPosition(viewTopLeft);
+    cloudShape_.setSize(view.getSize() * 5.0f);
+    sf::Rect<int> cloudTextureRect(
+        sf::Vector2i(
+            static_cast<int>(view.getCenter().x * cloudParallaxFactor + frame.cloudDriftOffset),
+            static_cast<int>(view.getCenter().y * cloudParallaxFactor)
+        ),
+        sf::Vector2i(
+            static_cast<int>(view.getSize().x),
+            static_cast<int>(view.getSize().y)
+        )
+    );
+    cloudShape_.setTextureRect(cloudTextureRect);
+
+    target.setView(view);
+    target.clear(sf::Color(135, 206, 235));
+    if (frame.parallaxLayers >= 1) {
+        countedDraw(target, backgroundShape_);
+    }
+    if (frame.parallaxLayers >= 2) {
+        countedDraw(target, cloudShape_);
+    }
+}
+
+/**
+ * @brief Draws the cached static scenery, then every other game object except the player.
+ */
+void SceneRenderer::drawWorld(sf::RenderTarget& target, const sf::View& view, const GameObjectList& gameObjects, int playerIndex) {
+    staticLayer_.draw(target, view, gameObjects);
+    frozenQuads_.clear();
+    batchQuads(gameObjects, frozenQuads_);
+    countedDraw(target, frozenQuads_.data(), frozenQuads_.size(), sf::PrimitiveType::Triangles);
+    for (size_t i = 0; i < gameObjects.size(); ++i) {
+        if (static_cast<int>(i) != playerIndex && !staticLayer_.isCached(gameObjects[i]) && !gameObjects[i].drawnAsQuad()) {
+            gameObjects[i].draw(target);
+        }
+    }
+}
+
+/**
+ * @brief Appends the quads of every object drawn as a batched quad, from their current body transforms.
+ */
+void SceneRenderer::batchQuads(const GameObjectList& gameObjects, std::vector<sf::Vertex>& vertices) {
+    quadBatch_.clear();
+    for (const GameObject& obj : gameObjects) {
+        if (obj.drawnAsQuad()) {
+            quadBatch_.add(obj.bodyId, obj.width_m_ / 2.0f, obj.height_m_ / 2.0f, obj.sfShape.getFillColor());
+        }
+    }
+    quadBatch_.writeQuads(vertices);
+}
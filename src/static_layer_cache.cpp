@@ -0,0 +1,229 @@
+#include "static_layer_cache.hpp"
+#include "render_stats.hpp"
+#include "logger.hpp"
+#include <algorithm> // For std::max
+#include <cmath>     // For std::floor
+
+namespace {
+
+/**
+ * @brief Converts a world pixel coordinate to the index of the tile containing it.
+ */
+inline int tileIndex(float worldPx) {
+    return static_cast<int>(std::floor(worldPx / static_cast<float>(STATIC_TILE_SIZE_PX)));
+}
+
+/**
+ * @brief Converts a tile index back to the world pixel coordinate of its top-left edge.
+ */
+inline float tileOrigin(int index) {
+    return static_cast<float>(index) * static_cast<float>(STATIC_TILE_SIZE_PX);
+}
+
+} // namespace
+
+void StaticLayerCache::sync(GameObjectList& gameObjects) {
+    if (gameObjects.size() < indexedCount_) {
+        // The vector shrank behind our back: fall back to a full re-index.
+        resync(gameObjects);
+        return;
+    }
+
+    for (std::size_t i = indexedCount_; i < gameObjects.size(); ++i) {
+        if (isCacheable(gameObjects[i])) {
+            add(gameObjects[i]);
+        }
+    }
+    indexedCount_ = gameObjects.size();
+}
+
+void StaticLayerCache::resync(GameObjectList& gameObjects) {
+    std::unordered_set<uint64_t> live;
+    live.reserve(gameObjects.size());
+    for (GameObject& obj : gameObjects) {
+        if (!isCacheable(obj)) continue;
+        uint64_t bodyKey = b2StoreBodyId(obj.bodyId);
+        live.insert(bodyKey);
+        if (cachedBodies_.count(bodyKey) == 0) {
+            add(obj);
+        }
+    }
+
+    for (auto it = cachedBodies_.begin(); it != cachedBodies_.end();) {
+        if (live.count(it->first) == 0) {
+            remove(it->first, it->second);
+            it = cachedBodies_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    indexedCount_ = gameObjects.size();
+}
+
+bool StaticLayerCache::isCached(const GameObject& obj) const {
+    if (!obj.isValid()) return false;
+    return cachedBodies_.count(b2StoreBodyId(obj.bodyId)) != 0;
+}
+
+void StaticLayerCache::invalidate(const GameObject& obj) {
+    if (!isCached(obj)) return;
+    invalidate(visualBounds(obj));
+}
+
+void StaticLayerCache::invalidate(const sf::FloatRect& worldRectPx) {
+    int minX = tileIndex(worldRectPx.position.x);
+    int maxX = tileIndex(worldRectPx.position.x + worldRectPx.size.x);
+    int minY = tileIndex(worldRectPx.position.y);
+    int maxY = tileIndex(worldRectPx.position.y + worldRectPx.size.y);
+    for (int ty = minY; ty <= maxY; ++ty) {
+        for (int tx = minX; tx <= maxX; ++tx) {
+            auto it = tiles_.find({tx, ty});
+            if (it != tiles_.end()) {
+                it->second.dirty = true;
+            }
+        }
+    }
+}
+
+void StaticLayerCache::draw(sf::RenderTarget& target, const sf::View& view, const GameObjectList& gameObjects) {
+    std::vector<sf::Sprite> tileSprites;
+    collectVisibleTiles(view, gameObjects, tileSprites);
+    for (const sf::Sprite& tileSprite : tileSprites) {
+        countedDraw(target, tileSprite);
+    }
+}
+
+void StaticLayerCache::collectVisibleTiles(const sf::View& view, const GameObjectList& gameObjects, std::vector<sf::Sprite>& sprites) {
+    sf::Vector2f topLeft = view.getCenter() - view.getSize() / 2.0f;
+    int minX = tileIndex(topLeft.x);
+    int maxX = tileIndex(topLeft.x + view.getSize().x);
+    int minY = tileIndex(topLeft.y);
+    int maxY = tileIndex(topLeft.y + view.getSize().y);
+
+    for (int ty = minY; ty <= maxY; ++ty) {
+        for (int tx = minX; tx <= maxX; ++tx) {
+            auto it = tiles_.find({tx, ty});
+            if (it == tiles_.end()) continue; // Nothing static in this part of the map
+
+            Tile& tile = it->second;
+            if (tile.dirty) {
+                renderTile(it->first, tile, gameObjects);
+            }
+            if (!tile.texture) continue; // Allocation failed, already reported
+
+            sf::Sprite tileSprite(tile.texture->getTexture());
+            tileSprite.setPosition(sf::Vector2f(tileOrigin(tx), tileOrigin(ty)));
+            sprites.push_back(tileSprite);
+        }
+    }
+}
+
+void StaticLayerCache::clear() {
+    tiles_.clear();
+    cachedBodies_.clear();
+    indexedCount_ = 0;
+}
+
+/**
+ * @brief True for objects whose visual never changes once finalized.
+ */
+bool StaticLayerCache::isCacheable(const GameObject& obj) {
+    return obj.isValid() && !obj.isDynamic_val_ && !obj.isPlayer && obj.hasVisual;
+}
+
+/**
+ * @brief Indexes one static object and marks the tiles it overlaps as dirty.
+ */
+void StaticLayerCache::add(GameObject& obj) {
+    // Static bodies never move, so one update places the shape and sprite for good.
+    obj.updateShape();
+    uint64_t bodyKey = b2StoreBodyId(obj.bodyId);
+    TileRange& range = cachedBodies_[bodyKey];
+
+    if (!hasVisibleContent(obj)) {
+        return; // Invisible anchors are cached (never drawn) but need no tile
+    }
+
+    sf::FloatRect bounds = visualBounds(obj);
+    range.minX = tileIndex(bounds.position.x);
+    range.maxX = tileIndex(bounds.position.x + bounds.size.x);
+    range.minY = tileIndex(bounds.position.y);
+    range.maxY = tileIndex(bounds.position.y + bounds.size.y);
+    for (int ty = range.minY; ty <= range.maxY; ++ty) {
+        for (int tx = range.minX; tx <= range.maxX; ++tx) {
+            Tile& tile = tiles_[{tx, ty}];
+            tile.bodies.insert(bodyKey);
+            tile.dirty = true;
+        }
+    }
+}
+
+/**
+ * @brief Removes a body from its tiles, releasing tiles left empty.
+ */
+void StaticLayerCache::remove(uint64_t bodyKey, const TileRange& range) {
+    for (int ty = range.minY; ty <= range.maxY; ++ty) {
+        for (int tx = range.minX; tx <= range.maxX; ++tx) {
+            auto it = tiles_.find({tx, ty});
+            if (it == tiles_.end()) continue;
+            it->second.bodies.erase(bodyKey);
+            if (it->second.bodies.empty()) {
+                tiles_.erase(it);
+            } else {
+                it->second.dirty = true;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Computes the area covered by a GameObject's shape and sprite, in world pixels.
+ */
+sf::FloatRect StaticLayerCache::visualBounds(const GameObject& obj) {
+    sf::FloatRect bounds = obj.sfShape.getGlobalBounds();
+    if (obj.sprite.has_value()) {
+        sf::FloatRect spriteBounds = obj.sprite->getGlobalBounds();
+        float left = std::min(bounds.position.x, spriteBounds.position.x);
+        float top = std::min(bounds.position.y, spriteBounds.position.y);
+        float right = std::max(bounds.position.x + bounds.size.x, spriteBounds.position.x + spriteBounds.size.x);
+        float bottom = std::max(bounds.position.y + bounds.size.y, spriteBounds.position.y + spriteBounds.size.y);
+        bounds = sf::FloatRect({left, top}, {right - left, bottom - top});
+    }
+    return bounds;
+}
+
+/**
+ * @brief True if drawing the object would put any pixel on screen.
+ */
+bool StaticLayerCache::hasVisibleContent(const GameObject& obj) {
+    return obj.sprite.has_value() || obj.sfShape.getFillColor().a > 0;
+}
+
+/**
+ * @brief Rasterizes every static object overlapping a tile into its render texture.
+ */
+void StaticLayerCache::renderTile(const TileKey& key, Tile& tile, const GameObjectList& gameObjects) {
+    const sf::Vector2u tileSize(STATIC_TILE_SIZE_PX, STATIC_TILE_SIZE_PX);
+    if (!tile.texture) {
+        tile.texture = std::make_unique<sf::RenderTexture>();
+        if (!tile.texture->resize(tileSize)) {
+            LOG_ERROR(LogCategory::Render) << "Failed to allocate static layer tile (" << key.first << ", " << key.second << ").";
+            tile.texture.reset();
+            tile.dirty = false; // Do not retry every frame
+            return;
+        }
+    }
+
+    sf::Vector2f origin(tileOrigin(key.first), tileOrigin(key.second));
+    tile.texture->setView(sf::View(sf::FloatRect(origin, sf::Vector2f(tileSize))));
+    tile.texture->clear(sf::Color::Transparent);
+
+    // Walk the scene in order so overlapping static objects keep their draw order.
+    for (const GameObject& obj : gameObjects) {
+        if (obj.isValid() && tile.bodies.count(b2StoreBodyId(obj.bodyId)) != 0) {
+            obj.draw(*tile.texture);
+        }
+    }
+    tile.texture->display();
+    tile.dirty = false;
+}
@@ -0,0 +1,110 @@
+#include "task_system.hpp"
+#include "trace.hpp"
+#include <algorithm> // For std::max, std::min
+#include <string>
+
+TaskSystem::TaskSystem(int workerCount) : workerCount_(std::max(1, workerCount)) {
+    for (int i = 1; i < workerCount_; ++i) {
+        threads_.emplace_back(&TaskSystem::workerLoop, this, static_cast<uint32_t>(i));
+    }
+}
+
+TaskSystem::~TaskSystem() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    jobAvailable_.notify_all();
+    for (std::thread& thread : threads_) {
+        thread.join();
+    }
+}
+
+void TaskSystem::configure(b2WorldDef& worldDef) {
+    if (workerCount_ <= 1) return;
+    worldDef.workerCount = workerCount_;
+    worldDef.enqueueTask = &TaskSystem::enqueueTask;
+    worldDef.finishTask = &TaskSystem::finishTask;
+    worldDef.userTaskContext = this;
+}
+
+/**
+ * @brief Splits the item range into at most one job per worker (each at least minRange items).
+ */
+void* TaskSystem::enqueueTask(b2TaskCallback* callback, int itemCount, int minRange, void* taskContext, void* userContext) {
+    TaskSystem& system = *static_cast<TaskSystem*>(userContext);
+    if (itemCount <= 0) return nullptr; // Nothing to run: Box2D treats nullptr as already finished
+    int rangeSize = std::max(1, minRange);
+    int jobCount = std::max(1, std::min(system.workerCount_, (itemCount + rangeSize - 1) / rangeSize));
+    int itemsPerJob = (itemCount + jobCount - 1) / jobCount;
+    jobCount = (itemCount + itemsPerJob - 1) / itemsPerJob; // Rounding may leave fewer jobs
+
+    Task* task;
+    {
+        std::lock_guard<std::mutex> lock(system.mutex_);
+        if (system.freeTasks_.empty()) {
+            system.freeTasks_.push_back(std::make_unique<Task>());
+        }
+        task = system.freeTasks_.back().release();
+        system.freeTasks_.pop_back();
+        task->callback = callback;
+        task->context = taskContext;
+        task->pendingJobs.store(jobCount, std::memory_order_relaxed);
+        for (int start = 0; start < itemCount; start += itemsPerJob) {
+            system.jobs_.push_back({task, start, std::min(itemCount, start + itemsPerJob)});
+        }
+    }
+    system.jobAvailable_.notify_all();
+    return task;
+}
+
+/**
+ * @brief Runs queued jobs on the calling thread (worker 0) until the task is complete.
+ */
+void TaskSystem::finishTask(void* userTask, void* userContext) {
+    TaskSystem& system = *static_cast<TaskSystem*>(userContext);
+    Task* task = static_cast<Task*>(userTask);
+    while (task->pendingJobs.load(std::memory_order_acquire) > 0) {
+        if (!system.runOneJob(0)) {
+            std::this_thread::yield(); // Remaining jobs are running on other workers
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(system.mutex_);
+    system.freeTasks_.emplace_back(task);
+}
+
+void TaskSystem::workerLoop(uint32_t workerIndex) {
+    TRACE_THREAD_NAME("Box2D worker " + std::to_string(workerIndex));
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            jobAvailable_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+            if (stopping_ && jobs_.empty()) return;
+            job = jobs_.front();
+            jobs_.pop_front();
+        }
+        runJob(job, workerIndex);
+    }
+}
+
+bool TaskSystem::runOneJob(uint32_t workerIndex) {
+    Job job;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (jobs_.empty()) return false;
+        job = jobs_.front();
+        jobs_.pop_front();
+    }
+    runJob(job, workerIndex);
+    return true;
+}
+
+void TaskSystem::runJob(const Job& job, uint32_t workerIndex) {
+    {
+        TRACE_ZONE("Box2D task");
+        job.task->callback(job.startIndex, job.endIndex, workerIndex, job.task->context);
+    }
+    job.task->pendingJobs.fetch_sub(1, std::memory_order_acq_rel);
+}
@@ -0,0 +1,24 @@
+#include "texture_cache.hpp"
+#include "logger.hpp"
+
+TextureCache& TextureCache::instance() {
+    static TextureCache cache;
+    return cache;
+}
+
+const sf::Texture* TextureCache::get(const std::string& path) {
+    if (!loadingEnabled_) return nullptr;
+    auto it = textures_.find(path);
+    if (it != textures_.end()) {
+        return it->second.get();
+    }
+
+    auto texture = std::make_unique<sf::Texture>();
+    if (!texture->loadFromFile(path)) {
+        LOG_ERROR(LogCategory::Assets) << "Failed to load texture from path: " << path;
+        texture.reset();
+    }
+    const sf::Texture* result = texture.get();
+    textures_.emplace(path, std::move(texture));
+    return result;
+}
@@ -0,0 +1,114 @@
+#include "time_dilation.hpp"
+#include "physics_lod.hpp"
+#include <algorithm>
+
+int TimeDilationZones::add(const b2AABB& area, float timeScale) {
+    int id = nextZoneId_++;
+    zones_.push_back(Zone{id, area, std::max(0.0f, timeScale)});
+    return id;
+}
+
+void TimeDilationZones::remove(int zoneId) {
+    zones_.erase(std::remove_if(zones_.begin(), zones_.end(), [zoneId](const Zone& zone) { return zone.id == zoneId; }),
+                 zones_.end());
+}
+
+void TimeDilationZones::setTimeScale(int zoneId, float timeScale) {
+    for (Zone& zone : zones_) {
+        if (zone.id == zoneId) {
+            zone.timeScale = std::max(0.0f, timeScale);
+        }
+    }
+}
+
+void TimeDilationZones::clear() {
+    zones_.clear();
+    tracked_.clear();
+}
+
+bool TimeDilationZones::collectBody(b2ShapeId shapeId, void* context) {
+    QueryContext* query = static_cast<QueryContext*>(context);
+    b2BodyId bodyId = b2Shape_GetBody(shapeId);
+    if (B2_ID_EQUALS(bodyId, query->excludedBodyId) || b2Body_GetType(bodyId) != b2_dynamicBody) {
+        return true; // Keep searching
+    }
+
+    TimeDilationZones& zones = *query->zones;
+    auto inserted = zones.tracked_.emplace(b2StoreBodyId(bodyId), TrackedBody());
+    TrackedBody& body = inserted.first->second;
+    if (inserted.second) {
+        // Entering from normal time: set up by update(), outside of the query
+        body.bodyId = bodyId;
+        body.entering = true;
+    }
+    float zoneScale = zones.zones_[query->zoneIndex].timeScale;
+    if (body.seenStamp != zones.stamp_) {
+        body.seenStamp = zones.stamp_;
+        body.lastZone = query->zoneIndex;
+        body.targetScale = zoneScale;
+    } else if (body.lastZone != query->zoneIndex) {
+        body.lastZone = query->zoneIndex;
+        body.targetScale *= zoneScale; // Overlapping zones
+    }
+    return true;
+}
+
+void TimeDilationZones::update(b2WorldId worldId, b2BodyId excludedBodyId, PhysicsLod* lod) {
+    ++stamp_;
+    QueryContext query {this, excludedBodyId, 0};
+    for (std::size_t i = 0; i < zones_.size(); ++i) {
+        query.zoneIndex = static_cast<int>(i);
+        b2World_OverlapAABB(worldId, zones_[i].area, b2DefaultQueryFilter(), &TimeDilationZones::collectBody, &query);
+    }
+
+    for (auto it = tracked_.begin(); it != tracked_.end();) {
+        TrackedBody& body = it->second;
+        if (!b2Body_IsValid(body.bodyId)) {
+            if (lod) lod->include(body.bodyId);
+            it = tracked_.erase(it); // Destroyed inside a zone
+            continue;
+        }
+        if (body.entering) {
+            // The LOD restores the state it saved first, so the zone scales the body's real motion
+            if (lod) lod->exclude(body.bodyId);
+            body.originalGravityScale = b2Body_GetGravityScale(body.bodyId);
+            body.entering = false;
+        }
+        bool inside = body.seenStamp == stamp_;
+        float target = inside ? body.targetScale : 1.0f;
+        if (target != body.timeScale) {
+            retime(body, target);
+        }
+        if (inside) {
+            ++it;
+        } else {
+            if (lod) lod->include(body.bodyId);
+            it = tracked_.erase(it);
+        }
+    }
+}
+
+/**
+ * @brief Moves a body from its current time scale to another one.
+ */
+void TimeDilationZones::retime(TrackedBody& body, float timeScale) {
+    // Velocities in the body's own time, before any scaling
+    b2Vec2 linearVelocity = body.savedLinearVelocity;
+    float angularVelocity = body.savedAngularVelocity;
+    if (body.timeScale > 0.0f) {
+        linearVelocity = b2MulSV(1.0f / body.timeScale, b2Body_GetLinearVelocity(body.bodyId));
+        angularVelocity = b2Body_GetAngularVelocity(body.bodyId) / body.timeScale;
+    }
+
+    if (timeScale > 0.0f) {
+        b2Body_SetLinearVelocity(body.bodyId, b2MulSV(timeScale, linearVelocity));
+        b2Body_SetAngularVelocity(body.bodyId, timeScale * angularVelocity);
+    } else {
+        body.savedLinearVelocity = linearVelocity;
+        body.savedAngularVelocity = angularVelocity;
+        b2Body_SetLinearVelocity(body.bodyId, b2Vec2_zero);
+        b2Body_SetAngularVelocity(body.bodyId, 0.0f);
+    }
+    b2Body_SetGravityScale(body.bodyId, body.originalGravityScale * timeScale * timeScale);
+    body.timeScale = timeScale;
+}
@@ -0,0 +1,244 @@
+#include "time_rewind.hpp"
+#include "memory_tracker.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+const float POSITION_UNITS_PER_METER = 4096.0f;
+const float ANGLE_UNITS_PER_RADIAN = 65536.0f / (2.0f * B2_PI);
+
+inline int32_t quantize(float value, float scale) {
+    float scaled = value * scale;
+    return static_cast<int32_t>(scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f);
+}
+
+const std::size_t MAX_VARINT_BYTES = 5;
+const std::size_t MAX_RECORD_BYTES = 4 * MAX_VARINT_BYTES; // Header and three values
+
+inline void writeVarint(uint8_t*& out, uint32_t value) {
+    while (value >= 0x80) {
+        *out++ = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = static_cast<uint8_t>(value);
+}
+
+// Zigzag: small magnitudes of either sign give small codes
+inline uint32_t zigzag(int32_t value) {
+    return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+inline int32_t unzigzag(uint32_t value) {
+    return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+}
+
+inline void writeSigned(uint8_t*& out, int32_t value) {
+    writeVarint(out, zigzag(value));
+}
+
+inline uint32_t readVarint(const uint8_t*& in) {
+    uint32_t value = 0;
+    int shift = 0;
+    while (*in & 0x80) {
+        value |= static_cast<uint32_t>(*in++ & 0x7F) << shift;
+        shift += 7;
+    }
+    value |= static_cast<uint32_t>(*in++) << shift;
+    return value;
+}
+
+inline int32_t readSigned(const uint8_t*& in) {
+    return unzigzag(readVarint(in));
+}
+
+} // namespace
+
+TimeRewind::TimeRewind(const TimeRewindConfig& config)
+    : config_(config),
+      maxSteps_(std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(config.historySeconds / UPDATE_DELTA)))) {
+}
+
+TimeRewind::~TimeRewind() {
+    if (buffer_) {
+        MemoryTracker::instance().recordFree(MemorySubsystem::TimeRewind, bufferSize_);
+    }
+}
+
+void TimeRewind::clear() {
+    slots_.clear();
+    slotRefs_.clear();
+    usedBytes_ = 0;
+    firstStep_ = 0;
+    stepCount_ = 0;
+}
+
+uint32_t TimeRewind::slotFor(b2BodyId bodyId) {
+    std::size_t index = static_cast<std::size_t>(bodyId.index1);
+    if (index >= slotRefs_.size()) {
+        slotRefs_.resize(index + 1);
+    }
+    SlotRef& ref = slotRefs_[index];
+    if (ref.slot == 0 || ref.generation != bodyId.generation) {
+        // First record of this body (a new body may reuse the index of a destroyed one)
+        slots_.push_back(Slot{bodyId, State(), false});
+        ref.generation = bodyId.generation;
+        ref.slot = static_cast<uint32_t>(slots_.size());
+    }
+    return ref.slot - 1;
+}
+
+void TimeRewind::record(b2WorldId worldId) {
+    b2BodyEvents events = b2World_GetBodyEvents(worldId);
+    uint32_t recordCount = 0;
+    uint32_t previousSlot = 0;
+    // Room for the worst case; records start after the count, written once known
+    scratch_.resize(sizeof(uint32_t) + static_cast<std::size_t>(events.moveCount) * MAX_RECORD_BYTES);
+    uint8_t* out = scratch_.data() + sizeof(uint32_t);
+
+    for (int i = 0; i < events.moveCount; ++i) {
+        const b2BodyMoveEvent& event = events.moveEvents[i];
+        uint32_t slotIndex = slotFor(event.bodyId);
+        Slot& slot = slots_[slotIndex];
+        State& state = slot.state;
+
+        int32_t x = quantize(event.transform.p.x, POSITION_UNITS_PER_METER);
+        int32_t y = quantize(event.transform.p.y, POSITION_UNITS_PER_METER);
+        uint16_t angle = static_cast<uint16_t>(quantize(b2Rot_GetAngle(event.transform.q), ANGLE_UNITS_PER_RADIAN));
+
+        int32_t rx, ry, rAngle;
+        bool born = !slot.born;
+        if (born) {
+            // Absolute state; the displacement starts at zero
+            rx = x;
+            ry = y;
+            rAngle = static_cast<int16_t>(angle);
+            state.dx = 0;
+            state.dy = 0;
+            state.dAngle = 0;
+            slot.born = true;
+        } else {
+            int32_t dx = x - state.x;
+            int32_t dy = y - state.y;
+            int16_t dAngle = static_cast<int16_t>(static_cast<uint16_t>(angle - state.angle));
+            if (dx == 0 && dy == 0 && dAngle == 0 && state.dx == 0 && state.dy == 0 && state.dAngle == 0) {
+                continue; // Awake but still: nothing to undo
+            }
+            rx = dx - state.dx;
+            ry = dy - state.dy;
+            rAngle = static_cast<int16_t>(static_cast<uint16_t>(dAngle - state.dAngle));
+            state.dx = dx;
+            state.dy = dy;
+            state.dAngle = dAngle;
+        }
+        state.x = x;
+        state.y = y;
+        state.angle = angle;
+
+        // Header: slot relative to the previous record, and the born flag in the low bit
+        int32_t slotDelta = static_cast<int32_t>(slotIndex - previousSlot);
+        previousSlot = slotIndex;
+        writeVarint(out, zigzag(slotDelta) << 1 | (born ? 1u : 0u));
+        writeSigned(out, rx);
+        writeSigned(out, ry);
+        writeSigned(out, rAngle);
+        ++recordCount;
+    }
+
+    std::memcpy(scratch_.data(), &recordCount, sizeof(recordCount));
+    scratch_.resize(static_cast<std::size_t>(out - scratch_.data()));
+    pushStep();
+}
+
+void TimeRewind::pushStep() {
+    if (!buffer_) {
+        bufferSize_ = config_.budgetBytes;
+        buffer_.reset(new uint8_t[bufferSize_]); // Not value-initialized: pages are only touched when used
+        MemoryTracker::instance().recordAllocation(MemorySubsystem::TimeRewind, bufferSize_);
+        steps_.resize(maxSteps_);
+    }
+
+    std::size_t size = scratch_.size();
+    if (size > bufferSize_) {
+        // A single step larger than the whole budget: the history cannot go past it
+        while (stepCount_ > 0) dropOldestStep();
+        return;
+    }
+    while (stepCount_ > 0 && (stepCount_ == maxSteps_ || usedBytes_ + size > bufferSize_)) {
+        dropOldestStep();
+    }
+
+    std::size_t start = 0;
+    if (stepCount_ > 0) {
+        const StepInfo& newest = steps_[(firstStep_ + stepCount_ - 1) % maxSteps_];
+        start = (newest.start + newest.size) % bufferSize_;
+    }
+    std::size_t firstPart = std::min(size, bufferSize_ - start);
+    std::memcpy(buffer_.get() + start, scratch_.data(), firstPart);
+    std::memcpy(buffer_.get(), scratch_.data() + firstPart, size - firstPart);
+
+    steps_[(firstStep_ + stepCount_) % maxSteps_] = StepInfo{start, size};
+    ++stepCount_;
+    usedBytes_ += size;
+}
+
+void TimeRewind::dropOldestStep() {
+    usedBytes_ -= steps_[firstStep_].size;
+    firstStep_ = (firstStep_ + 1) % maxSteps_;
+    --stepCount_;
+}
+
+bool TimeRewind::stepBack() {
+    if (stepCount_ == 0) return false;
+
+    const StepInfo step = steps_[(firstStep_ + stepCount_ - 1) % maxSteps_];
+    scratch_.resize(step.size);
+    std::size_t firstPart = std::min(step.size, bufferSize_ - step.start);
+    std::memcpy(scratch_.data(), buffer_.get() + step.start, firstPart);
+    std::memcpy(scratch_.data() + firstPart, buffer_.get(), step.size - firstPart);
+    --stepCount_;
+    usedBytes_ -= step.size;
+
+    uint32_t recordCount;
+    std::memcpy(&recordCount, scratch_.data(), sizeof(recordCount));
+    const uint8_t* in = scratch_.data() + sizeof(recordCount);
+    uint32_t slotIndex = 0;
+    for (uint32_t i = 0; i < recordCount; ++i) {
+        uint32_t header = readVarint(in);
+        bool born = (header & 1) != 0;
+        slotIndex += static_cast<uint32_t>(unzigzag(header >> 1));
+        int32_t rx = readSigned(in);
+        int32_t ry = readSigned(in);
+        int32_t rAngle = readSigned(in);
+
+        Slot& slot = slots_[slotIndex];
+        State& state = slot.state;
+        if (born) {
+            // Before this step the body did not exist: leave it where it was created
+            slot.born = false;
+            state = State();
+            continue;
+        }
+        state.x -= state.dx;
+        state.y -= state.dy;
+        state.angle = static_cast<uint16_t>(state.angle - static_cast<uint16_t>(state.dAngle));
+        state.dx -= rx;
+        state.dy -= ry;
+        state.dAngle = static_cast<int16_t>(static_cast<uint16_t>(state.dAngle - static_cast<int16_t>(rAngle)));
+        applyState(slot);
+    }
+    return true;
+}
+
+void TimeRewind::applyState(const Slot& slot) const {
+    if (!b2Body_IsValid(slot.bodyId)) return; // Destroyed since (e.g. streamed out)
+    const State& state = slot.state;
+    b2Vec2 position = {state.x / POSITION_UNITS_PER_METER, state.y / POSITION_UNITS_PER_METER};
+    float angle = static_cast<int16_t>(state.angle) / ANGLE_UNITS_PER_RADIAN;
+    b2Body_SetTransform(slot.bodyId, position, b2MakeRot(angle));
+    b2Body_SetLinearVelocity(slot.bodyId, {state.dx / (POSITION_UNITS_PER_METER * UPDATE_DELTA),
+                                           state.dy / (POSITION_UNITS_PER_METER * UPDATE_DELTA)});
+    b2Body_SetAngularVelocity(slot.bodyId, state.dAngle / (ANGLE_UNITS_PER_RADIAN * UPDATE_DELTA));
+    b2Body_SetAwake(slot.bodyId, true);
+}
@@ -0,0 +1,181 @@
+#include "timer_wheel.hpp"
+#include <algorithm>
+#include <utility>
+
+/**
+ * @brief Starts loading the next timer of a slot while the current one is handled:
+ * with many timers, walking a slot is a chain of cache misses.
+ */
+static inline void prefetch(const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#else
+    (void)address;
+#endif
+}
+
+TimerWheel::TimerWheel() {
+    std::fill(std::begin(heads_), std::end(heads_), NO_TIMER);
+}
+
+TimerId TimerWheel::schedule(uint32_t delaySteps, Callback callback) {
+    return add(delaySteps, 0, std::move(callback));
+}
+
+TimerId TimerWheel::scheduleRepeating(uint32_t periodSteps, Callback callback) {
+    periodSteps = std::max(periodSteps, 1u);
+    return add(periodSteps, periodSteps, std::move(callback));
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    if (!isPending(id)) return false;
+    uint32_t index = id.index - 1;
+    Timer& timer = timers_[index];
+    timer.state = TimerState::Cancelled; // Unlinked when its slot is walked
+    ++timer.generation;
+    timers_[index].callback = nullptr;
+    --pendingCount_;
+    return true;
+}
+
+bool TimerWheel::isPending(TimerId id) const {
+    if (id.isNull() || id.index > timers_.size()) return false;
+    const Timer& timer = timers_[id.index - 1];
+    return timer.generation == id.generation && timer.state == TimerState::Pending;
+}
+
+void TimerWheel::advance(uint32_t steps) {
+    for (uint32_t step = 0; step < steps; ++step) {
+        tick();
+    }
+}
+
+void TimerWheel::clear() {
+    std::fill(std::begin(heads_), std::end(heads_), NO_TIMER);
+    free_.clear();
+    for (uint32_t index = 0; index < timers_.size(); ++index) {
+        Timer& timer = timers_[index];
+        if (timer.state == TimerState::Pending) {
+            ++timer.generation; // Outstanding TimerIds must not match a later timer
+        }
+        timer.state = TimerState::Free;
+        timers_[index].callback = nullptr;
+        free_.push_back(index);
+    }
+    pendingCount_ = 0;
+    now_ = 0;
+}
+
+TimerId TimerWheel::add(uint32_t delaySteps, uint32_t period, Callback callback) {
+    uint32_t index;
+    if (!free_.empty()) {
+        index = free_.back();
+        free_.pop_back();
+    } else {
+        index = static_cast<uint32_t>(timers_.size());
+        timers_.emplace_back();
+    }
+    Timer& timer = timers_[index];
+    timer.expiry = now_ + std::max(delaySteps, 1u);
+    timer.period = period;
+    timer.state = TimerState::Pending;
+    timers_[index].callback = std::move(callback);
+    insert(index);
+    ++pendingCount_;
+    return TimerId{index + 1, timer.generation};
+}
+
+/**
+ * @brief Pushes a timer onto the slot of its expiry, in the finest level whose span covers it.
+ */
+void TimerWheel::insert(uint32_t index) {
+    Timer& timer = timers_[index];
+    uint64_t delta = timer.expiry > now_ ? timer.expiry - now_ : 0;
+    uint32_t head = NO_TIMER;
+    for (int level = 0; level < TIMER_WHEEL_LEVELS; ++level) {
+        int shift = level * TIMER_WHEEL_SLOT_BITS;
+        if (delta < (uint64_t(TIMER_WHEEL_SLOTS) << shift)) {
+            uint32_t slot = static_cast<uint32_t>(timer.expiry >> shift) & (TIMER_WHEEL_SLOTS - 1);
+            head = level * TIMER_WHEEL_SLOTS + slot;
+            break;
+        }
+    }
+    if (head == NO_TIMER) {
+        // Beyond the wheel: park in the top level slot cascaded last, re-placed from there
+        int shift = (TIMER_WHEEL_LEVELS - 1) * TIMER_WHEEL_SLOT_BITS;
+        uint32_t slot = static_cast<uint32_t>((now_ >> shift) - 1) & (TIMER_WHEEL_SLOTS - 1);
+        head = (TIMER_WHEEL_LEVELS - 1) * TIMER_WHEEL_SLOTS + slot;
+    }
+    timer.next = heads_[head];
+    heads_[head] = index;
+}
+
+/**
+ * @brief Returns a cancelled timer to the pool once it left its slot.
+ */
+void TimerWheel::recycle(uint32_t index) {
+    timers_[index].state = TimerState::Free;
+    free_.push_back(index);
+}
+
+/**
+ * @brief Detaches a slot's list: timers re-placed while it is walked land in fresh lists.
+ */
+uint32_t TimerWheel::takeSlot(int level, uint32_t slot) {
+    uint32_t& head = heads_[level * TIMER_WHEEL_SLOTS + slot];
+    uint32_t first = head;
+    head = NO_TIMER;
+    return first;
+}
+
+void TimerWheel::tick() {
+    ++now_;
+    for (int level = TIMER_WHEEL_LEVELS - 1; level > 0; --level) {
+        int shift = level * TIMER_WHEEL_SLOT_BITS;
+        if ((now_ & ((uint64_t(1) << shift) - 1)) != 0) continue;
+        uint32_t index = takeSlot(level, static_cast<uint32_t>(now_ >> shift) & (TIMER_WHEEL_SLOTS - 1));
+        while (index != NO_TIMER) {
+            uint32_t next = timers_[index].next;
+            if (next != NO_TIMER) prefetch(&timers_[next]);
+            if (timers_[index].state == TimerState::Cancelled) {
+                recycle(index);
+            } else {
+                insert(index);
+            }
+            index = next;
+        }
+    }
+
+    uint32_t index = takeSlot(0, static_cast<uint32_t>(now_) & (TIMER_WHEEL_SLOTS - 1));
+    while (index != NO_TIMER) {
+        Timer& timer = timers_[index];
+        uint32_t next = timer.next;
+        if (next != NO_TIMER) prefetch(&timers_[next]);
+        if (timer.state == TimerState::Cancelled) { // Possibly by a callback of this step
+            recycle(index);
+            index = next;
+            continue;
+        }
+
+        uint32_t generation = timer.generation;
+        uint32_t period = timer.period;
+        Callback callback = std::move(timers_[index].callback);
+        if (period > 0) {
+            timer.expiry = now_ + period;
+            insert(index); // Before the call, so the callback can cancel it
+        } else {
+            timer.state = TimerState::Free;
+            ++timer.generation;
+            free_.push_back(index);
+            --pendingCount_;
+        }
+
+        callback(); // May grow the pool: no reference into it is kept across the call
+
+        // Give the callback back unless the timer was cancelled (or recycled) meanwhile
+        if (period > 0 && timers_[index].generation == generation && timers_[index].state == TimerState::Pending) {
+            timers_[index].callback = std::move(callback);
+        }
+        index = next;
+    }
+}
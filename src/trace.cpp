@@ -0,0 +1,110 @@
+#include "trace.hpp"
+#include "constants.hpp"
+#include "logger.hpp"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>  // For std::setprecision
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct TraceEvent {
+    const char* name;
+    int64_t startNs;
+    int64_t endNs;
+};
+
+/**
+ * @brief Ring buffer of one thread. Owned by the registry so it survives the thread.
+ */
+struct ThreadTrace {
+    std::vector<TraceEvent> events;
+    std::atomic<uint64_t> written {0}; // Total events ever recorded; the slot is written % size
+    int threadId {0};
+    std::string name;
+};
+
+std::mutex registryMutex;
+std::vector<std::shared_ptr<ThreadTrace>> registry;
+
+ThreadTrace& threadTrace() {
+    thread_local std::shared_ptr<ThreadTrace> local;
+    if (!local) {
+        local = std::make_shared<ThreadTrace>();
+        local->events.resize(TRACE_BUFFER_EVENTS);
+        std::lock_guard<std::mutex> lock(registryMutex);
+        local->threadId = static_cast<int>(registry.size()) + 1;
+        local->name = "Thread " + std::to_string(local->threadId);
+        registry.push_back(local);
+    }
+    return *local;
+}
+
+const std::chrono::steady_clock::time_point traceOrigin = std::chrono::steady_clock::now();
+
+void writeJsonString(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') out << '\\';
+        out << c;
+    }
+    out << '"';
+}
+
+} // namespace
+
+int64_t Trace::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - traceOrigin).count();
+}
+
+void Trace::record(const char* name, int64_t startNs, int64_t endNs) {
+    ThreadTrace& trace = threadTrace();
+    uint64_t index = trace.written.load(std::memory_order_relaxed);
+    trace.events[index % trace.events.size()] = {name, startNs, endNs};
+    trace.written.store(index + 1, std::memory_order_release);
+}
+
+void Trace::setThreadName(const std::string& name) {
+    ThreadTrace& trace = threadTrace();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    trace.name = name;
+}
+
+bool Trace::exportChromeJson(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        LOG_ERROR(LogCategory::General) << "Failed to open trace file: " << path;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    for (const auto& trace : registry) {
+        if (!first) out << ",\n";
+        first = false;
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << trace->threadId << ",\"args\":{\"name\":";
+        writeJsonString(out, trace->name);
+        out << "}}";
+
+        uint64_t written = trace->written.load(std::memory_order_acquire);
+        uint64_t capacity = trace->events.size();
+        uint64_t begin = written > capacity ? written - capacity : 0;
+        for (uint64_t i = begin; i < written; ++i) {
+            const TraceEvent& event = trace->events[i % capacity];
+            // Complete ("X") events, timestamps in microseconds
+            out << ",\n{\"name\":";
+            writeJsonString(out, event.name);
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << trace->threadId
+                << ",\"ts\":" << static_cast<double>(event.startNs) / 1000.0
+                << ",\"dur\":" << static_cast<double>(event.endNs - event.startNs) / 1000.0 << "}";
+        }
+    }
+    out << "\n]}\n";
+    LOG_INFO(LogCategory::General) << "Trace written to " << path;
+    return static_cast<bool>(out);
+}
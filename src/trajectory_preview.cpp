@@ -0,0 +1,485 @@
+#include "trajectory_preview.hpp"
+#include "player.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+const sf::Color BODY_PATH_COLOR(255, 255, 255);
+const sf::Color JUMP_ARC_COLOR(255, 220, 80);
+
+// Paths fade out towards the end of the prediction
+inline sf::Vertex pathVertex(b2Vec2 position, sf::Color color, float progress) {
+    color.a = static_cast<std::uint8_t>(220.0f - 180.0f * std::min(progress, 1.0f));
+    return sf::Vertex{b2VecToSfVec(position), color};
+}
+
+} // namespace
+
+TrajectoryPreview::TrajectoryPreview() {
+    // Created here rather than on the worker: b2CreateWorld must not race with the game's own world creation
+    b2WorldDef worldDef = b2DefaultWorldDef();
+    resumeWorld_ = b2CreateWorld(&worldDef);
+    frozenWorld_ = b2CreateWorld(&worldDef);
+    thread_ = std::thread(&TrajectoryPreview::run, this);
+}
+
+TrajectoryPreview::~TrajectoryPreview() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    // Abandon the prediction in progress
+    ++bodiesGeneration_;
+    ++arcGeneration_;
+    wake_.notify_one();
+    thread_.join();
+    b2DestroyWorld(resumeWorld_);
+    b2DestroyWorld(frozenWorld_);
+}
+
+void TrajectoryPreview::capture(b2WorldId worldId, const GameObjectList& gameObjects, b2BodyId playerBodyId,
+                                const WorldFreezer& freezer) {
+    TRACE_ZONE("Capture trajectory scene");
+    frozenByKey_.clear();
+    for (const WorldFreezer::FrozenBody& frozen : freezer.frozenBodies()) {
+        frozenByKey_[b2StoreBodyId(frozen.bodyId)] = &frozen;
+    }
+
+    captured_.gravity = b2World_GetGravity(worldId);
+    captured_.bodies.clear();
+    captured_.shapes.clear();
+    captured_.joints.clear();
+    captured_.player = -1;
+    bodyIndex_.clear();
+
+    for (const auto& obj : gameObjects) {
+        if (B2_IS_NULL(obj.bodyId) || !b2Body_IsValid(obj.bodyId)) continue;
+        uint64_t key = b2StoreBodyId(obj.bodyId);
+        if (bodyIndex_.count(key)) continue;
+
+        BodyDesc body;
+        body.key = key;
+        body.transform = b2Body_GetTransform(obj.bodyId);
+        auto frozen = frozenByKey_.find(key);
+        if (frozen != frozenByKey_.end()) {
+            body.type = frozen->second->originalType;
+            body.linearVelocity = frozen->second->linearVelocity;
+            body.angularVelocity = frozen->second->angularVelocity;
+        } else {
+            body.type = b2Body_GetType(obj.bodyId);
+            body.linearVelocity = b2Body_GetLinearVelocity(obj.bodyId);
+            body.angularVelocity = b2Body_GetAngularVelocity(obj.bodyId);
+        }
+        body.linearDamping = b2Body_GetLinearDamping(obj.bodyId);
+        body.angularDamping = b2Body_GetAngularDamping(obj.bodyId);
+        body.gravityScale = b2Body_GetGravityScale(obj.bodyId);
+        body.fixedRotation = b2Body_IsFixedRotation(obj.bodyId);
+        body.isBullet = b2Body_IsBullet(obj.bodyId);
+        body.firstShape = static_cast<int>(captured_.shapes.size());
+
+        shapeIds_.resize(static_cast<std::size_t>(b2Body_GetShapeCount(obj.bodyId)));
+        int shapeCount = b2Body_GetShapes(obj.bodyId, shapeIds_.data(), static_cast<int>(shapeIds_.size()));
+        for (int i = 0; i < shapeCount; ++i) {
+            b2ShapeId shapeId = shapeIds_[i];
+            if (b2Shape_IsSensor(shapeId)) continue; // Sensors do not change the motion
+            ShapeDesc shape;
+            shape.type = b2Shape_GetType(shapeId);
+            switch (shape.type) {
+                case b2_polygonShape: shape.polygon = b2Shape_GetPolygon(shapeId); break;
+                case b2_circleShape: shape.circle = b2Shape_GetCircle(shapeId); break;
+                case b2_capsuleShape: shape.capsule = b2Shape_GetCapsule(shapeId); break;
+                case b2_segmentShape: shape.segment = b2Shape_GetSegment(shapeId); break;
+                default: continue; // Chains are not used by the game
+            }
+            shape.density = b2Shape_GetDensity(shapeId);
+            shape.friction = b2Shape_GetFriction(shapeId);
+            shape.restitution = b2Shape_GetRestitution(shapeId);
+            shape.filter = b2Shape_GetFilter(shapeId);
+            captured_.shapes.push_back(shape);
+        }
+        body.shapeCount = static_cast<int>(captured_.shapes.size()) - body.firstShape;
+
+        int index = static_cast<int>(captured_.bodies.size());
+        bodyIndex_[key] = index;
+        if (B2_ID_EQUALS(obj.bodyId, playerBodyId)) {
+            captured_.player = index;
+        }
+        captured_.bodies.push_back(body);
+    }
+
+    // Joints, once each (from their first body); only revolute joints are used by the game
+    for (const auto& obj : gameObjects) {
+        if (B2_IS_NULL(obj.bodyId) || !b2Body_IsValid(obj.bodyId)) continue;
+        jointIds_.resize(static_cast<std::size_t>(b2Body_GetJointCount(obj.bodyId)));
+        int jointCount = b2Body_GetJoints(obj.bodyId, jointIds_.data(), static_cast<int>(jointIds_.size()));
+        for (int i = 0; i < jointCount; ++i) {
+            b2JointId jointId = jointIds_[i];
+            if (b2Joint_GetType(jointId) != b2_revoluteJoint) continue;
+            b2BodyId bodyIdA = b2Joint_GetBodyA(jointId);
+            b2BodyId bodyIdB = b2Joint_GetBodyB(jointId);
+            if (!B2_ID_EQUALS(bodyIdA, obj.bodyId)) continue;
+            auto indexA = bodyIndex_.find(b2StoreBodyId(bodyIdA));
+            auto indexB = bodyIndex_.find(b2StoreBodyId(bodyIdB));
+            if (indexA == bodyIndex_.end() || indexB == bodyIndex_.end()) continue;
+
+            JointDesc joint;
+            joint.bodyA = indexA->second;
+            joint.bodyB = indexB->second;
+            joint.def = b2DefaultRevoluteJointDef();
+            joint.def.localAnchorA = b2Joint_GetLocalAnchorA(jointId);
+            joint.def.localAnchorB = b2Joint_GetLocalAnchorB(jointId);
+            // The reference angle is not exposed: recover it from the current angle
+            float relativeAngle = b2RelativeAngle(b2Body_GetRotation(bodyIdB), b2Body_GetRotation(bodyIdA));
+            joint.def.referenceAngle = b2UnwindAngle(relativeAngle - b2RevoluteJoint_GetAngle(jointId));
+            joint.def.enableSpring = b2RevoluteJoint_IsSpringEnabled(jointId);
+            joint.def.hertz = b2RevoluteJoint_GetSpringHertz(jointId);
+            joint.def.dampingRatio = b2RevoluteJoint_GetSpringDampingRatio(jointId);
+            joint.def.enableLimit = b2RevoluteJoint_IsLimitEnabled(jointId);
+            joint.def.lowerAngle = b2RevoluteJoint_GetLowerLimit(jointId);
+            joint.def.upperAngle = b2RevoluteJoint_GetUpperLimit(jointId);
+            joint.def.enableMotor = b2RevoluteJoint_IsMotorEnabled(jointId);
+            joint.def.maxMotorTorque = b2RevoluteJoint_GetMaxMotorTorque(jointId);
+            joint.def.motorSpeed = b2RevoluteJoint_GetMotorSpeed(jointId);
+            joint.def.collideConnected = b2Joint_GetCollideConnected(jointId);
+            captured_.joints.push_back(joint);
+        }
+    }
+
+    PlayerState player {};
+    if (captured_.player != -1) {
+        player.transform = b2Body_GetTransform(playerBodyId);
+        player.linearVelocity = b2Body_GetLinearVelocity(playerBodyId);
+    }
+    lastPosted_ = player;
+    lastPlanPosition_ = player.transform.p;
+    hasScene_ = true;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::swap(pending_, captured_); // captured_ gets the previous buffers back
+        sceneRequested_ = true;
+        sceneValid_ = true;
+        ++sceneSerial_;
+        postedPlayer_ = player;
+        ++bodiesGeneration_;
+        ++arcGeneration_;
+    }
+    wake_.notify_one();
+}
+
+void TrajectoryPreview::update(b2BodyId playerBodyId) {
+    if (!hasScene_ || B2_IS_NULL(playerBodyId)) return;
+
+    PlayerState player;
+    player.transform = b2Body_GetTransform(playerBodyId);
+    player.linearVelocity = b2Body_GetLinearVelocity(playerBodyId);
+    if (player.transform.p.x == lastPosted_.transform.p.x && player.transform.p.y == lastPosted_.transform.p.y &&
+        player.linearVelocity.x == lastPosted_.linearVelocity.x &&
+        player.linearVelocity.y == lastPosted_.linearVelocity.y) {
+        return; // Standing still: the current predictions are still right
+    }
+    lastPosted_ = player;
+
+    // The bodies only see the player as an obstacle: small moves do not change their paths
+    bool replan = b2Distance(player.transform.p, lastPlanPosition_) > TRAJECTORY_REPLAN_DISTANCE_M;
+    if (replan) {
+        lastPlanPosition_ = player.transform.p;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        postedPlayer_ = player;
+        arcRequested_ = true;
+        ++arcGeneration_;
+        if (replan) {
+            bodiesRequested_ = true;
+            ++bodiesGeneration_;
+        }
+    }
+    wake_.notify_one();
+}
+
+void TrajectoryPreview::cancel() {
+    if (!hasScene_) return;
+    hasScene_ = false;
+    front_.clear();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sceneRequested_ = false;
+        bodiesRequested_ = false;
+        arcRequested_ = false;
+        sceneValid_ = false;
+        ++sceneSerial_;
+        ++bodiesGeneration_;
+        ++arcGeneration_;
+        ready_.clear();
+        frontVersion_ = readyVersion_;
+    }
+}
+
+const std::vector<sf::Vertex>& TrajectoryPreview::paths() {
+    std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+    if (lock.owns_lock() && readyVersion_ != frontVersion_) {
+        front_.swap(ready_);
+        frontVersion_ = readyVersion_;
+    }
+    return front_;
+}
+
+void TrajectoryPreview::run() {
+    TRACE_THREAD_NAME("Trajectory preview");
+    while (true) {
+        bool rebuild, predictMoves, predictJump;
+        PlayerState player;
+        uint32_t serial, bodiesGeneration, arcGeneration;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stopping_ || sceneRequested_ || bodiesRequested_ || arcRequested_; });
+            if (stopping_) break;
+            rebuild = sceneRequested_;
+            if (rebuild) {
+                std::swap(scene_, pending_);
+            }
+            predictMoves = bodiesRequested_ || rebuild;
+            predictJump = arcRequested_ || rebuild;
+            sceneRequested_ = false;
+            bodiesRequested_ = false;
+            arcRequested_ = false;
+            player = postedPlayer_;
+            serial = sceneSerial_;
+            bodiesGeneration = bodiesGeneration_.load();
+            arcGeneration = arcGeneration_.load();
+        }
+
+        if (rebuild) {
+            TRACE_ZONE("Build prediction worlds");
+            if (sameStructure()) {
+                resetWorlds();
+            } else {
+                buildWorlds();
+            }
+            // Paths of the previous scene must not be published with the new ones
+            bodyLines_.clear();
+            arcLines_.clear();
+        }
+        bool changed = false;
+        if (predictMoves && predictBodies(player, bodiesGeneration)) {
+            changed = true;
+        }
+        if (predictJump && predictArc(player, arcGeneration)) {
+            changed = true;
+        }
+        if (changed) {
+            publish(serial);
+        }
+    }
+}
+
+/**
+ * @brief True if the scratch worlds already hold the bodies of the scene (only their state differs).
+ */
+bool TrajectoryPreview::sameStructure() const {
+    if (built_.size() != scene_.bodies.size() || builtJoints_ != scene_.joints.size()) return false;
+    for (std::size_t i = 0; i < built_.size(); ++i) {
+        const BodyDesc& built = built_[i];
+        const BodyDesc& body = scene_.bodies[i];
+        if (built.key != body.key || built.type != body.type || built.shapeCount != body.shapeCount) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Recreates the bodies, shapes and joints of the scene in both scratch worlds.
+ * In the resume world the player is kinematic (it stands still while the world moves);
+ * in the frozen world everything but the player is static.
+ */
+void TrajectoryPreview::buildWorlds() {
+    for (b2BodyId bodyId : resumeBodies_) b2DestroyBody(bodyId);
+    for (b2BodyId bodyId : frozenBodies_) b2DestroyBody(bodyId);
+    resumeBodies_.clear();
+    frozenBodies_.clear();
+    b2World_SetGravity(resumeWorld_, scene_.gravity);
+    b2World_SetGravity(frozenWorld_, scene_.gravity);
+
+    for (std::size_t i = 0; i < scene_.bodies.size(); ++i) {
+        const BodyDesc& desc = scene_.bodies[i];
+        bool isPlayer = static_cast<int>(i) == scene_.player;
+
+        b2BodyDef bodyDef = b2DefaultBodyDef();
+        bodyDef.position = desc.transform.p;
+        bodyDef.rotation = desc.transform.q;
+        bodyDef.linearDamping = desc.linearDamping;
+        bodyDef.angularDamping = desc.angularDamping;
+        bodyDef.gravityScale = desc.gravityScale;
+        bodyDef.fixedRotation = desc.fixedRotation;
+        bodyDef.isBullet = desc.isBullet;
+
+        bodyDef.type = isPlayer ? b2_kinematicBody : desc.type;
+        b2BodyId resumeBody = b2CreateBody(resumeWorld_, &bodyDef);
+        bodyDef.type = isPlayer ? b2_dynamicBody : b2_staticBody;
+        b2BodyId frozenBody = b2CreateBody(frozenWorld_, &bodyDef);
+
+        for (int s = desc.firstShape; s < desc.firstShape + desc.shapeCount; ++s) {
+            const ShapeDesc& shape = scene_.shapes[s];
+            b2ShapeDef shapeDef = b2DefaultShapeDef();
+            shapeDef.density = shape.density;
+            shapeDef.material.friction = shape.friction;
+            shapeDef.material.restitution = shape.restitution;
+            shapeDef.filter = shape.filter;
+            for (b2BodyId bodyId : {resumeBody, frozenBody}) {
+                switch (shape.type) {
+                    case b2_polygonShape: b2CreatePolygonShape(bodyId, &shapeDef, &shape.polygon); break;
+                    case b2_circleShape: b2CreateCircleShape(bodyId, &shapeDef, &shape.circle); break;
+                    case b2_capsuleShape: b2CreateCapsuleShape(bodyId, &shapeDef, &shape.capsule); break;
+                    case b2_segmentShape: b2CreateSegmentShape(bodyId, &shapeDef, &shape.segment); break;
+                    default: break;
+                }
+            }
+        }
+        resumeBodies_.push_back(resumeBody);
+        frozenBodies_.push_back(frozenBody);
+    }
+
+    // Joints only matter where bodies move together
+    for (const JointDesc& joint : scene_.joints) {
+        b2RevoluteJointDef jointDef = joint.def;
+        jointDef.bodyIdA = resumeBodies_[joint.bodyA];
+        jointDef.bodyIdB = resumeBodies_[joint.bodyB];
+        b2CreateRevoluteJoint(resumeWorld_, &jointDef);
+    }
+
+    built_ = scene_.bodies;
+    builtJoints_ = scene_.joints.size();
+}
+
+/**
+ * @brief Moves the bodies of both scratch worlds to the captured transforms.
+ */
+void TrajectoryPreview::resetWorlds() {
+    b2World_SetGravity(resumeWorld_, scene_.gravity);
+    b2World_SetGravity(frozenWorld_, scene_.gravity);
+    for (std::size_t i = 0; i < scene_.bodies.size(); ++i) {
+        const BodyDesc& desc = scene_.bodies[i];
+        b2Body_SetTransform(resumeBodies_[i], desc.transform.p, desc.transform.q);
+        b2Body_SetTransform(frozenBodies_[i], desc.transform.p, desc.transform.q);
+        b2Body_SetGravityScale(resumeBodies_[i], desc.gravityScale);
+    }
+    built_ = scene_.bodies;
+}
+
+/**
+ * @brief Simulates the resume world from the captured state and turns the paths of the
+ * moving bodies near the player into lines.
+ * @return False if a newer request made the prediction stale.
+ */
+bool TrajectoryPreview::predictBodies(const PlayerState& player, uint32_t generation) {
+    TRACE_ZONE("Predict body paths");
+    const int playerIndex = scene_.player;
+    tracked_.clear();
+    for (std::size_t i = 0; i < scene_.bodies.size(); ++i) {
+        const BodyDesc& desc = scene_.bodies[i];
+        if (static_cast<int>(i) == playerIndex || desc.type == b2_staticBody) continue;
+        b2BodyId bodyId = resumeBodies_[i];
+        // Undo the previous prediction
+        b2Body_SetTransform(bodyId, desc.transform.p, desc.transform.q);
+        b2Body_SetLinearVelocity(bodyId, desc.linearVelocity);
+        b2Body_SetAngularVelocity(bodyId, desc.angularVelocity);
+        b2Body_SetAwake(bodyId, true);
+        if (desc.type == b2_dynamicBody &&
+            (playerIndex == -1 || b2Distance(desc.transform.p, player.transform.p) < TRAJECTORY_PREVIEW_RADIUS_M)) {
+            tracked_.push_back(static_cast<int>(i));
+        }
+    }
+    if (playerIndex != -1) {
+        b2Body_SetTransform(resumeBodies_[playerIndex], player.transform.p, player.transform.q);
+    }
+
+    const std::size_t trackedCount = tracked_.size();
+    const int sampleCount = TRAJECTORY_PREVIEW_STEPS / TRAJECTORY_SAMPLE_STEPS + 1;
+    samples_.resize(trackedCount * static_cast<std::size_t>(sampleCount));
+    for (std::size_t t = 0; t < trackedCount; ++t) {
+        samples_[t] = scene_.bodies[tracked_[t]].transform.p;
+    }
+    for (int step = 1; step <= TRAJECTORY_PREVIEW_STEPS; ++step) {
+        b2World_Step(resumeWorld_, UPDATE_DELTA, TRAJECTORY_SUB_STEPS);
+        if (bodiesGeneration_.load(std::memory_order_relaxed) != generation) return false;
+        if (step % TRAJECTORY_SAMPLE_STEPS == 0) {
+            b2Vec2* row = samples_.data() + static_cast<std::size_t>(step / TRAJECTORY_SAMPLE_STEPS) * trackedCount;
+            for (std::size_t t = 0; t < trackedCount; ++t) {
+                row[t] = b2Body_GetPosition(resumeBodies_[tracked_[t]]);
+            }
+        }
+    }
+
+    // One polyline per body that actually moves
+    work_.clear();
+    for (std::size_t t = 0; t < trackedCount; ++t) {
+        b2Vec2 start = samples_[t];
+        float travel = 0.0f;
+        for (int s = 1; s < sampleCount; ++s) {
+            travel = std::max(travel, b2Distance(start, samples_[static_cast<std::size_t>(s) * trackedCount + t]));
+        }
+        if (travel < TRAJECTORY_MIN_TRAVEL_M) continue;
+        for (int s = 1; s < sampleCount; ++s) {
+            float progress = static_cast<float>(s) / static_cast<float>(sampleCount - 1);
+            work_.push_back(pathVertex(samples_[static_cast<std::size_t>(s - 1) * trackedCount + t], BODY_PATH_COLOR, progress));
+            work_.push_back(pathVertex(samples_[static_cast<std::size_t>(s) * trackedCount + t], BODY_PATH_COLOR, progress));
+        }
+    }
+    bodyLines_.swap(work_);
+    return true;
+}
+
+/**
+ * @brief Simulates a jump of the player through the frozen world and turns it into lines.
+ * The player's gravity follows movePlayer with the jump key held: normal while rising,
+ * stronger while falling. The arc stops where the player lands.
+ * @return False if a newer request made the prediction stale.
+ */
+bool TrajectoryPreview::predictArc(const PlayerState& player, uint32_t generation) {
+    TRACE_ZONE("Predict jump arc");
+    work_.clear();
+    if (scene_.player != -1) {
+        b2BodyId bodyId = frozenBodies_[scene_.player];
+        b2Body_SetTransform(bodyId, player.transform.p, player.transform.q);
+        b2Body_SetLinearVelocity(bodyId, {player.linearVelocity.x, playerJumpVelocity()});
+        b2Body_SetAngularVelocity(bodyId, 0.0f);
+        b2Body_SetAwake(bodyId, true);
+
+        b2Vec2 previous = player.transform.p;
+        bool falling = false;
+        for (int step = 1; step <= TRAJECTORY_ARC_STEPS; ++step) {
+            b2Body_SetGravityScale(bodyId, playerAirGravityScale(b2Body_GetLinearVelocity(bodyId).y));
+            b2World_Step(frozenWorld_, UPDATE_DELTA, TRAJECTORY_SUB_STEPS);
+            if (arcGeneration_.load(std::memory_order_relaxed) != generation) return false;
+
+            float verticalVelocity = b2Body_GetLinearVelocity(bodyId).y;
+            bool landed = falling && verticalVelocity > -0.01f;
+            falling = verticalVelocity < -0.01f;
+            if (step % TRAJECTORY_SAMPLE_STEPS != 0 && !landed) continue;
+
+            b2Vec2 position = b2Body_GetPosition(bodyId);
+            float progress = static_cast<float>(step) / static_cast<float>(TRAJECTORY_ARC_STEPS);
+            work_.push_back(pathVertex(previous, JUMP_ARC_COLOR, progress));
+            work_.push_back(pathVertex(position, JUMP_ARC_COLOR, progress));
+            if (landed) break;
+            previous = position;
+        }
+    }
+    arcLines_.swap(work_);
+    return true;
+}
+
+/**
+ * @brief Hands the current paths to the main thread, unless the scene they belong to was dropped.
+ */
+void TrajectoryPreview::publish(uint32_t sceneSerial) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!sceneValid_ || sceneSerial != sceneSerial_) return;
+    ready_.clear();
+    ready_.insert(ready_.end(), bodyLines_.begin(), bodyLines_.end());
+    ready_.insert(ready_.end(), arcLines_.begin(), arcLines_.end());
+    ++readyVersion_;
+}
@@ -0,0 +1,130 @@
+#include "transform_batch.hpp"
+#include "constants.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TRANSFORM_BATCH_SSE2 1
+#endif
+
+namespace {
+
+/**
+ * @brief Writes one quad from its four corners (screen order: top-left, top-right,
+ * bottom-right, bottom-left when unrotated) as triangles 0-1-2 and 0-2-3.
+ */
+inline void writeQuad(sf::Vertex* out, const float* x, const float* y, sf::Color color) {
+    static const int order[TRANSFORM_BATCH_VERTICES_PER_QUAD] = {0, 1, 2, 0, 2, 3};
+    for (std::size_t v = 0; v < TRANSFORM_BATCH_VERTICES_PER_QUAD; ++v) {
+        out[v].position = sf::Vector2f(x[order[v]], y[order[v]]);
+        out[v].color = color;
+        out[v].texCoords = sf::Vector2f(0.0f, 0.0f);
+    }
+}
+
+} // namespace
+
+void transformQuads(const float* positionX, const float* positionY, const float* cosine, const float* sine,
+                    const float* halfWidth, const float* halfHeight, const sf::Color* color,
+                    std::size_t count, sf::Vertex* out) {
+    // A local corner (lx, ly) of a body at p rotated by (c, s) is, in window pixels:
+    //   X = (px + c*lx - s*ly) * PPM
+    //   Y = WINDOW_HEIGHT - (py + s*lx + c*ly) * PPM
+    // With a = c*hw, b = s*hw, d = c*hh, e = s*hh (scaled), the corners are P +/- a +/- e, Q +/- b +/- d.
+    const float scale = PIXELS_PER_METER;
+    const float height = static_cast<float>(WINDOW_HEIGHT);
+    std::size_t i = 0;
+
+#ifdef TRANSFORM_BATCH_SSE2
+    const __m128 scale4 = _mm_set1_ps(scale);
+    const __m128 height4 = _mm_set1_ps(height);
+    alignas(16) float x[4][4];
+    alignas(16) float y[4][4];
+    for (; i + 4 <= count; i += 4) {
+        __m128 c = _mm_loadu_ps(cosine + i);
+        __m128 s = _mm_loadu_ps(sine + i);
+        __m128 hw = _mm_mul_ps(_mm_loadu_ps(halfWidth + i), scale4);
+        __m128 hh = _mm_mul_ps(_mm_loadu_ps(halfHeight + i), scale4);
+        __m128 P = _mm_mul_ps(_mm_loadu_ps(positionX + i), scale4);
+        __m128 Q = _mm_sub_ps(height4, _mm_mul_ps(_mm_loadu_ps(positionY + i), scale4));
+        __m128 a = _mm_mul_ps(c, hw);
+        __m128 b = _mm_mul_ps(s, hw);
+        __m128 d = _mm_mul_ps(c, hh);
+        __m128 e = _mm_mul_ps(s, hh);
+
+        __m128 aPlusE = _mm_add_ps(a, e);
+        __m128 aMinusE = _mm_sub_ps(a, e);
+        __m128 bPlusD = _mm_add_ps(b, d);
+        __m128 bMinusD = _mm_sub_ps(b, d);
+        _mm_store_ps(x[0], _mm_sub_ps(P, aPlusE));
+        _mm_store_ps(y[0], _mm_add_ps(Q, bMinusD));
+        _mm_store_ps(x[1], _mm_add_ps(P, aMinusE));
+        _mm_store_ps(y[1], _mm_sub_ps(Q, bPlusD));
+        _mm_store_ps(x[2], _mm_add_ps(P, aPlusE));
+        _mm_store_ps(y[2], _mm_sub_ps(Q, bMinusD));
+        _mm_store_ps(x[3], _mm_sub_ps(P, aMinusE));
+        _mm_store_ps(y[3], _mm_add_ps(Q, bPlusD));
+
+        // Interleave into vertices: lane k holds object i + k
+        for (int k = 0; k < 4; ++k) {
+            const float quadX[4] = {x[0][k], x[1][k], x[2][k], x[3][k]};
+            const float quadY[4] = {y[0][k], y[1][k], y[2][k], y[3][k]};
+            writeQuad(out + (i + k) * TRANSFORM_BATCH_VERTICES_PER_QUAD, quadX, quadY, color[i + k]);
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        float hw = halfWidth[i] * scale;
+        float hh = halfHeight[i] * scale;
+        float P = positionX[i] * scale;
+        float Q = height - positionY[i] * scale;
+        float a = cosine[i] * hw;
+        float b = sine[i] * hw;
+        float d = cosine[i] * hh;
+        float e = sine[i] * hh;
+        const float quadX[4] = {P - a - e, P + a - e, P + a + e, P - a + e};
+        const float quadY[4] = {Q + b - d, Q - b - d, Q - b + d, Q + b + d};
+        writeQuad(out + i * TRANSFORM_BATCH_VERTICES_PER_QUAD, quadX, quadY, color[i]);
+    }
+}
+
+void TransformBatch::clear() {
+    positionX_.clear();
+    positionY_.clear();
+    cosine_.clear();
+    sine_.clear();
+    halfWidth_.clear();
+    halfHeight_.clear();
+    color_.clear();
+}
+
+void TransformBatch::reserve(std::size_t count) {
+    positionX_.reserve(count);
+    positionY_.reserve(count);
+    cosine_.reserve(count);
+    sine_.reserve(count);
+    halfWidth_.reserve(count);
+    halfHeight_.reserve(count);
+    color_.reserve(count);
+}
+
+void TransformBatch::add(b2BodyId bodyId, float halfWidth_m, float halfHeight_m, sf::Color color) {
+    add(b2Body_GetTransform(bodyId), halfWidth_m, halfHeight_m, color);
+}
+
+void TransformBatch::add(const b2Transform& transform, float halfWidth_m, float halfHeight_m, sf::Color color) {
+    positionX_.push_back(transform.p.x);
+    positionY_.push_back(transform.p.y);
+    cosine_.push_back(transform.q.c);
+    sine_.push_back(transform.q.s);
+    halfWidth_.push_back(halfWidth_m);
+    halfHeight_.push_back(halfHeight_m);
+    color_.push_back(color);
+}
+
+void TransformBatch::writeQuads(std::vector<sf::Vertex>& vertices) const {
+    std::size_t first = vertices.size();
+    vertices.resize(first + size() * TRANSFORM_BATCH_VERTICES_PER_QUAD);
+    transformQuads(positionX_.data(), positionY_.data(), cosine_.data(), sine_.data(),
+                   halfWidth_.data(), halfHeight_.data(), color_.data(), size(), vertices.data() + first);
+}
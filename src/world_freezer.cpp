@@ -0,0 +1,45 @@
+#include "world_freezer.hpp"
+
+void WorldFreezer::freeze(GameObjectList& gameObjects, b2BodyId playerBodyId) {
+    frozenBodies_.clear();
+    for (auto& obj : gameObjects) {
+        if (!B2_IS_NULL(obj.bodyId) && !B2_ID_EQUALS(obj.bodyId, playerBodyId)) {
+            freezeBody(obj.bodyId);
+        }
+    }
+}
+
+void WorldFreezer::freezeNew(GameObjectList& gameObjects, b2BodyId playerBodyId) {
+    for (auto& obj : gameObjects) {
+        if (B2_IS_NULL(obj.bodyId) || B2_ID_EQUALS(obj.bodyId, playerBodyId)) continue;
+        if (b2Body_GetType(obj.bodyId) == b2_staticBody) continue; // Already frozen, or static anyway
+        freezeBody(obj.bodyId);
+    }
+}
+
+void WorldFreezer::restore() {
+    for (const FrozenBody& frozen : frozenBodies_) {
+        if (!B2_IS_NULL(frozen.bodyId) && b2Body_IsValid(frozen.bodyId)) { // May have been streamed out
+            b2Body_SetType(frozen.bodyId, frozen.originalType);
+            b2Body_SetLinearVelocity(frozen.bodyId, frozen.linearVelocity);
+            b2Body_SetAngularVelocity(frozen.bodyId, frozen.angularVelocity);
+        }
+    }
+    frozenBodies_.clear();
+}
+
+/**
+ * @brief Saves the body's type and velocities, then makes it completely immovable.
+ */
+void WorldFreezer::freezeBody(b2BodyId bodyId) {
+    FrozenBody frozen;
+    frozen.bodyId = bodyId;
+    frozen.originalType = b2Body_GetType(bodyId);
+    frozen.linearVelocity = b2Body_GetLinearVelocity(bodyId);
+    frozen.angularVelocity = b2Body_GetAngularVelocity(bodyId);
+    frozenBodies_.push_back(frozen);
+
+    b2Body_SetType(bodyId, b2_staticBody);
+    b2Body_SetLinearVelocity(bodyId, {0.0f, 0.0f});
+    b2Body_SetAngularVelocity(bodyId, 0.0f);
+}